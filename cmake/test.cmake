@@ -61,3 +61,44 @@ function(build_tests)
     add_test( NAME ${ARGS_NAME} COMMAND ${ARGS_NAME} )
 endfunction(build_tests)
 
+
+set( SL_BENCHMARK_OUTPUT_DIR "benchmarks" )
+
+function(build_benchmarks)
+    set( prefix ARGS )
+    set( options )
+    set( oneValueArgs NAME )
+    set( multiValueArgs SOURCES LIBRARIES )
+    cmake_parse_arguments( PARSE_ARGV 0 "${prefix}" "${options}" "${oneValueArgs}" "${multiValueArgs}" )
+
+    add_executable( ${ARGS_NAME}
+        ${CMAKE_SOURCE_DIR}/test/runner.cpp
+        ${ARGS_SOURCES}
+    )
+
+    target_compile_definitions( ${ARGS_NAME} PRIVATE
+        CATCH_CONFIG_CPP11_TO_STRING
+        CATCH_CONFIG_CPP17_UNCAUGHT_EXCEPTIONS
+        CATCH_CONFIG_CPP17_STRING_VIEW
+        CATCH_CONFIG_CPP17_BYTE
+        CATCH_CONFIG_FAST_COMPILE
+        CATCH_CONFIG_ENABLE_BENCHMARKING
+    )
+
+    target_include_directories( ${ARGS_NAME} PRIVATE
+        ${CMAKE_SOURCE_DIR}/test/inc
+    )
+
+    target_link_libraries( ${ARGS_NAME}
+        catch2
+        ${ARGS_LIBRARIES}
+    )
+
+    set_property(
+        TARGET ${ARGS_NAME}
+        PROPERTY RUNTIME_OUTPUT_DIRECTORY ${SL_BENCHMARK_OUTPUT_DIR}
+    )
+
+    # Benchmarks are long running and noisy, so they are intentionally not registered
+    # with CTest. Run the executable directly (optionally with a tag filter).
+endfunction(build_benchmarks)
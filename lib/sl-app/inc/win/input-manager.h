@@ -27,6 +27,7 @@
 
 #include <array>
 #include <functional>
+#include <memory_resource>
 #include <span>
 
 #include <ankerl/unordered_dense.h>
@@ -112,8 +113,12 @@ namespace sl::app
     struct input_manager
     {
     public:
-        explicit input_manager( Logger& logger )
+        explicit input_manager( Logger& logger,
+                                std::pmr::memory_resource* resource
+                                = std::pmr::get_default_resource() )
             : _logger { logger }
+            , _key_bindings { resource }
+            , _mouse_bindings { resource }
         {}
 
         void bind( int key, input_action action, input_modifier mods, key_binding_fn fn )
@@ -227,8 +232,8 @@ namespace sl::app
     private:
         Logger& _logger;
 
-        ankerl::unordered_dense::map< uint64_t, key_binding_fn > _key_bindings;
-        ankerl::unordered_dense::map< uint64_t, mouse_button_fn > _mouse_bindings;
+        ankerl::unordered_dense::pmr::map< uint64_t, key_binding_fn > _key_bindings;
+        ankerl::unordered_dense::pmr::map< uint64_t, mouse_button_fn > _mouse_bindings;
         mouse_move_fn _mouse_move { priv::noop {} };
         mouse_scroll_fn _scroll { priv::noop {} };
 
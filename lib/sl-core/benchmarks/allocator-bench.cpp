@@ -0,0 +1,193 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023-present Robert Anderson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+
+#include <mem/allocator.h>
+#include <mem/arena.h>
+#include <mem/slab.h>
+
+namespace
+{
+
+    constexpr size_t k_objects = 1000;
+
+    struct request_node
+    {
+        request_node( int id )
+            : id { id }
+        {}
+
+        int id;
+        std::array< char, 52 > payload {};
+    };
+
+    sl::mem::allocator malloc_allocator()
+    {
+        return sl::mem::allocator( {
+            []( size_t size ) { return std::malloc( size ); },
+            []( void* ptr, size_t size ) { return std::realloc( ptr, size ); },
+            []( void* ptr ) { std::free( ptr ); },
+        } );
+    }
+
+}   // namespace
+
+TEST_CASE( "Arena vs malloc allocator", "[.][benchmark][memory][arena]" )
+{
+    std::array< request_node*, k_objects > nodes;
+
+    auto heap = malloc_allocator();
+    BENCHMARK( "malloc: alloc_t / free_t" )
+    {
+        for ( size_t i = 0; i < k_objects; ++i )
+            nodes[i] = heap.alloc_t< request_node >( static_cast< int >( i ) );
+        for ( size_t i = 0; i < k_objects; ++i )
+            heap.free_t( nodes[i] );
+        return nodes[0];
+    };
+
+    sl::mem::arena arena;
+    auto bump = arena.allocator();
+    BENCHMARK( "arena: alloc_t + reset" )
+    {
+        for ( size_t i = 0; i < k_objects; ++i )
+            nodes[i] = bump.alloc_t< request_node >( static_cast< int >( i ) );
+        arena.reset();
+        return nodes[0];
+    };
+
+    BENCHMARK( "arena: raw allocate + reset" )
+    {
+        for ( size_t i = 0; i < k_objects; ++i )
+            nodes[i] = new ( arena.allocate( sizeof( request_node ), alignof( request_node ) ) )
+                request_node( static_cast< int >( i ) );
+        arena.reset();
+        return nodes[0];
+    };
+}
+
+TEST_CASE( "Slab vs malloc allocator", "[.][benchmark][memory][slab]" )
+{
+    std::array< request_node*, k_objects > nodes;
+
+    auto heap = malloc_allocator();
+    BENCHMARK( "malloc: churn alloc_t / free_t" )
+    {
+        for ( size_t i = 0; i < k_objects; ++i )
+            heap.free_t( heap.alloc_t< request_node >( static_cast< int >( i ) ) );
+        return nodes[0];
+    };
+
+    auto slab = sl::mem::slab::allocator();
+    BENCHMARK( "slab: churn alloc_t / free_t" )
+    {
+        for ( size_t i = 0; i < k_objects; ++i )
+            slab.free_t( slab.alloc_t< request_node >( static_cast< int >( i ) ) );
+        return nodes[0];
+    };
+
+    BENCHMARK( "object_pool: churn make / destroy" )
+    {
+        using pool = sl::mem::object_pool< request_node >;
+        for ( size_t i = 0; i < k_objects; ++i )
+            pool::destroy( pool::make( static_cast< int >( i ) ) );
+        return nodes[0];
+    };
+
+    BENCHMARK( "malloc: burst alloc_t then free_t" )
+    {
+        for ( size_t i = 0; i < k_objects; ++i )
+            nodes[i] = heap.alloc_t< request_node >( static_cast< int >( i ) );
+        for ( size_t i = 0; i < k_objects; ++i )
+            heap.free_t( nodes[i] );
+        return nodes[0];
+    };
+
+    BENCHMARK( "object_pool: burst make then destroy" )
+    {
+        using pool = sl::mem::object_pool< request_node >;
+        for ( size_t i = 0; i < k_objects; ++i )
+            nodes[i] = pool::make( static_cast< int >( i ) );
+        for ( size_t i = 0; i < k_objects; ++i )
+            pool::destroy( nodes[i] );
+        return nodes[0];
+    };
+}
+
+TEST_CASE( "Static vs type-erased allocator dispatch", "[.][benchmark][memory][allocator]" )
+{
+    auto erased = malloc_allocator();
+    auto direct = sl::mem::basic_allocator< sl::mem::malloc_policy > {};
+
+    using erased_sp = decltype( erased.alloc_sp< request_node >( 0 ) );
+    using direct_sp = decltype( direct.alloc_sp< request_node >( 0 ) );
+    using slab_sp   = decltype( sl::mem::slab::allocator().alloc_sp< request_node >( 0 ) );
+
+    std::printf( "sizeof( alloc_sp result ): function_policy = %zu, malloc_policy = %zu, "
+                 "slab::policy = %zu\n",
+                 sizeof( erased_sp ),
+                 sizeof( direct_sp ),
+                 sizeof( slab_sp ) );
+
+    BENCHMARK( "function_policy: alloc / free" )
+    {
+        for ( size_t i = 0; i < k_objects; ++i )
+        {
+            auto p = erased.alloc( sizeof( request_node ) );
+            Catch::Benchmark::keep_memory( p );
+            erased.free( p );
+        }
+        return k_objects;
+    };
+
+    BENCHMARK( "malloc_policy: alloc / free" )
+    {
+        for ( size_t i = 0; i < k_objects; ++i )
+        {
+            auto p = direct.alloc( sizeof( request_node ) );
+            Catch::Benchmark::keep_memory( p );
+            direct.free( p );
+        }
+        return k_objects;
+    };
+
+    BENCHMARK( "function_policy: alloc_sp" )
+    {
+        for ( size_t i = 0; i < k_objects; ++i )
+            erased.alloc_sp< request_node >( static_cast< int >( i ) );
+        return k_objects;
+    };
+
+    BENCHMARK( "malloc_policy: alloc_sp" )
+    {
+        for ( size_t i = 0; i < k_objects; ++i )
+            direct.alloc_sp< request_node >( static_cast< int >( i ) );
+        return k_objects;
+    };
+}
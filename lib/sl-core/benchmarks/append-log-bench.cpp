@@ -0,0 +1,87 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023-present Robert Anderson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <catch2/catch.hpp>
+#include <test/temp.h>
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <vector>
+
+#include <io/append-log.h>
+
+namespace
+{
+
+    const char* policy_name( sl::io::log_sync policy )
+    {
+        switch ( policy )
+        {
+            case sl::io::log_sync::none: return "none";
+            case sl::io::log_sync::group: return "group (1 MiB)";
+            default: return "always";
+        }
+    }
+
+}   // namespace
+
+TEST_CASE( "Append log throughput", "[.][benchmark][io][append-log]" )
+{
+    using clock = std::chrono::steady_clock;
+
+    sl::test::temp_file tmp( "sl-bench-append-log" );
+    const auto& dir = tmp.path;
+
+    using sl::io::log_sync;
+
+    for ( auto policy : { log_sync::none, log_sync::group, log_sync::always } )
+    {
+        for ( size_t size : { 64, 512, 4096 } )
+        {
+            std::filesystem::remove_all( dir );
+
+            // Syncing every record is orders of magnitude slower; keep its run short.
+            const size_t bytes   = policy == log_sync::always ? 4 << 20 : 256 << 20;
+            const size_t records = bytes / size;
+            std::vector< std::byte > payload( size, std::byte { 0x5A } );
+
+            auto start = clock::now();
+            {
+                sl::io::append_log log( dir, "bench", { .sync = policy } );
+                for ( size_t i = 0; i < records; ++i )
+                    log.append( payload );
+                log.sync();
+            }
+            auto secs = std::chrono::duration< double >( clock::now() - start ).count();
+
+            std::printf( "%-14s %5zu B records: %10.0f records/s %8.1f MiB/s\n",
+                         policy_name( policy ),
+                         size,
+                         static_cast< double >( records ) / secs,
+                         static_cast< double >( bytes ) / ( 1024.0 * 1024.0 ) / secs );
+        }
+    }
+}
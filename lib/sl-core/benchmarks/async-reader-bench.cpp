@@ -0,0 +1,178 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023-present Robert Anderson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <catch2/catch.hpp>
+#include <test/temp.h>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <io/async-reader.h>
+#include <io/load.h>
+#include <mem/pages.h>
+
+namespace
+{
+
+    using clock = std::chrono::steady_clock;
+
+    size_t env_or( const char* name, size_t fallback )
+    {
+        if ( auto env = std::getenv( name ) )
+            return std::max< size_t >( std::strtoul( env, nullptr, 10 ), 1 );
+        return fallback;
+    }
+
+    void drop_cache( const std::vector< std::filesystem::path >& files )
+    {
+        for ( const auto& f : files )
+        {
+            auto fd = ::open( f.c_str(), O_RDONLY );
+            if ( fd < 0 )
+                continue;
+#if defined( __linux__ )
+            ::posix_fadvise( fd, 0, 0, POSIX_FADV_DONTNEED );
+#endif
+            ::close( fd );
+        }
+    }
+
+    template< typename Fn >
+    void measure( const char* label,
+                  const std::vector< std::filesystem::path >& files,
+                  size_t bytes,
+                  bool cold,
+                  Fn&& fn )
+    {
+        constexpr int k_rounds = 5;
+
+        double best = 1e30;
+        size_t sum  = 0;
+        for ( int i = 0; i < k_rounds; ++i )
+        {
+            if ( cold )
+                drop_cache( files );
+
+            auto start = clock::now();
+            sum += fn();
+            best = std::min(
+                best, std::chrono::duration< double, std::milli >( clock::now() - start ).count() );
+        }
+
+        std::printf( "%-5s %-30s %9.2f ms %9.1f MiB/s (check %zu)\n",
+                     cold ? "cold" : "warm",
+                     label,
+                     best,
+                     static_cast< double >( bytes ) / ( 1024.0 * 1024.0 ) / ( best / 1000.0 ),
+                     sum );
+    }
+
+    size_t read_all( const std::vector< std::filesystem::path >& files,
+                     size_t file_size,
+                     const sl::mem::page_region& slab,
+                     sl::io::reader_options options,
+                     bool direct )
+    {
+        sl::io::async_reader reader( options );
+
+        auto base = static_cast< std::byte* >( slab.data() );
+
+        std::span< std::byte > regions[] = { { base, files.size() * file_size } };
+        if ( options.use_uring )
+            reader.register_buffers( regions );
+
+        std::vector< sl::io::file_handle > handles;
+        std::vector< sl::io::async_reader::request > requests;
+        handles.reserve( files.size() );
+        for ( size_t i = 0; i < files.size(); ++i )
+        {
+            handles.emplace_back( files[i].c_str(), direct );
+            requests.push_back(
+                { handles.back().fd(), 0, { base + i * file_size, handles.back().size() } } );
+        }
+
+        return reader.read_many( requests );
+    }
+
+}   // namespace
+
+TEST_CASE( "Async reader vs load_file", "[.][benchmark][io][async-reader]" )
+{
+    const auto count     = env_or( "SL_BENCH_FILES", 64 );
+    const auto file_size = env_or( "SL_BENCH_FILE_KB", 1024 ) * 1024;
+
+    sl::test::temp_dir dir( "sl-bench-async-reader" );
+    std::vector< std::filesystem::path > files;
+    std::string chunk( file_size, 'x' );
+    for ( size_t i = 0; i < count; ++i )
+    {
+        files.push_back( dir.path / ( "asset-" + std::to_string( i ) + ".bin" ) );
+        std::ofstream( files.back(), std::ios::binary ).write( chunk.data(), chunk.size() );
+    }
+
+    std::printf( "Reading %zu files of %zu KiB (io_uring %s)\n",
+                 count,
+                 file_size / 1024,
+                 sl::io::async_reader().uses_uring() ? "available" : "unavailable" );
+
+    // One page aligned (and pre-faulted) slab for all files, so O_DIRECT and buffer
+    // registration both apply and page faults on fresh memory stay out of the timings.
+    sl::mem::page_region slab( count * file_size, { .huge_pages = false } );
+    std::memset( slab.data(), 0, slab.size() );
+
+    for ( bool cold : { false, true } )
+    {
+        const auto bytes = count * file_size;
+
+        measure( "load_file", files, bytes, cold, [&] {
+            size_t n = 0;
+            for ( const auto& f : files )
+                n += sl::io::load_file< std::byte >( f ).size() == file_size;
+            return n;
+        } );
+
+        measure( "async_reader (pread)", files, bytes, cold, [&] {
+            return read_all( files, file_size, slab, { .use_uring = false }, false );
+        } );
+
+        measure( "async_reader (io_uring)", files, bytes, cold, [&] {
+            return read_all( files, file_size, slab, { .queue_depth = 64 }, false );
+        } );
+
+        measure( "async_reader (io_uring+direct)", files, bytes, cold, [&] {
+            return read_all( files, file_size, slab, { .queue_depth = 64 }, true );
+        } );
+    }
+}
@@ -0,0 +1,196 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023-present Robert Anderson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+
+#include <catch2/catch.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <config/json.h>
+#include <config/live.h>
+#include <config/snapshot.h>
+#include <config/yaml.h>
+
+namespace
+{
+
+    using clock = std::chrono::steady_clock;
+
+    template< typename Fn >
+    void run( const char* label, size_t count, Fn&& fn )
+    {
+        int64_t sum = 0;
+
+        auto start = clock::now();
+        for ( size_t i = 0; i < count; ++i )
+            sum += fn( i );
+        auto secs = std::chrono::duration< double >( clock::now() - start ).count();
+
+        std::printf( "%-24s %8.1f ns/lookup  (checksum %lld)\n",
+                     label,
+                     secs * 1e9 / static_cast< double >( count ),
+                     static_cast< long long >( sum ) );
+    }
+
+    std::string make_config( size_t services )
+    {
+        std::string text = "{\"services\":[";
+        for ( size_t i = 0; i < services; ++i )
+        {
+            if ( i > 0 )
+                text += ',';
+            text += "{\"name\":\"svc-" + std::to_string( i ) + "\",\"net\":{\"port\":"
+                    + std::to_string( 8000 + i ) + ",\"timeout_ms\":250},\"enabled\":true}";
+        }
+        return text + "]}";
+    }
+
+    std::string make_yaml_config( size_t services )
+    {
+        std::string text = "services:\n";
+        for ( size_t i = 0; i < services; ++i )
+        {
+            text += "  - name: svc-" + std::to_string( i ) + "\n    net:\n      port: "
+                    + std::to_string( 8000 + i ) + "\n      timeout_ms: 250\n    enabled: true\n";
+        }
+        return text;
+    }
+
+}   // namespace
+
+TEST_CASE( "Config lookup", "[.][benchmark][config]" )
+{
+    constexpr size_t k_services = 256;   // 1024 keys
+    constexpr size_t k_count    = 2'000'000;
+
+    const auto text = make_config( k_services );
+
+    std::vector< std::string > keys;
+    for ( size_t i = 0; i < k_services; ++i )
+        keys.push_back( "/services/" + std::to_string( i ) + "/net/port" );
+
+    auto start    = clock::now();
+    auto values   = sl::config::json_from_string( text );
+    auto parsed   = std::chrono::duration< double, std::micro >( clock::now() - start ).count();
+    start         = clock::now();
+    auto snapshot = sl::config::compile_json( text );
+    auto compiled = std::chrono::duration< double, std::micro >( clock::now() - start ).count();
+
+    std::printf( "load: values %.0f us, snapshot %.0f us (%zu keys)\n",
+                 parsed,
+                 compiled,
+                 snapshot.size() );
+
+    std::vector< sl::config::key< int64_t > > bound;
+    for ( const auto& k : keys )
+        bound.push_back( snapshot.bind( k ) );
+
+    run( "values::get", k_count, [&]( size_t i ) {
+        return values.get< int64_t >( keys[i % k_services] );
+    } );
+    run( "snapshot::get", k_count, [&]( size_t i ) {
+        return snapshot.get< int64_t >( keys[i % k_services] );
+    } );
+    run( "key< int64_t >::get", k_count, [&]( size_t i ) {
+        return bound[i % k_services].get();
+    } );
+}
+
+TEST_CASE( "Config load", "[.][benchmark][config]" )
+{
+    const auto text = make_config( 32 * 1024 );   // ~4 MiB, 128K keys
+
+    auto time = [&]( const char* label, auto&& load ) {
+        auto start = clock::now();
+        load();
+        auto ms = std::chrono::duration< double, std::milli >( clock::now() - start ).count();
+        std::printf( "%-24s %8.1f ms  %6.1f MiB/s\n",
+                     label,
+                     ms,
+                     static_cast< double >( text.size() ) / ( 1024.0 * 1024.0 ) / ( ms / 1000.0 ) );
+    };
+
+    time( "DOM + flatten", [&] { return nlohmann::json::parse( text ).flatten(); } );
+    time( "config::json (SAX)", [&] { return sl::config::json_from_string( text ); } );
+    time( "compile_json (SAX)", [&] { return sl::config::compile_json( text ); } );
+}
+
+TEST_CASE( "YAML load", "[.][benchmark][config]" )
+{
+    const auto json = make_config( 32 * 1024 );   // Same 128K keys in both formats
+    const auto yaml = make_yaml_config( 32 * 1024 );
+
+    auto time = [&]( const char* label, const std::string& text, auto&& load ) {
+        auto start = clock::now();
+        load( text );
+        auto ms = std::chrono::duration< double, std::milli >( clock::now() - start ).count();
+        std::printf( "%-24s %8.1f ms  %6.1f MiB/s  (%.1f MiB)\n",
+                     label,
+                     ms,
+                     static_cast< double >( text.size() ) / ( 1024.0 * 1024.0 ) / ( ms / 1000.0 ),
+                     static_cast< double >( text.size() ) / ( 1024.0 * 1024.0 ) );
+    };
+
+    time( "compile_json", json, []( auto& t ) { return sl::config::compile_json( t ); } );
+    time( "compile_yaml", yaml, []( auto& t ) { return sl::config::compile_yaml( t ); } );
+    time( "yaml_from_string", yaml, []( auto& t ) { return sl::config::yaml_from_string( t ); } );
+}
+
+TEST_CASE( "Live config read cost", "[.][benchmark][config]" )
+{
+    constexpr size_t k_threads = 4;
+    constexpr size_t k_count   = 5'000'000;
+
+    sl::config::live live { sl::config::compile_json( R"({"net":{"port":8080}})" ) };
+
+    auto measure = [&]( const char* label, auto&& read ) {
+        std::vector< std::jthread > threads;
+        auto start = clock::now();
+        for ( size_t t = 0; t < k_threads; ++t )
+        {
+            threads.emplace_back( [&] {
+                decltype( live )::reader reader { live };
+                int64_t sum = 0;
+                for ( size_t i = 0; i < k_count; ++i )
+                    sum += read( reader );
+                if ( sum == 42 )
+                    std::printf( "unlikely\n" );
+            } );
+        }
+        threads.clear();
+        auto secs = std::chrono::duration< double >( clock::now() - start ).count();
+        std::printf( "%-24s %8.1f ns/read (%zu threads)\n",
+                     label,
+                     secs * 1e9 / static_cast< double >( k_count ),
+                     k_threads );
+    };
+
+    measure( "live::current", [&]( auto& ) { return live.current()->size(); } );
+    measure( "live::reader::get", []( auto& reader ) { return reader.get().size(); } );
+}
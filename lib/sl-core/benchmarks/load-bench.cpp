@@ -0,0 +1,143 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023-present Robert Anderson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <catch2/catch.hpp>
+#include <test/temp.h>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include <io/load.h>
+
+namespace
+{
+
+    using clock = std::chrono::steady_clock;
+
+    /**
+     * Size of the loaded file in MiB (SL_BENCH_LOAD_MB overrides the default).
+     **/
+    size_t file_size()
+    {
+        size_t mb = 256;
+        if ( auto env = std::getenv( "SL_BENCH_LOAD_MB" ) )
+            mb = std::strtoul( env, nullptr, 10 );
+        return ( mb ? mb : 1 ) * 1024 * 1024;
+    }
+
+    void drop_cache( const char* path )
+    {
+#if defined( __linux__ )
+        auto fd = ::open( path, O_RDONLY );
+        if ( fd < 0 )
+            return;
+        ::posix_fadvise( fd, 0, 0, POSIX_FADV_DONTNEED );
+        ::close( fd );
+#else
+        (void)path;
+#endif
+    }
+
+    /**
+     * Touches one byte per page, so lazily faulted (mapped) data is charged fairly.
+     **/
+    template< typename Buffer >
+    size_t touch( const Buffer& buf )
+    {
+        size_t sum = 0;
+        for ( size_t i = 0; i < buf.size(); i += 4096 )
+            sum += static_cast< unsigned char >( buf[i] );
+        return sum;
+    }
+
+    template< typename Fn >
+    void measure( const char* label, const char* path, bool cold, Fn&& fn )
+    {
+        constexpr int k_rounds = 5;
+
+        double best = 1e30;
+        size_t sum  = 0;
+        for ( int i = 0; i < k_rounds; ++i )
+        {
+            if ( cold )
+                drop_cache( path );
+
+            auto start = clock::now();
+            sum += fn();
+            best = std::min(
+                best, std::chrono::duration< double, std::milli >( clock::now() - start ).count() );
+        }
+
+        std::printf(
+            "%-5s %-26s %9.2f ms (check %zu)\n", cold ? "cold" : "warm", label, best, sum );
+    }
+
+}   // namespace
+
+TEST_CASE( "Load buffer vs load_file", "[.][benchmark][io][load]" )
+{
+    sl::test::temp_file tmp( "sl-bench-load", ".bin" );
+    const auto& path = tmp.path;
+    const auto size  = file_size();
+
+    {
+        std::ofstream out( path, std::ios::binary | std::ios::trunc );
+        std::string block( 1024 * 1024, 'x' );
+        for ( size_t i = 0; i < size; i += block.size() )
+            out.write( block.data(), block.size() );
+    }
+
+    std::printf( "Loading %zu MiB\n", size / ( 1024 * 1024 ) );
+
+    for ( bool cold : { false, true } )
+    {
+        measure( "load_file", path.c_str(), cold, [&] {
+            return touch( sl::io::load_file< std::byte >( path ) );
+        } );
+
+        measure( "load_buffer (read, 1)", path.c_str(), cold, [&] {
+            return touch( sl::io::load_buffer< std::byte >(
+                path, { .strategy = sl::io::load_strategy::read, .threads = 1 } ) );
+        } );
+
+        measure( "load_buffer (read, team)", path.c_str(), cold, [&] {
+            return touch( sl::io::load_buffer< std::byte >(
+                path, { .strategy = sl::io::load_strategy::read } ) );
+        } );
+
+        measure( "load_buffer (map)", path.c_str(), cold, [&] {
+            return touch( sl::io::load_buffer< std::byte >(
+                path, { .strategy = sl::io::load_strategy::map } ) );
+        } );
+    }
+}
@@ -0,0 +1,175 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023-present Robert Anderson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <catch2/catch.hpp>
+#include <test/temp.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <thread>
+#include <vector>
+
+#include <logging/binary.h>
+#include <logging/limit.h>
+#include <logging/logger.h>
+#include <logging/rotating.h>
+
+namespace
+{
+
+    using clock = std::chrono::steady_clock;
+
+    /**
+     * Runs 'threads' producers of 'count' messages each against 'logger' and prints throughput
+     * along with per-call latency percentiles (as seen by the calling thread).
+     */
+    void run( const char* label, sl::logging::logger& logger, int threads, size_t count )
+    {
+        std::vector< std::vector< uint32_t > > latencies( threads );
+
+        auto start = clock::now();
+        {
+            std::vector< std::jthread > workers;
+            for ( int t = 0; t < threads; ++t )
+            {
+                workers.emplace_back( [&, t] {
+                    auto& lat = latencies[t];
+                    lat.reserve( count );
+                    for ( size_t i = 0; i < count; ++i )
+                    {
+                        auto before = clock::now();
+                        logger.info( "worker %d processed item %zu (%s)", t, i, "ok" );
+                        lat.push_back( static_cast< uint32_t >(
+                            std::chrono::nanoseconds( clock::now() - before ).count() ) );
+                    }
+                } );
+            }
+        }
+        logger.flush();
+        auto secs = std::chrono::duration< double >( clock::now() - start ).count();
+
+        std::vector< uint32_t > all;
+        for ( auto& lat : latencies )
+            all.insert( all.end(), lat.begin(), lat.end() );
+        std::sort( all.begin(), all.end() );
+
+        std::printf( "%-6s %2d thread(s): %10.0f lines/s  p50 %6u ns  p99 %7u ns  max %9u ns\n",
+                     label,
+                     threads,
+                     static_cast< double >( all.size() ) / secs,
+                     all[all.size() / 2],
+                     all[all.size() * 99 / 100],
+                     all.back() );
+    }
+
+}   // namespace
+
+TEST_CASE( "Logger throughput and latency", "[.][benchmark][logging]" )
+{
+    constexpr size_t k_count = 200000;
+
+    // A real file rather than /dev/null, so the synchronous path pays for its per-line write.
+    sl::test::temp_file tmp( "sl-bench-logging", ".log" );
+    const auto& path = tmp.path;
+
+    for ( int threads : { 1, 2, 4 } )
+    {
+        {
+            std::filesystem::remove( path );
+            sl::logging::logger logger( path.c_str() );
+            run( "sync", logger, threads, k_count );
+        }
+
+        {
+            std::filesystem::remove( path );
+            sl::logging::rotating_file_sink sink( path, { .compressor = {} } );
+            sl::logging::logger logger( sink );
+            run( "rotate", logger, threads, k_count );
+        }
+
+        {
+            std::filesystem::remove( path );
+            sl::logging::fd_sink sink( path.c_str() );
+            sl::logging::async_backend backend( sink );
+            sl::logging::logger logger( backend );
+            run( "async", logger, threads, k_count );
+        }
+
+        {
+            std::filesystem::remove( path );
+            sl::logging::fd_sink sink( path.c_str() );
+            sl::logging::async_backend backend( sink, { .deferred = true } );
+            sl::logging::logger logger( backend );
+            run( "defer", logger, threads, k_count );
+        }
+
+        {
+            std::filesystem::remove( path );
+            sl::logging::binary_sink sink( path.c_str() );
+            sl::logging::async_backend backend( sink, { .deferred = true } );
+            sl::logging::logger logger( backend );
+            run( "binary", logger, threads, k_count );
+        }
+    }
+
+    std::filesystem::remove( path );
+}
+
+TEST_CASE( "Disabled log call cost", "[.][benchmark][logging]" )
+{
+    constexpr size_t k_count = 50'000'000;
+
+    sl::logging::logger logger( "/dev/null" );
+    logger.set_level( sl::logging::log_level::info );
+
+    auto start = clock::now();
+    for ( size_t i = 0; i < k_count; ++i )
+        logger.trace( "item %zu of %zu (%s)", i, k_count, "skipped" );
+    auto secs = std::chrono::duration< double >( clock::now() - start ).count();
+
+    std::printf( "disabled trace: %6.2f ns/call\n", secs * 1e9 / static_cast< double >( k_count ) );
+}
+
+TEST_CASE( "Rate limited log call cost", "[.][benchmark][logging]" )
+{
+    constexpr size_t k_count = 10'000'000;
+
+    sl::test::temp_file tmp( "sl-bench-logging", ".log" );
+    const auto& path = tmp.path;
+    {
+        sl::logging::logger logger( path.c_str() );
+
+        // After the first burst nearly every call is turned away by the limiter.
+        auto start = clock::now();
+        for ( size_t i = 0; i < k_count; ++i )
+            SL_LOG_LIMITED_TO( logger, sl::logging::log_level::error, 10, 10, "storm %zu", i );
+        auto secs = std::chrono::duration< double >( clock::now() - start ).count();
+
+        std::printf( "rate limited (storm): %6.2f ns/call\n",
+                     secs * 1e9 / static_cast< double >( k_count ) );
+    }
+}
@@ -0,0 +1,153 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023-present Robert Anderson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <catch2/catch.hpp>
+#include <test/temp.h>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+
+#include <io/mapped-file.h>
+
+namespace
+{
+
+    using clock = std::chrono::steady_clock;
+
+    double ms_since( clock::time_point start )
+    {
+        return std::chrono::duration< double, std::milli >( clock::now() - start ).count();
+    }
+
+    /**
+     * Size of the mapped file in MiB (SL_BENCH_MAP_MB overrides the default).
+     **/
+    size_t file_size()
+    {
+        size_t mb = 256;
+        if ( auto env = std::getenv( "SL_BENCH_MAP_MB" ) )
+            mb = std::strtoul( env, nullptr, 10 );
+        return ( mb ? mb : 1 ) * 1024 * 1024;
+    }
+
+    /**
+     * Evicts the file from the page cache (where supported) so touches hit the device.
+     **/
+    void drop_cache( const char* path )
+    {
+#if defined( __linux__ )
+        auto fd = ::open( path, O_RDONLY );
+        if ( fd < 0 )
+            return;
+        ::fdatasync( fd );
+        ::posix_fadvise( fd, 0, 0, POSIX_FADV_DONTNEED );
+        ::close( fd );
+#else
+        (void)path;
+#endif
+    }
+
+    unsigned touch( const sl::io::mapped_view& view )
+    {
+        auto bytes    = static_cast< const volatile unsigned char* >( view.data() );
+        unsigned sum  = 0;
+        const auto pg = sl::io::mapped_view::page_size();
+        for ( size_t off = 0; off < view.size(); off += pg )
+            sum += bytes[off];
+        return sum;
+    }
+
+    void first_touch( const char* label, const char* path, bool cold )
+    {
+        constexpr int k_rounds = 5;
+
+        double plain   = 1e30;
+        double warming = 1e30;
+        double warmed  = 1e30;
+        unsigned sum   = 0;
+
+        sl::io::mapped_file mf( path );
+        for ( int i = 0; i < k_rounds; ++i )
+        {
+            if ( cold )
+                drop_cache( path );
+
+            {
+                auto mv    = mf.map_view( 0, mf.size() );
+                auto start = clock::now();
+                sum += touch( mv );
+                plain = std::min( plain, ms_since( start ) );
+            }
+
+            if ( cold )
+                drop_cache( path );
+
+            {
+                auto mv    = mf.map_view( 0, mf.size() );
+                auto start = clock::now();
+                mv.populate();
+                warming = std::min( warming, ms_since( start ) );
+
+                start = clock::now();
+                sum += touch( mv );
+                warmed = std::min( warmed, ms_since( start ) );
+            }
+        }
+
+        std::printf( "%-12s first touch %8.2f ms | populate %8.2f ms + touch %8.2f ms (sum %u)\n",
+                     label,
+                     plain,
+                     warming,
+                     warmed,
+                     sum );
+    }
+
+}   // namespace
+
+TEST_CASE( "First touch with and without populate", "[.][benchmark][io][mapped-file]" )
+{
+    sl::test::temp_file tmp( "sl-bench-first-touch", ".bin" );
+    const auto& path = tmp.path;
+    const auto size  = file_size();
+
+    {
+        sl::io::mapped_file mf( path.c_str(), sl::io::access_mode::create );
+        mf.preallocate( size );
+        auto mv = mf.map_view( 0, size );
+        std::memset( mv.data(), 1, size );
+        mv.sync();
+    }
+
+    std::printf( "Mapping %zu MiB\n", size / ( 1024 * 1024 ) );
+    first_touch( "page cache", path.c_str(), false );
+    first_touch( "cold", path.c_str(), true );
+}
@@ -0,0 +1,120 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023-present Robert Anderson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <catch2/catch.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <mem/pages.h>
+
+namespace
+{
+
+    /**
+     * Size of the walked buffer in GiB (SL_BENCH_PAGE_WALK_GB overrides the default).
+     **/
+    size_t walk_size()
+    {
+        size_t gb = 2;
+        if ( auto env = std::getenv( "SL_BENCH_PAGE_WALK_GB" ) )
+            gb = std::strtoul( env, nullptr, 10 );
+        return ( gb ? gb : 1 ) * 1024 * 1024 * 1024;
+    }
+
+    const char* kind_name( sl::mem::page_kind kind )
+    {
+        switch ( kind )
+        {
+            case sl::mem::page_kind::huge_tlb: return "hugetlb";
+            case sl::mem::page_kind::transparent_huge: return "thp";
+            default: return "4k";
+        }
+    }
+
+    void walk( const char* label, size_t size, sl::mem::page_options options )
+    {
+        using clock = std::chrono::steady_clock;
+
+        sl::mem::page_region region( size, options );
+        if ( !region )
+        {
+            std::printf( "%-10s mapping %zu bytes failed, skipped\n", label, size );
+            return;
+        }
+
+        auto bytes = static_cast< unsigned char* >( region.data() );
+        auto start = clock::now();
+        std::memset( bytes, 1, size );   // Pre-fault so the walks only measure translation
+        auto fault = clock::now() - start;
+
+        // Sequential stride of one base page: one TLB entry per touch with 4K pages.
+        const size_t stride = sl::mem::page_region::base_page_size();
+        uint64_t sum        = 0;
+        start               = clock::now();
+        for ( size_t off = 0; off < size; off += stride )
+            sum += bytes[off];
+        auto sequential = clock::now() - start;
+
+        // Random reads across the whole buffer defeat the prefetcher and most of the TLB.
+        constexpr size_t k_reads = 16 * 1024 * 1024;
+        uint64_t state           = 0x9E3779B97F4A7C15ull;
+        start                    = clock::now();
+        for ( size_t i = 0; i < k_reads; ++i )
+        {
+            state = state * 6364136223846793005ull + 1442695040888963407ull;
+            sum += bytes[( state >> 16 ) % size];
+        }
+        auto random = clock::now() - start;
+
+        auto ns = []( auto d ) {
+            return static_cast< double >(
+                std::chrono::duration_cast< std::chrono::nanoseconds >( d ).count() );
+        };
+
+        std::printf( "%-10s [%-7s] fault %8.1f ms | seq %6.2f ns/page | random %6.2f ns/read"
+                     " (sum %llu)\n",
+                     label,
+                     kind_name( region.kind() ),
+                     ns( fault ) / 1e6,
+                     ns( sequential ) / static_cast< double >( size / stride ),
+                     ns( random ) / static_cast< double >( k_reads ),
+                     static_cast< unsigned long long >( sum ) );
+    }
+
+}   // namespace
+
+TEST_CASE( "Walk buffer with base vs huge pages", "[.][benchmark][memory][pages]" )
+{
+    const auto size = walk_size();
+    std::printf( "Walking %zu MiB\n", size / ( 1024 * 1024 ) );
+
+    // One region at a time so the benchmark fits in half the memory it would otherwise.
+    walk( "base", size, { .huge_pages = false } );
+    walk( "huge", size, { .huge_pages = true } );
+}
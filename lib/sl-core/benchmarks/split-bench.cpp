@@ -0,0 +1,130 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023-present Robert Anderson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <catch2/catch.hpp>
+
+#include <atomic>
+#include <cstring>
+#include <random>
+#include <string>
+
+#include <io/split.h>
+
+namespace
+{
+
+    /**
+     * Roughly 16 MiB of log-like lines between 20 and 200 bytes long.
+     **/
+    std::string make_log()
+    {
+        std::mt19937 rng( 42 );
+        std::string data;
+        data.reserve( 17 * 1024 * 1024 );
+        while ( data.size() < 16 * 1024 * 1024 )
+        {
+            auto len = 20 + rng() % 180;
+            for ( size_t i = 0; i < len; ++i )
+                data.push_back( static_cast< char >( ' ' + rng() % 90 ) );
+            data.push_back( '\n' );
+        }
+        return data;
+    }
+
+    template< typename Find >
+    size_t count_lines( const std::string& data, Find&& find )
+    {
+        size_t lines = 0;
+        auto p       = data.data();
+        auto end     = p + data.size();
+        while ( p < end )
+        {
+            p = find( p, end ) + 1;
+            ++lines;
+        }
+        return lines;
+    }
+
+}   // namespace
+
+TEST_CASE( "Line splitting", "[.][benchmark][io][split]" )
+{
+    const auto data = make_log();
+
+    BENCHMARK( "byte loop" )
+    {
+        return count_lines( data, []( const char* p, const char* end ) {
+            while ( p < end && *p != '\n' )
+                ++p;
+            return p;
+        } );
+    };
+
+    BENCHMARK( "memchr" )
+    {
+        return count_lines( data, []( const char* p, const char* end ) {
+            auto hit = static_cast< const char* >( std::memchr( p, '\n', end - p ) );
+            return hit ? hit : end;
+        } );
+    };
+
+#if defined( SL_IO_SPLIT_SSE2 )
+    BENCHMARK( "find_any (sse2)" )
+    {
+        return count_lines( data, []( const char* p, const char* end ) {
+            return sl::io::detail::find_any_sse2( p, end, '\n', '\n' );
+        } );
+    };
+#endif
+
+#if defined( SL_IO_SPLIT_AVX2 )
+    if ( __builtin_cpu_supports( "avx2" ) )
+    {
+        BENCHMARK( "find_any (avx2)" )
+        {
+            return count_lines( data, []( const char* p, const char* end ) {
+                return sl::io::detail::find_any_avx2( p, end, '\n', '\n' );
+            } );
+        };
+    }
+#endif
+
+    BENCHMARK( "split_lines" )
+    {
+        size_t bytes = 0;
+        for ( auto line : sl::io::split_lines( data ) )
+            bytes += line.size();
+        return bytes;
+    };
+
+    BENCHMARK( "parallel_for_each_record" )
+    {
+        std::atomic< size_t > bytes { 0 };
+        sl::io::parallel_for_each_record( data, 0, [&bytes]( size_t, std::string_view line ) {
+            bytes.fetch_add( line.size(), std::memory_order_relaxed );
+        } );
+        return bytes.load();
+    };
+}
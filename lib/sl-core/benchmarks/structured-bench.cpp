@@ -0,0 +1,107 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023-present Robert Anderson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+#include <nlohmann/json.hpp>
+
+#include <logging/structured.h>
+
+namespace
+{
+
+    using clock = std::chrono::steady_clock;
+
+    template< typename Fn >
+    void run( const char* label, size_t count, Fn&& fn )
+    {
+        size_t bytes = 0;
+
+        auto start = clock::now();
+        for ( size_t i = 0; i < count; ++i )
+            bytes += fn( i );
+        auto secs = std::chrono::duration< double >( clock::now() - start ).count();
+
+        std::printf( "%-16s %8.1f ns/record  %7.1f MiB/s\n",
+                     label,
+                     secs * 1e9 / static_cast< double >( count ),
+                     static_cast< double >( bytes ) / ( 1024.0 * 1024.0 ) / secs );
+    }
+
+}   // namespace
+
+TEST_CASE( "Structured record encoding", "[.][benchmark][logging][structured]" )
+{
+    using sl::logging::kv;
+
+    constexpr size_t k_count = 1'000'000;
+
+    std::array< char, 1024 > buf;
+    const std::string peer = "192.168.1.20:55012";
+    const char* path       = "/api/v1/items?id=\"42\"";
+
+    run( "json_line_writer", k_count, [&]( size_t i ) {
+        return sl::logging::encode_json_line( buf.data(),
+                                              buf.size(),
+                                              sl::logging::log_level::info,
+                                              "request done",
+                                              kv( "id", i ),
+                                              kv( "peer", peer ),
+                                              kv( "path", path ),
+                                              kv( "lat_us", 12.25 * static_cast< double >( i ) ),
+                                              kv( "ok", true ) );
+    } );
+
+    run( "nlohmann::json", k_count, [&]( size_t i ) {
+        nlohmann::json record = {
+            { "ts", 0 },
+            { "level", "info" },
+            { "msg", "request done" },
+            { "id", i },
+            { "peer", peer },
+            { "path", path },
+            { "lat_us", 12.25 * static_cast< double >( i ) },
+            { "ok", true },
+        };
+        return record.dump().size();
+    } );
+
+    run( "snprintf (text)", k_count, [&]( size_t i ) {
+        auto n = std::snprintf( buf.data(),
+                                buf.size(),
+                                "[INFO] request done id=%zu peer=%s path=%s lat_us=%g ok=%s\n",
+                                i,
+                                peer.c_str(),
+                                path,
+                                12.25 * static_cast< double >( i ),
+                                "true" );
+        return static_cast< size_t >( n );
+    } );
+}
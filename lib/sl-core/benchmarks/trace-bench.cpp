@@ -0,0 +1,73 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023-present Robert Anderson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+
+#include <catch2/catch.hpp>
+
+#include <chrono>
+#include <cstdio>
+
+#include <trace/trace.h>
+
+namespace
+{
+
+    using clock = std::chrono::steady_clock;
+
+    template< typename Fn >
+    void run( const char* label, size_t count, Fn&& fn )
+    {
+        auto start = clock::now();
+        for ( size_t i = 0; i < count; ++i )
+            fn( i );
+        auto secs = std::chrono::duration< double >( clock::now() - start ).count();
+
+        std::printf( "%-24s %8.1f ns/op\n", label, secs * 1e9 / static_cast< double >( count ) );
+    }
+
+}   // namespace
+
+TEST_CASE( "Trace point cost", "[.][benchmark][trace]" )
+{
+    constexpr size_t k_count = 10'000'000;
+
+    std::printf( "timestamp source: %s\n", sl::trace::detail::use_tsc ? "tsc" : "steady_clock" );
+
+    sl::trace::stop();
+    run( "span (stopped)", k_count, []( size_t ) { SL_TRACE_SPAN( "bench", "span" ); } );
+
+    sl::trace::start();
+    run( "span", k_count, []( size_t ) { SL_TRACE_SPAN( "bench", "span" ); } );
+    run( "instant", k_count, []( size_t ) { SL_TRACE_INSTANT( "bench", "instant" ); } );
+    run( "counter", k_count, []( size_t i ) { SL_TRACE_COUNTER( "bench", "counter", i ); } );
+    sl::trace::stop();
+
+    volatile int64_t sink = 0;
+    run( "steady_clock::now", k_count, [&]( size_t ) {
+        sink = clock::now().time_since_epoch().count();
+    } );
+
+    sl::trace::clear();
+}
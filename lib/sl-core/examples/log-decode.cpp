@@ -0,0 +1,65 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023-present Robert Anderson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <cstdio>
+#include <exception>
+
+#include <io/load.h>
+#include <logging/binary.h>
+
+/**
+ * Turns a binary log (written through 'sl::logging::binary_sink') back into text.
+ *
+ *  usage: log-decode <file>
+ */
+int main( int argc, char** argv )
+{
+    if ( argc != 2 )
+    {
+        std::fprintf( stderr, "usage: %s <binary log>\n", argv[0] );
+        return 2;
+    }
+
+    try
+    {
+        auto data = sl::io::load_buffer< char >( argv[1] );
+        auto ok   = sl::logging::decode_binary_log( data, []( std::string_view line ) {
+            std::fwrite( line.data(), 1, line.size(), stdout );
+        } );
+
+        if ( !ok )
+        {
+            std::fprintf( stderr, "%s: not a binary log, or it ends in a torn entry\n", argv[1] );
+            return 1;
+        }
+    }
+    catch ( const std::exception& e )
+    {
+        std::fprintf( stderr, "error: %s\n", e.what() );
+        return 1;
+    }
+
+    return 0;
+}
@@ -30,56 +30,224 @@
 #define JSON_SKIP_UNSUPPORTED_COMPILER_CHECK 1
 #include <nlohmann/json.hpp>
 
+#include <charconv>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
 #include <io/mapped-file.h>
 
+#include "./snapshot.h"
+#include "./values.h"
+
 namespace sl::config
 {
 
-    template< typename ConfigData >
-    struct values
+    namespace detail
     {
-        explicit values( ConfigData&& data )
-            : _data { std::move( data ) }
-        {}
 
-        template< typename T >
-        inline T get( const std::string& key ) const
+        /**
+         * SAX handler that turns a JSON document straight into flattened "/a/b/0" keys
+         * (the keys, escaping and empty container handling of nlohmann's flatten()) and
+         * hands each value to the sink as it is parsed. No DOM is built. Keys are views of
+         * one reused path buffer; nlohmann hands strings over already unescaped in a
+         * std::string, so sinks copy what they keep.
+         */
+        template< typename Sink >
+        class flat_json_sax
         {
-            return _data.template get< T >( key );
+        public:
+            using string_t = nlohmann::json::string_t;
+            using binary_t = nlohmann::json::binary_t;
+
+            explicit flat_json_sax( Sink& sink )
+                : _sink { sink }
+            {}
+
+            bool null()
+            {
+                _sink.add_null( value_key() );
+                return true;
+            }
+
+            bool boolean( bool v )
+            {
+                _sink.add_bool( value_key(), v );
+                return true;
+            }
+
+            bool number_integer( nlohmann::json::number_integer_t v )
+            {
+                _sink.add_int( value_key(), v );
+                return true;
+            }
+
+            bool number_unsigned( nlohmann::json::number_unsigned_t v )
+            {
+                _sink.add_uint( value_key(), v );
+                return true;
+            }
+
+            bool number_float( nlohmann::json::number_float_t v, const string_t& )
+            {
+                _sink.add_double( value_key(), v );
+                return true;
+            }
+
+            bool string( string_t& v )
+            {
+                _sink.add_string( value_key(), v );
+                return true;
+            }
+
+            bool binary( binary_t& )
+            {
+                _sink.add_null( value_key() );   // Never produced by JSON text
+                return true;
+            }
+
+            bool start_object( std::size_t ) { return open( false ); }
+            bool end_object() { return close(); }
+            bool start_array( std::size_t ) { return open( true ); }
+            bool end_array() { return close(); }
+
+            bool key( string_t& k )
+            {
+                auto& f = _frames.back();
+                _path.resize( f.path_size );
+                _path += '/';
+                for ( char c : k )
+                {
+                    if ( c == '~' )
+                        _path += "~0";
+                    else if ( c == '/' )
+                        _path += "~1";
+                    else
+                        _path += c;
+                }
+                f.empty = false;
+                return true;
+            }
+
+            template< typename Exception >
+            bool parse_error( std::size_t, const std::string&, const Exception& ex )
+            {
+                throw ex;
+            }
+
+        private:
+            struct frame
+            {
+                bool array;
+                bool empty;
+                size_t index;
+                size_t path_size;
+            };
+
+            std::string_view value_key()
+            {
+                if ( !_frames.empty() )
+                {
+                    auto& f = _frames.back();
+                    if ( f.array )
+                    {
+                        char digits[24];
+                        auto end = std::to_chars( digits, std::end( digits ), f.index++ ).ptr;
+                        _path.resize( f.path_size );
+                        _path += '/';
+                        _path.append( digits, end );
+                    }
+                    f.empty = false;
+                }
+                return _path;
+            }
+
+            bool open( bool array )
+            {
+                value_key();
+                _frames.push_back( { array, true, 0, _path.size() } );
+                return true;
+            }
+
+            bool close()
+            {
+                const auto f = _frames.back();
+                _frames.pop_back();
+
+                // flatten() keeps empty objects and arrays as null leaves
+                _path.resize( f.path_size );
+                if ( f.empty )
+                    _sink.add_null( _path );
+                return true;
+            }
+
+            Sink& _sink;
+            std::string _path;
+            std::vector< frame > _frames;
+        };
+
+        /**
+         * Sink collecting flattened values into a flat nlohmann object, as config::json
+         * looks them up.
+         */
+        struct flat_object_sink
+        {
+            void add_null( std::string_view k ) { out[std::string { k }] = nullptr; }
+            void add_bool( std::string_view k, bool v ) { out[std::string { k }] = v; }
+            void add_int( std::string_view k, int64_t v ) { out[std::string { k }] = v; }
+            void add_uint( std::string_view k, uint64_t v ) { out[std::string { k }] = v; }
+            void add_double( std::string_view k, double v ) { out[std::string { k }] = v; }
+
+            void add_string( std::string_view k, const std::string& v )
+            {
+                out[std::string { k }] = v;
+            }
+
+            nlohmann::json& out;
+        };
+
+        template< typename Sink >
+        void parse_flat_json( const std::string_view data, Sink& sink )
+        {
+            flat_json_sax< Sink > sax { sink };
+            nlohmann::json::sax_parse( std::begin( data ), std::end( data ), &sax );
         }
 
-    private:
-        ConfigData _data;
-    };
+    }   // namespace detail
+
 
     struct json
     {
     public:
         explicit json( const std::string_view data )
+            : _data( nlohmann::json::object() )
         {
-            auto j = nlohmann::json::parse( std::begin( data ), std::end( data ) );
-            _data  = j.flatten();
+            detail::flat_object_sink sink { _data };
+            detail::parse_flat_json( data, sink );
         }
 
         template< typename T >
         T get( const std::string& key ) const
         {
-            if ( !_data.contains( key ) )
+            auto it = _data.find( key );
+            if ( it == _data.end() )
                 throw std::runtime_error( "config key not found" );
 
-            return _data[key].get< T >();
+            return it->template get< T >();
         }
 
     private:
         nlohmann::json _data;
     };
 
-    auto json_from_string( const std::string_view data )
+    inline auto json_from_string( const std::string_view data )
     {
         return config::values { config::json { data } };
     }
 
-    auto load_json( const char* const path )
+    inline auto load_json( const char* const path )
     {
         auto mf   = io::mapped_file( path, io::cache_hint::sequential );
         auto mv   = mf.map_view( 0, mf.size() );
@@ -88,6 +256,26 @@ namespace sl::config
         return json_from_string( std::string_view { data.data(), data.size() } );
     }
 
+    /**
+     * Parses a JSON document in one streaming pass and compiles it into an immutable
+     * snapshot with the same flattened keys as config::json (e.g. "/Image/IDs/1").
+     */
+    inline snapshot compile_json( const std::string_view data )
+    {
+        snapshot_builder builder;
+        detail::parse_flat_json( data, builder );
+        return std::move( builder ).build();
+    }
+
+    inline snapshot compile_json_file( const char* const path )
+    {
+        auto mf   = io::mapped_file( path, io::cache_hint::sequential );
+        auto mv   = mf.map_view( 0, mf.size() );
+        auto data = mv.as_items< char >();
+
+        return compile_json( std::string_view { data.data(), data.size() } );
+    }
+
 }   // namespace sl::config
 
 
@@ -0,0 +1,137 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023-present Robert Anderson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+
+#ifndef __LIVE_H_25243E90F2E44D55999BE5B3A4673274__
+#define __LIVE_H_25243E90F2E44D55999BE5B3A4673274__
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include <utils/noncopyable.h>
+
+namespace sl::config
+{
+
+    /**
+     * Holds the current config snapshot and swaps in new ones without blocking readers.
+     * Readers take a shared_ptr to whatever is current and keep that snapshot alive for as
+     * long as they hold it, RCU style; a publish never waits for them. Without
+     * std::atomic< std::shared_ptr > (__cpp_lib_atomic_shared_ptr) a mutex guards the
+     * pointer instead.
+     */
+    template< typename Snapshot >
+    class live : sl::utils::noncopyable
+    {
+    public:
+        using pointer = std::shared_ptr< const Snapshot >;
+
+        /**
+         * Per-thread read handle. get() only checks the generation counter and re-reads the
+         * shared pointer after a publish, so steady-state reads touch no shared refcount.
+         * The reference it returns stays valid until the next get() on this reader.
+         */
+        class reader
+        {
+        public:
+            explicit reader( const live& source )
+                : _source { source }
+            {}
+
+            const Snapshot& get()
+            {
+                const auto generation = _source.generation();
+                if ( generation != _generation )
+                {
+                    _current    = _source.current();
+                    _generation = generation;
+                }
+                return *_current;
+            }
+
+        private:
+            const live& _source;
+            pointer _current;
+            uint64_t _generation = 0;
+        };
+
+        explicit live( Snapshot initial )
+            : _current { std::make_shared< const Snapshot >( std::move( initial ) ) }
+        {}
+
+        pointer current() const
+        {
+#if defined( __cpp_lib_atomic_shared_ptr )
+            return _current.load( std::memory_order_acquire );
+#else
+            std::lock_guard lock { _mutex };
+            return _current;
+#endif
+        }
+
+        /**
+         * Bumped after every publish; starts at 1.
+         */
+        uint64_t generation() const noexcept
+        {
+            return _generation.load( std::memory_order_acquire );
+        }
+
+        void publish( Snapshot next )
+        {
+            publish( std::make_shared< const Snapshot >( std::move( next ) ) );
+        }
+
+        void publish( pointer next )
+        {
+#if defined( __cpp_lib_atomic_shared_ptr )
+            _current.store( std::move( next ), std::memory_order_release );
+#else
+            {
+                std::lock_guard lock { _mutex };
+                _current.swap( next );
+            }
+            next.reset();   // Drop the old snapshot outside the lock
+#endif
+            _generation.fetch_add( 1, std::memory_order_acq_rel );
+        }
+
+    private:
+#if defined( __cpp_lib_atomic_shared_ptr )
+        std::atomic< pointer > _current;
+#else
+        mutable std::mutex _mutex;
+        pointer _current;
+#endif
+        std::atomic< uint64_t > _generation { 1 };
+    };
+
+}   // namespace sl::config
+
+
+#endif /* __LIVE_H_25243E90F2E44D55999BE5B3A4673274__ */
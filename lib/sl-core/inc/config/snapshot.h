@@ -0,0 +1,474 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023-present Robert Anderson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+
+#ifndef __SNAPSHOT_H_1B494DD4F4B44BB4AE330985AD88409F__
+#define __SNAPSHOT_H_1B494DD4F4B44BB4AE330985AD88409F__
+
+#include <algorithm>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace sl::config
+{
+
+    enum class value_type : uint8_t
+    {
+        null,
+        boolean,
+        integer,
+        unsigned_integer,
+        floating,
+        string,
+    };
+
+    /**
+     * Types a compiled config value can be read as.
+     */
+    template< typename T >
+    concept config_value = std::same_as< T, bool > || std::integral< T > || std::floating_point< T >
+                           || std::same_as< T, std::string_view > || std::same_as< T, std::string >;
+
+    namespace detail
+    {
+
+        struct text_ref
+        {
+            uint32_t offset;
+            uint32_t size;
+        };
+
+        /**
+         * Tagged union holding one config value. Strings point into the snapshot's text.
+         */
+        struct value
+        {
+            value_type type = value_type::null;
+            union
+            {
+                bool boolean = false;
+                int64_t integer;
+                uint64_t unsigned_integer;
+                double floating;
+                text_ref string;
+            };
+        };
+
+        struct slot
+        {
+            static constexpr uint32_t k_empty = UINT32_MAX;
+
+            text_ref key { k_empty, 0 };
+            value data;
+        };
+
+        inline uint64_t mix64( uint64_t x )
+        {
+            x ^= x >> 30;
+            x *= 0xBF58476D1CE4E5B9ULL;
+            x ^= x >> 27;
+            x *= 0x94D049BB133111EBULL;
+            return x ^ ( x >> 31 );
+        }
+
+        inline uint64_t hash_key( std::string_view key )
+        {
+            uint64_t h = 0x9E3779B97F4A7C15ULL ^ key.size();
+            size_t i   = 0;
+            for ( ; i + 8 <= key.size(); i += 8 )
+            {
+                uint64_t w;
+                std::memcpy( &w, key.data() + i, 8 );
+                h = mix64( h ^ w );
+            }
+
+            uint64_t tail = 0;
+            std::memcpy( &tail, key.data() + i, key.size() - i );
+            return mix64( h ^ tail );
+        }
+
+        /**
+         * Maps the high half of 'h' onto [0, n) without a division.
+         */
+        inline uint32_t reduce( uint64_t h, uint32_t n )
+        {
+            return static_cast< uint32_t >( ( ( h >> 32 ) * n ) >> 32 );
+        }
+
+        inline uint32_t slot_of( uint64_t h, uint32_t seed, uint32_t slots )
+        {
+            return reduce( mix64( h ^ ( seed * 0x9E3779B97F4A7C15ULL ) ), slots );
+        }
+
+        template< config_value T >
+        T convert( const value& v, const char* text )
+        {
+            if constexpr ( std::same_as< T, bool > )
+            {
+                if ( v.type == value_type::boolean )
+                    return v.boolean;
+            }
+            else if constexpr ( std::integral< T > )
+            {
+                if ( v.type == value_type::integer || v.type == value_type::unsigned_integer )
+                {
+                    const bool fits = v.type == value_type::integer
+                                          ? std::in_range< T >( v.integer )
+                                          : std::in_range< T >( v.unsigned_integer );
+                    if ( !fits )
+                        throw std::runtime_error( "config value out of range" );
+
+                    return v.type == value_type::integer ? static_cast< T >( v.integer )
+                                                         : static_cast< T >( v.unsigned_integer );
+                }
+            }
+            else if constexpr ( std::floating_point< T > )
+            {
+                switch ( v.type )
+                {
+                case value_type::integer:
+                    return static_cast< T >( v.integer );
+                case value_type::unsigned_integer:
+                    return static_cast< T >( v.unsigned_integer );
+                case value_type::floating:
+                    return static_cast< T >( v.floating );
+                default:
+                    break;
+                }
+            }
+            else
+            {
+                if ( v.type == value_type::string )
+                    return T { text + v.string.offset, v.string.size };
+            }
+
+            throw std::runtime_error( "config value has the wrong type" );
+        }
+
+    }   // namespace detail
+
+
+    /**
+     * Pre-resolved handle to one config value. The value is converted and checked when the
+     * key is bound, so reading it is a plain load. String keys view the snapshot's text and
+     * must not outlive it; reading a 'key< std::string >' copies that text, so it may throw.
+     */
+    template< config_value T >
+    struct key
+    {
+    public:
+        using stored_type
+            = std::conditional_t< std::same_as< T, std::string >, std::string_view, T >;
+
+        explicit key( stored_type value )
+            : _value { value }
+        {}
+
+        static constexpr bool k_nothrow = !std::same_as< T, std::string >;
+
+        T get() const noexcept( k_nothrow ) { return T { _value }; }
+        T operator*() const noexcept( k_nothrow ) { return get(); }
+
+    private:
+        stored_type _value;
+    };
+
+
+    /**
+     * Immutable config compiled from flattened "/a/b/0" style keys. Keys are placed with a
+     * hash-and-displace perfect hash (one seed per small bucket of keys), so a lookup
+     * hashes the key once, reads one seed and compares against exactly one slot. Keys and
+     * string values share one text block; everything else is a tagged union per slot.
+     */
+    class snapshot
+    {
+    public:
+        struct binding
+        {
+        public:
+            template< config_value T >
+            operator key< T >() const
+            {
+                using stored_type = typename key< T >::stored_type;
+                return key< T > { detail::convert< stored_type >( _slot.data, _text ) };
+            }
+
+        private:
+            friend class snapshot;
+
+            binding( const detail::slot& slot, const char* text )
+                : _slot { slot }
+                , _text { text }
+            {}
+
+            const detail::slot& _slot;
+            const char* _text;
+        };
+
+        snapshot() = default;
+
+        size_t size() const noexcept { return _size; }
+        bool contains( std::string_view key ) const noexcept { return find( key ) != nullptr; }
+
+        value_type type( std::string_view key ) const { return lookup( key ).data.type; }
+
+        template< config_value T >
+        T get( std::string_view key ) const
+        {
+            return detail::convert< T >( lookup( key ).data, _text.get() );
+        }
+
+        /**
+         * Resolves 'key' once; convert the result to a config::key< T > to read it later.
+         * Throws if the key is missing, or (on conversion) if the value cannot be a T.
+         */
+        binding bind( std::string_view key ) const { return { lookup( key ), _text.get() }; }
+
+        /**
+         * Calls fn( key, type ) for every value, in no particular order.
+         */
+        template< typename Fn >
+        void for_each( Fn&& fn ) const
+        {
+            for ( const auto& s : _slots )
+            {
+                if ( s.key.offset != detail::slot::k_empty )
+                    fn( text( s.key ), s.data.type );
+            }
+        }
+
+    private:
+        friend class snapshot_builder;
+
+        std::string_view text( detail::text_ref ref ) const noexcept
+        {
+            return { _text.get() + ref.offset, ref.size };
+        }
+
+        const detail::slot* find( std::string_view key ) const noexcept
+        {
+            if ( _slots.empty() )
+                return nullptr;
+
+            const auto groups = static_cast< uint32_t >( _seeds.size() );
+            const auto slots  = static_cast< uint32_t >( _slots.size() );
+
+            const auto h    = detail::hash_key( key );
+            const auto seed = _seeds[detail::reduce( h, groups )];
+            const auto& s   = _slots[detail::slot_of( h, seed, slots )];
+
+            if ( s.key.offset == detail::slot::k_empty || text( s.key ) != key )
+                return nullptr;
+            return &s;
+        }
+
+        const detail::slot& lookup( std::string_view key ) const
+        {
+            auto s = find( key );
+            if ( !s )
+                throw std::runtime_error( "config key not found" );
+            return *s;
+        }
+
+        std::unique_ptr< char[] > _text;   // Stable across moves; string keys view it
+        std::vector< uint32_t > _seeds;
+        std::vector< detail::slot > _slots;
+        size_t _size = 0;
+    };
+
+
+    /**
+     * Collects flattened key / value pairs and compiles them into a snapshot. A key added
+     * more than once keeps its last value.
+     */
+    class snapshot_builder
+    {
+    public:
+        void add_null( std::string_view key ) { push( key, {} ); }
+
+        void add_bool( std::string_view key, bool v )
+        {
+            detail::value value;
+            value.type = value_type::boolean;
+            value.boolean = v;
+            push( key, value );
+        }
+
+        void add_int( std::string_view key, int64_t v )
+        {
+            detail::value value;
+            value.type = value_type::integer;
+            value.integer = v;
+            push( key, value );
+        }
+
+        void add_uint( std::string_view key, uint64_t v )
+        {
+            detail::value value;
+            value.type = value_type::unsigned_integer;
+            value.unsigned_integer = v;
+            push( key, value );
+        }
+
+        void add_double( std::string_view key, double v )
+        {
+            detail::value value;
+            value.type = value_type::floating;
+            value.floating = v;
+            push( key, value );
+        }
+
+        void add_string( std::string_view key, std::string_view v )
+        {
+            detail::value value;
+            value.type = value_type::string;
+            value.string = append( v );
+            push( key, value );
+        }
+
+        snapshot build() &&
+        {
+            dedupe();
+
+            const auto n      = static_cast< uint32_t >( _entries.size() );
+            const auto slots  = n + n / 4 + 1;   // ~80% load keeps the seed search short
+            const auto groups = n / 3 + 1;
+
+            std::vector< uint64_t > hashes( n );
+            for ( uint32_t i = 0; i < n; ++i )
+                hashes[i] = detail::hash_key( key( i ) );
+
+            // Bucket the keys, then place the largest buckets first while slots are free
+            std::vector< std::vector< uint32_t > > buckets( groups );
+            for ( uint32_t i = 0; i < n; ++i )
+                buckets[detail::reduce( hashes[i], groups )].push_back( i );
+
+            std::vector< uint32_t > order( groups );
+            std::iota( order.begin(), order.end(), 0 );
+            std::stable_sort( order.begin(), order.end(), [&]( uint32_t a, uint32_t b ) {
+                return buckets[a].size() > buckets[b].size();
+            } );
+
+            snapshot out;
+            out._seeds.assign( groups, 0 );
+            out._slots.resize( slots );
+
+            std::vector< uint32_t > placed;
+            for ( auto b : order )
+            {
+                const auto& bucket = buckets[b];
+                if ( bucket.empty() )
+                    break;
+
+                for ( uint32_t seed = 0;; ++seed )
+                {
+                    if ( seed == ( 1u << 24 ) )
+                        throw std::runtime_error( "failed to build config key table" );
+
+                    placed.clear();
+                    for ( auto i : bucket )
+                    {
+                        const auto s = detail::slot_of( hashes[i], seed, slots );
+                        if ( out._slots[s].key.offset != detail::slot::k_empty
+                             || std::find( placed.begin(), placed.end(), s ) != placed.end() )
+                            break;
+                        placed.push_back( s );
+                    }
+
+                    if ( placed.size() != bucket.size() )
+                        continue;
+
+                    out._seeds[b] = seed;
+                    for ( size_t k = 0; k < bucket.size(); ++k )
+                        out._slots[placed[k]] = _entries[bucket[k]];
+                    break;
+                }
+            }
+
+            out._text = std::make_unique< char[] >( _text.size() + 1 );
+            std::memcpy( out._text.get(), _text.data(), _text.size() );
+            out._size = n;
+            return out;
+        }
+
+    private:
+        detail::text_ref append( std::string_view s )
+        {
+            if ( _text.size() + s.size() > UINT32_MAX )
+                throw std::length_error( "config text exceeds 4GiB" );
+
+            detail::text_ref ref { static_cast< uint32_t >( _text.size() ),
+                                   static_cast< uint32_t >( s.size() ) };
+            _text.append( s );
+            return ref;
+        }
+
+        void push( std::string_view key, const detail::value& value )
+        {
+            _entries.push_back( { append( key ), value } );
+        }
+
+        std::string_view key( size_t i ) const
+        {
+            return { _text.data() + _entries[i].key.offset, _entries[i].key.size };
+        }
+
+        void dedupe()
+        {
+            std::vector< uint32_t > order( _entries.size() );
+            std::iota( order.begin(), order.end(), 0 );
+            std::stable_sort( order.begin(), order.end(), [&]( uint32_t a, uint32_t b ) {
+                return key( a ) < key( b );
+            } );
+
+            std::vector< detail::slot > unique;
+            unique.reserve( _entries.size() );
+            for ( size_t i = 0; i < order.size(); ++i )
+            {
+                if ( i + 1 < order.size() && key( order[i] ) == key( order[i + 1] ) )
+                    continue;   // A later duplicate wins
+                unique.push_back( _entries[order[i]] );
+            }
+            _entries = std::move( unique );
+        }
+
+    private:
+        std::string _text;
+        std::vector< detail::slot > _entries;
+    };
+
+}   // namespace sl::config
+
+
+#endif /* __SNAPSHOT_H_1B494DD4F4B44BB4AE330985AD88409F__ */
@@ -0,0 +1,56 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023-present Robert Anderson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+
+#ifndef __VALUES_H_6CF9466A77134B5B9E9A2CDD74F24684__
+#define __VALUES_H_6CF9466A77134B5B9E9A2CDD74F24684__
+
+#include <string>
+#include <utility>
+
+namespace sl::config
+{
+
+    template< typename ConfigData >
+    struct values
+    {
+        explicit values( ConfigData&& data )
+            : _data { std::move( data ) }
+        {}
+
+        template< typename T >
+        inline T get( const std::string& key ) const
+        {
+            return _data.template get< T >( key );
+        }
+
+    private:
+        ConfigData _data;
+    };
+
+}   // namespace sl::config
+
+
+#endif /* __VALUES_H_6CF9466A77134B5B9E9A2CDD74F24684__ */
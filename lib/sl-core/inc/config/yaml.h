@@ -0,0 +1,1023 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023-present Robert Anderson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+
+#ifndef __YAML_H_A3546388EA884A56BAF79C2380A486E9__
+#define __YAML_H_A3546388EA884A56BAF79C2380A486E9__
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include <io/mapped-file.h>
+
+#include "./snapshot.h"
+#include "./values.h"
+
+namespace sl::config
+{
+
+    namespace detail
+    {
+
+        /**
+         * Single pass parser for the YAML subset config files use, emitting flattened
+         * "/a/b/0" keys to the same sinks as flat_json_sax. Supported: block mappings and
+         * sequences (including compact "- key: value" items and sequences directly under a
+         * key), flow collections, plain / single / double quoted scalars, multi-line plain
+         * scalars, literal and folded block scalars, comments and a single document with
+         * optional "---" / "..." markers. Plain scalars are typed by the YAML 1.2 core schema.
+         * Anchors, aliases, tags and complex keys are rejected.
+         *
+         * Scalars are handed to the sink as views of the input; only escaped, folded or
+         * block scalars go through a scratch buffer.
+         */
+        template< typename Sink >
+        class flat_yaml_parser
+        {
+        public:
+            flat_yaml_parser( std::string_view text, Sink& sink )
+                : _p { text.data() }
+                , _end { text.data() + text.size() }
+                , _line_start { _p }
+                , _sink { sink }
+            {}
+
+            void parse()
+            {
+                if ( _end - _p >= 3 && std::memcmp( _p, "\xEF\xBB\xBF", 3 ) == 0 )
+                    _line_start = _p += 3;
+
+                skip_space();
+                while ( _p < _end && *_p == '%' && column() == 0 )
+                {
+                    skip_to_eol();
+                    skip_space();
+                }
+
+                if ( at_marker( "---" ) )
+                {
+                    _p += 3;
+                    skip_space();
+                }
+
+                if ( at_document_end() )
+                    _sink.add_null( _path );   // An empty document is a null root
+                else
+                    parse_block( -1 );
+
+                skip_space();
+                if ( at_marker( "..." ) )
+                {
+                    _p += 3;
+                    skip_space();
+                }
+
+                if ( at_marker( "---" ) )
+                    fail( "multiple documents are not supported" );
+                if ( _p < _end )
+                    fail( "unexpected content" );
+            }
+
+        private:
+            /**
+             * Block context
+             **/
+
+            void parse_block( int parent )
+            {
+                switch ( peek() )
+                {
+                case '-':
+                    if ( is_break_or_space( _p + 1 ) )
+                        return parse_sequence( column() );
+                    break;
+                case '[':
+                case '{':
+                    parse_flow();
+                    return end_of_line();
+                case '|':
+                case '>':
+                    return parse_block_scalar( parent );
+                case '?':
+                    if ( is_break_or_space( _p + 1 ) )
+                        fail( "complex keys are not supported" );
+                    break;
+                }
+
+                if ( is_mapping_key() )
+                    return parse_mapping( column() );
+
+                parse_inline( parent );
+            }
+
+            void parse_mapping( int col )
+            {
+                for ( ;; )
+                {
+                    const auto saved = _path.size();
+                    if ( peek() == '?' && is_break_or_space( _p + 1 ) )
+                        fail( "complex keys are not supported" );
+                    append_key( scalar_until_colon() );
+                    ++_p;   // ':'
+                    parse_value( col );
+                    _path.resize( saved );
+
+                    skip_space();
+                    if ( at_document_end() || column() < col )
+                        return;
+                    if ( column() > col )
+                        fail( "unexpected indentation" );
+                    if ( !is_mapping_key() )
+                        fail( "expected a mapping key" );
+                }
+            }
+
+            void parse_sequence( int col )
+            {
+                for ( size_t index = 0;; ++index )
+                {
+                    const auto saved = _path.size();
+                    append_index( index );
+
+                    ++_p;   // '-'
+                    skip_blanks();
+                    if ( at_eol() )
+                    {
+                        skip_space();
+                        if ( !at_document_end() && column() > col )
+                            parse_block( col );
+                        else
+                            _sink.add_null( _path );
+                    }
+                    else
+                    {
+                        parse_block( col );   // Content on the dash line nests at its column
+                    }
+                    _path.resize( saved );
+
+                    skip_space();
+                    if ( at_document_end() || column() < col )
+                        return;
+                    if ( column() > col )
+                        fail( "unexpected indentation" );
+                    if ( !( peek() == '-' && is_break_or_space( _p + 1 ) ) )
+                        return;   // A sequence written directly under a key ends here
+                }
+            }
+
+            /**
+             * The value after a mapping key's ':'.
+             */
+            void parse_value( int col )
+            {
+                skip_blanks();
+                if ( !at_eol() )
+                    return parse_block_value( col );
+
+                skip_space();
+                if ( !at_document_end() )
+                {
+                    if ( column() > col )
+                        return parse_block( col );
+                    if ( column() == col && peek() == '-' && is_break_or_space( _p + 1 ) )
+                        return parse_sequence( col );
+                }
+                _sink.add_null( _path );
+            }
+
+            void parse_block_value( int col )
+            {
+                switch ( peek() )
+                {
+                case '[':
+                case '{':
+                    parse_flow();
+                    return end_of_line();
+                case '|':
+                case '>':
+                    return parse_block_scalar( col );
+                }
+                parse_inline( col );
+            }
+
+            /**
+             * A scalar on the current line. Plain scalars continue onto following lines
+             * indented past 'parent' (folded with spaces, blank lines kept as newlines).
+             */
+            void parse_inline( int parent )
+            {
+                check_indicator();
+
+                if ( peek() == '"' || peek() == '\'' )
+                {
+                    auto v = quoted();
+                    end_of_line();
+                    return _sink.add_string( _path, v );
+                }
+
+                auto first = plain_block_line();
+                const char* rewind_p     = _p;
+                const char* rewind_start = _line_start;
+                size_t rewind_line       = _line;
+
+                bool folded = false;
+                for ( ;; )
+                {
+                    size_t breaks = skip_space();
+                    if ( at_document_end() || column() <= parent || breaks == 0 )
+                        break;
+
+                    if ( is_mapping_key() )
+                        fail( "mapping key inside a multi-line scalar" );
+
+                    if ( !folded )
+                    {
+                        _scratch.assign( first );
+                        folded = true;
+                    }
+
+                    if ( breaks == 1 )
+                        _scratch += ' ';
+                    else
+                        _scratch.append( breaks - 1, '\n' );
+                    _scratch += plain_block_line();
+
+                    rewind_p     = _p;
+                    rewind_start = _line_start;
+                    rewind_line  = _line;
+                }
+
+                // Leave the cursor after the scalar for the caller's own skip_space
+                _p          = rewind_p;
+                _line_start = rewind_start;
+                _line       = rewind_line;
+
+                if ( folded )
+                    _sink.add_string( _path, _scratch );
+                else
+                    emit_plain( first );
+            }
+
+            void parse_block_scalar( int parent )
+            {
+                const bool literal = *_p++ == '|';
+                char chomp         = 'c';
+                int indent         = 0;
+                for ( int i = 0; i < 2; ++i )
+                {
+                    if ( peek() == '-' || peek() == '+' )
+                        chomp = *_p++;
+                    else if ( peek() >= '1' && peek() <= '9' )
+                        indent = std::max( parent, 0 ) + ( *_p++ - '0' );
+                }
+                end_of_line();
+
+                _scratch.clear();
+                size_t breaks  = 0;
+                bool content   = false;
+                bool last_more = false;
+                while ( _p < _end )
+                {
+                    next_line();
+
+                    const char* s = _p;
+                    while ( s < _end && *s == ' ' )
+                        ++s;
+                    const auto spaces = static_cast< int >( s - _line_start );
+                    const bool blank  = s >= _end || *s == '\n' || *s == '\r';
+
+                    if ( blank && ( indent == 0 || spaces <= indent ) )
+                    {
+                        ++breaks;
+                        _p = s;
+                        skip_to_eol();
+                        continue;
+                    }
+
+                    if ( indent == 0 )
+                    {
+                        if ( spaces <= parent )
+                            break;
+                        indent = spaces;
+                    }
+                    if ( spaces < indent )
+                        break;
+
+                    _p = _line_start + indent;
+                    const char* begin = _p;
+                    skip_to_eol();
+                    auto line = std::string_view { begin, static_cast< size_t >( _p - begin ) };
+                    if ( !line.empty() && line.back() == '\r' )
+                        line.remove_suffix( 1 );
+
+                    const bool more = !line.empty() && ( line[0] == ' ' || line[0] == '\t' );
+                    if ( !content )
+                        _scratch.append( breaks, '\n' );
+                    else if ( literal || more || last_more )
+                        _scratch.append( breaks + 1, '\n' );
+                    else if ( breaks == 0 )
+                        _scratch += ' ';
+                    else
+                        _scratch.append( breaks, '\n' );
+
+                    _scratch += line;
+                    content   = true;
+                    last_more = more;
+                    breaks    = 0;
+                }
+
+                // Back to the start of the line that ended the scalar
+                if ( _p > _line_start )
+                    _p = _line_start;
+
+                if ( content && chomp != '-' )
+                    _scratch.append( chomp == '+' ? breaks + 1 : 1, '\n' );
+                _sink.add_string( _path, _scratch );
+            }
+
+            /**
+             * Flow context
+             **/
+
+            void parse_flow()
+            {
+                skip_flow_space();
+                const char c = peek();
+                if ( c == '[' || c == '{' )
+                {
+                    ++_p;
+                    const char close = c == '[' ? ']' : '}';
+
+                    skip_flow_space();
+                    if ( peek() == close )
+                    {
+                        ++_p;
+                        return _sink.add_null( _path );   // Empty, as flatten() does
+                    }
+
+                    for ( size_t index = 0;; ++index )
+                    {
+                        const auto saved = _path.size();
+                        if ( c == '[' )
+                        {
+                            append_index( index );
+                            parse_flow();
+                        }
+                        else
+                        {
+                            parse_flow_entry();
+                        }
+                        _path.resize( saved );
+
+                        skip_flow_space();
+                        if ( peek() == ',' )
+                        {
+                            ++_p;
+                            skip_flow_space();
+                            if ( peek() != close )
+                                continue;
+                        }
+                        if ( peek() != close )
+                            fail( c == '[' ? "expected ',' or ']'" : "expected ',' or '}'" );
+                        ++_p;
+                        return;
+                    }
+                }
+
+                check_indicator();
+                if ( c == '"' || c == '\'' )
+                    return _sink.add_string( _path, quoted() );
+                emit_plain( plain_flow() );
+            }
+
+            void parse_flow_entry()
+            {
+                check_indicator();
+                auto k = ( peek() == '"' || peek() == '\'' ) ? quoted() : plain_flow();
+                append_key( k );
+
+                skip_flow_space();
+                if ( peek() != ':' )
+                {
+                    if ( peek() == ',' || peek() == '}' )
+                        return _sink.add_null( _path );
+                    fail( "expected ':'" );
+                }
+                ++_p;
+                skip_flow_space();
+                if ( peek() == ',' || peek() == '}' )
+                    return _sink.add_null( _path );
+                parse_flow();
+            }
+
+            /**
+             * Scalars
+             **/
+
+            /**
+             * Plain scalar up to a comment or the end of the line.
+             */
+            std::string_view plain_block_line()
+            {
+                const char* begin = _p;
+                while ( _p < _end && *_p != '\n' && !at_comment() )
+                    ++_p;
+                return trim( begin, _p );
+            }
+
+            std::string_view plain_flow()
+            {
+                const char* begin = _p;
+                while ( _p < _end )
+                {
+                    const char c = *_p;
+                    if ( c == '\n' || c == ',' || c == '[' || c == ']' || c == '{' || c == '}'
+                         || at_comment() )
+                        break;
+                    if ( c == ':'
+                         && ( is_break_or_space( _p + 1 ) || _p[1] == ',' || _p[1] == ']'
+                              || _p[1] == '}' ) )
+                        break;
+                    ++_p;
+                }
+                return trim( begin, _p );
+            }
+
+            /**
+             * A block mapping key, leaving the cursor on its ':'.
+             */
+            std::string_view scalar_until_colon()
+            {
+                std::string_view k;
+                if ( peek() == '"' || peek() == '\'' )
+                {
+                    k = quoted();
+                    skip_blanks();
+                }
+                else
+                {
+                    check_indicator();
+                    const char* begin = _p;
+                    while ( !( *_p == ':' && is_break_or_space( _p + 1 ) ) )
+                        ++_p;   // is_mapping_key() found the ':'
+                    k = trim( begin, _p );
+                }
+
+                if ( peek() != ':' )
+                    fail( "expected ':'" );
+                return k;
+            }
+
+            std::string_view quoted()
+            {
+                const char q      = *_p++;
+                const char* begin = _p;
+                bool simple       = true;
+
+                // Fast path: no escapes or line breaks, so the scalar is a view of the input
+                for ( const char* s = _p; s < _end; ++s )
+                {
+                    if ( *s == '\n' || ( q == '"' && *s == '\\' ) )
+                    {
+                        simple = false;
+                        break;
+                    }
+                    if ( *s == q )
+                    {
+                        if ( q == '\'' && s + 1 < _end && s[1] == '\'' )
+                        {
+                            simple = false;
+                            break;
+                        }
+                        _p = s + 1;
+                        return { begin, static_cast< size_t >( s - begin ) };
+                    }
+                }
+
+                if ( simple )
+                    fail( "unterminated quoted scalar" );
+
+                _scratch.clear();
+                for ( ;; )
+                {
+                    if ( _p >= _end )
+                        fail( "unterminated quoted scalar" );
+
+                    const char c = *_p;
+                    if ( c == q )
+                    {
+                        if ( q == '\'' && _p + 1 < _end && _p[1] == '\'' )
+                        {
+                            _scratch += '\'';
+                            _p += 2;
+                            continue;
+                        }
+                        ++_p;
+                        return _scratch;
+                    }
+
+                    if ( c == '\n' || c == '\r' )
+                    {
+                        fold_quoted_break();
+                        continue;
+                    }
+
+                    if ( q == '"' && c == '\\' )
+                    {
+                        ++_p;
+                        escape();
+                        continue;
+                    }
+
+                    _scratch += c;
+                    ++_p;
+                }
+            }
+
+            void fold_quoted_break()
+            {
+                while ( !_scratch.empty() && ( _scratch.back() == ' ' || _scratch.back() == '\t' ) )
+                    _scratch.pop_back();
+
+                size_t breaks = 0;
+                while ( _p < _end && ( *_p == '\n' || *_p == '\r' || *_p == ' ' || *_p == '\t' ) )
+                {
+                    if ( *_p == '\n' )
+                    {
+                        ++breaks;
+                        next_line();
+                    }
+                    else
+                    {
+                        ++_p;
+                    }
+                }
+
+                if ( breaks == 1 )
+                    _scratch += ' ';
+                else
+                    _scratch.append( breaks - 1, '\n' );
+            }
+
+            void escape()
+            {
+                if ( _p >= _end )
+                    fail( "unterminated escape sequence" );
+
+                const char c = *_p++;
+                switch ( c )
+                {
+                case '0': _scratch += '\0'; return;
+                case 'a': _scratch += '\a'; return;
+                case 'b': _scratch += '\b'; return;
+                case 't':
+                case '\t': _scratch += '\t'; return;
+                case 'n': _scratch += '\n'; return;
+                case 'v': _scratch += '\v'; return;
+                case 'f': _scratch += '\f'; return;
+                case 'r': _scratch += '\r'; return;
+                case 'e': _scratch += '\x1B'; return;
+                case ' ':
+                case '"':
+                case '/':
+                case '\\': _scratch += c; return;
+                case 'N': return utf8( 0x85 );
+                case '_': return utf8( 0xA0 );
+                case 'L': return utf8( 0x2028 );
+                case 'P': return utf8( 0x2029 );
+                case 'x': return utf8( hex( 2 ) );
+                case 'u': return utf8( hex( 4 ) );
+                case 'U': return utf8( hex( 8 ) );
+                case '\r':
+                case '\n':
+                    // Escaped line break: joins the lines without a space
+                    --_p;
+                    fold_quoted_break();
+                    if ( !_scratch.empty() && _scratch.back() == ' ' )
+                        _scratch.pop_back();
+                    return;
+                }
+                --_p;
+                fail( "invalid escape sequence" );
+            }
+
+            uint32_t hex( int digits )
+            {
+                uint32_t cp = 0;
+                if ( _end - _p < digits
+                     || std::from_chars( _p, _p + digits, cp, 16 ).ptr != _p + digits )
+                    fail( "invalid escape sequence" );
+                _p += digits;
+                return cp;
+            }
+
+            void utf8( uint32_t cp )
+            {
+                if ( cp < 0x80 )
+                {
+                    _scratch += static_cast< char >( cp );
+                }
+                else if ( cp < 0x800 )
+                {
+                    _scratch += static_cast< char >( 0xC0 | ( cp >> 6 ) );
+                    _scratch += static_cast< char >( 0x80 | ( cp & 0x3F ) );
+                }
+                else if ( cp < 0x10000 )
+                {
+                    _scratch += static_cast< char >( 0xE0 | ( cp >> 12 ) );
+                    _scratch += static_cast< char >( 0x80 | ( ( cp >> 6 ) & 0x3F ) );
+                    _scratch += static_cast< char >( 0x80 | ( cp & 0x3F ) );
+                }
+                else if ( cp < 0x110000 )
+                {
+                    _scratch += static_cast< char >( 0xF0 | ( cp >> 18 ) );
+                    _scratch += static_cast< char >( 0x80 | ( ( cp >> 12 ) & 0x3F ) );
+                    _scratch += static_cast< char >( 0x80 | ( ( cp >> 6 ) & 0x3F ) );
+                    _scratch += static_cast< char >( 0x80 | ( cp & 0x3F ) );
+                }
+                else
+                {
+                    fail( "invalid escape sequence" );
+                }
+            }
+
+            /**
+             * Types a plain scalar by the YAML 1.2 core schema.
+             */
+            void emit_plain( std::string_view v )
+            {
+                if ( v.empty() || v == "~" || v == "null" || v == "Null" || v == "NULL" )
+                    return _sink.add_null( _path );
+                if ( v == "true" || v == "True" || v == "TRUE" )
+                    return _sink.add_bool( _path, true );
+                if ( v == "false" || v == "False" || v == "FALSE" )
+                    return _sink.add_bool( _path, false );
+                if ( emit_integer( v ) || emit_float( v ) )
+                    return;
+                _sink.add_string( _path, v );
+            }
+
+            bool emit_integer( std::string_view v )
+            {
+                int base = 10;
+                bool neg = false;
+                if ( v.starts_with( "0x" ) || v.starts_with( "0o" ) )
+                {
+                    base = v[1] == 'x' ? 16 : 8;
+                    v.remove_prefix( 2 );
+                }
+                else if ( v[0] == '-' || v[0] == '+' )
+                {
+                    neg = v[0] == '-';
+                    v.remove_prefix( 1 );
+                }
+
+                uint64_t u = 0;
+                if ( v.empty() || v[0] == '+' || v[0] == '-' )
+                    return false;
+                auto [end, ec] = std::from_chars( v.data(), v.data() + v.size(), u, base );
+                if ( ec != std::errc {} || end != v.data() + v.size() )
+                    return false;
+
+                // Non-negative numbers are unsigned, as nlohmann parses them from JSON
+                if ( !neg )
+                    _sink.add_uint( _path, u );
+                else if ( u <= static_cast< uint64_t >( INT64_MAX ) + 1 )
+                    _sink.add_int( _path, static_cast< int64_t >( 0 - u ) );
+                else
+                    return false;
+                return true;
+            }
+
+            bool emit_float( std::string_view v )
+            {
+                constexpr auto inf = std::numeric_limits< double >::infinity();
+
+                double sign = 1.0;
+                if ( v[0] == '-' || v[0] == '+' )
+                {
+                    sign = v[0] == '-' ? -1.0 : 1.0;
+                    v.remove_prefix( 1 );
+                }
+
+                if ( v == ".inf" || v == ".Inf" || v == ".INF" )
+                    return _sink.add_double( _path, sign * inf ), true;
+                if ( sign > 0 && ( v == ".nan" || v == ".NaN" || v == ".NAN" ) )
+                    return _sink.add_double( _path, std::numeric_limits< double >::quiet_NaN() ),
+                           true;
+
+                // [0-9]* ( . [0-9]* )? ( [eE] [-+]? [0-9]+ )? with at least one mantissa digit
+                size_t i = 0, digits = 0;
+                for ( ; i < v.size() && v[i] >= '0' && v[i] <= '9'; ++i )
+                    ++digits;
+                if ( i < v.size() && v[i] == '.' )
+                {
+                    for ( ++i; i < v.size() && v[i] >= '0' && v[i] <= '9'; ++i )
+                        ++digits;
+                }
+                if ( digits == 0 )
+                    return false;
+                if ( i < v.size() && ( v[i] == 'e' || v[i] == 'E' ) )
+                {
+                    if ( ++i < v.size() && ( v[i] == '-' || v[i] == '+' ) )
+                        ++i;
+                    const auto exp = i;
+                    while ( i < v.size() && v[i] >= '0' && v[i] <= '9' )
+                        ++i;
+                    if ( i == exp )
+                        return false;
+                }
+                if ( i != v.size() )
+                    return false;
+
+                double d = 0;
+                auto [end, ec] = std::from_chars( v.data(), v.data() + v.size(), d );
+                if ( ec != std::errc {} || end != v.data() + v.size() )
+                    return false;
+
+                _sink.add_double( _path, sign * d );
+                return true;
+            }
+
+            /**
+             * Cursor helpers
+             **/
+
+            char peek() const noexcept { return _p < _end ? *_p : '\0'; }
+            int column() const noexcept { return static_cast< int >( _p - _line_start ); }
+
+            bool is_break_or_space( const char* s ) const noexcept
+            {
+                return s >= _end || *s == ' ' || *s == '\n' || *s == '\t' || *s == '\r';
+            }
+
+            bool at_comment() const noexcept
+            {
+                return *_p == '#' && ( _p == _line_start || _p[-1] == ' ' || _p[-1] == '\t' );
+            }
+
+            bool at_eol() const noexcept
+            {
+                return _p >= _end || *_p == '\n' || *_p == '\r' || at_comment();
+            }
+
+            bool at_marker( const char* marker ) const noexcept
+            {
+                return column() == 0 && _end - _p >= 3 && std::memcmp( _p, marker, 3 ) == 0
+                       && is_break_or_space( _p + 3 );
+            }
+
+            bool at_document_end() const noexcept
+            {
+                return _p >= _end || at_marker( "..." ) || at_marker( "---" );
+            }
+
+            /**
+             * True if the current line is "key: ..." (the ':' followed by a space or the
+             * end of the line, outside quotes and before any comment).
+             */
+            bool is_mapping_key() const
+            {
+                const char* s = _p;
+                if ( s < _end && ( *s == '"' || *s == '\'' ) )
+                {
+                    const char q = *s++;
+                    for ( ; s < _end && *s != '\n'; ++s )
+                    {
+                        if ( q == '"' && *s == '\\' )
+                            ++s;
+                        else if ( *s == q && q == '\'' && s + 1 < _end && s[1] == '\'' )
+                            ++s;
+                        else if ( *s == q )
+                            break;
+                    }
+                    if ( s >= _end || *s != q )
+                        return false;
+                    for ( ++s; s < _end && ( *s == ' ' || *s == '\t' ); ++s )
+                        ;
+                    return s < _end && *s == ':' && is_break_or_space( s + 1 );
+                }
+
+                for ( ; s < _end && *s != '\n'; ++s )
+                {
+                    if ( *s == ':' && is_break_or_space( s + 1 ) )
+                        return true;
+                    if ( *s == '#' && s > _p && ( s[-1] == ' ' || s[-1] == '\t' ) )
+                        return false;
+                }
+                return false;
+            }
+
+            void check_indicator() const
+            {
+                switch ( peek() )
+                {
+                case '&':
+                case '*':
+                    fail( "anchors and aliases are not supported" );
+                case '!':
+                    fail( "tags are not supported" );
+                case '@':
+                case '`':
+                    fail( "reserved indicator" );
+                }
+            }
+
+            void next_line() noexcept
+            {
+                ++_p;   // '\n'
+                ++_line;
+                _line_start = _p;
+            }
+
+            void skip_to_eol() noexcept
+            {
+                while ( _p < _end && *_p != '\n' )
+                    ++_p;
+            }
+
+            void skip_blanks() noexcept
+            {
+                while ( _p < _end && ( *_p == ' ' || *_p == '\t' ) )
+                    ++_p;
+            }
+
+            /**
+             * Skips whitespace, comments and line breaks up to the next content, returning
+             * how many line breaks were crossed.
+             */
+            size_t skip_space()
+            {
+                size_t breaks = 0;
+                for ( ;; )
+                {
+                    while ( _p < _end && ( *_p == ' ' || *_p == '\t' || *_p == '\r' ) )
+                        ++_p;
+                    if ( _p < _end && at_comment() )
+                        skip_to_eol();
+                    if ( _p < _end && *_p == '\n' )
+                    {
+                        next_line();
+                        ++breaks;
+                        continue;
+                    }
+                    break;
+                }
+
+                const auto indent = static_cast< size_t >( _p - _line_start );
+                if ( breaks > 0 && _p < _end && std::memchr( _line_start, '\t', indent ) )
+                    fail( "tabs are not allowed in indentation" );
+                return breaks;
+            }
+
+            void skip_flow_space()
+            {
+                while ( _p < _end )
+                {
+                    if ( *_p == ' ' || *_p == '\t' || *_p == '\r' )
+                        ++_p;
+                    else if ( *_p == '\n' )
+                        next_line();
+                    else if ( at_comment() )
+                        skip_to_eol();
+                    else
+                        break;
+                }
+                if ( _p >= _end )
+                    fail( "unterminated flow collection" );
+            }
+
+            void end_of_line()
+            {
+                skip_blanks();
+                if ( _p < _end && *_p == '\r' )
+                    ++_p;
+                if ( _p < _end && at_comment() )
+                    skip_to_eol();
+                if ( _p < _end && *_p != '\n' )
+                    fail( "unexpected characters after value" );
+            }
+
+            static std::string_view trim( const char* begin, const char* end ) noexcept
+            {
+                while ( end > begin && ( end[-1] == ' ' || end[-1] == '\t' || end[-1] == '\r' ) )
+                    --end;
+                return { begin, static_cast< size_t >( end - begin ) };
+            }
+
+            void append_key( std::string_view k )
+            {
+                _path += '/';
+                for ( char c : k )
+                {
+                    if ( c == '~' )
+                        _path += "~0";
+                    else if ( c == '/' )
+                        _path += "~1";
+                    else
+                        _path += c;
+                }
+            }
+
+            void append_index( size_t index )
+            {
+                char digits[24];
+                auto end = std::to_chars( digits, std::end( digits ), index ).ptr;
+                _path += '/';
+                _path.append( digits, end );
+            }
+
+            [[noreturn]] void fail( const char* what ) const
+            {
+                char msg[160];
+                std::snprintf( msg,
+                               sizeof( msg ),
+                               "yaml parse error at line %zu, column %d: %s",
+                               _line,
+                               column() + 1,
+                               what );
+                throw std::runtime_error( msg );
+            }
+
+        private:
+            const char* _p;
+            const char* _end;
+            const char* _line_start;
+            size_t _line = 1;
+
+            Sink& _sink;
+            std::string _path;
+            std::string _scratch;
+        };
+
+        template< typename Sink >
+        void parse_flat_yaml( const std::string_view data, Sink& sink )
+        {
+            flat_yaml_parser< Sink > { data, sink }.parse();
+        }
+
+    }   // namespace detail
+
+
+    /**
+     * Compiles a YAML document into a snapshot keyed like config::json ("/a/b/0").
+     */
+    inline snapshot compile_yaml( const std::string_view data )
+    {
+        snapshot_builder builder;
+        detail::parse_flat_yaml( data, builder );
+        return std::move( builder ).build();
+    }
+
+    inline snapshot compile_yaml_file( const char* const path )
+    {
+        auto mf   = io::mapped_file( path, io::cache_hint::sequential );
+        auto mv   = mf.map_view( 0, mf.size() );
+        auto data = mv.as_items< char >();
+
+        return compile_yaml( std::string_view { data.data(), data.size() } );
+    }
+
+    inline auto yaml_from_string( const std::string_view data )
+    {
+        return config::values { compile_yaml( data ) };
+    }
+
+    inline auto load_yaml( const char* const path )
+    {
+        return config::values { compile_yaml_file( path ) };
+    }
+
+}   // namespace sl::config
+
+
+#endif /* __YAML_H_A3546388EA884A56BAF79C2380A486E9__ */
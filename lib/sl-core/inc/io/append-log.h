@@ -0,0 +1,354 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023-present Robert Anderson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef __APPEND_LOG_H_8B88E5A1D5E04F45B45C5DBEAAFE3A00__
+#define __APPEND_LOG_H_8B88E5A1D5E04F45B45C5DBEAAFE3A00__
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <utils/crc32c.h>
+#include <utils/noncopyable.h>
+
+#include "mapped-file.h"
+
+namespace sl::io
+{
+
+    enum class log_sync
+    {
+        none,     // Leave write back to the kernel (or explicit 'sync' calls)
+        group,    // Sync once 'group_bytes' of appends are pending
+        always,   // Sync every append before it returns
+    };
+
+    struct append_log_options
+    {
+        size_t segment_size { 64 * 1024 * 1024 };   // Preallocated size of each segment
+        log_sync sync { log_sync::group };
+        size_t group_bytes { 1024 * 1024 };
+    };
+
+    struct log_position
+    {
+        uint64_t segment;
+        size_t offset;
+    };
+
+
+    /**
+     * Durable, append-only journal of opaque records in a directory of memory-mapped
+     * segment files ('<name>-<sequence>.log'). Segments are preallocated (and that size
+     * made durable) up front, so appends are plain stores into the mapping and a sync is
+     * a single msync of the dirty range; no file metadata changes on the write path.
+     *
+     * Records are framed as [length:u32][crc32c:u32][payload], 8-byte aligned, with the
+     * checksum covering the length and payload. Zeroed space ends a segment. A record that
+     * does not fit in the current segment rolls over to a new one.
+     *
+     * Opening an existing log recovers it: the newest segment is scanned up to the last
+     * record with a valid checksum, and anything after it (a torn write) is discarded.
+     */
+    struct append_log : sl::utils::noncopyable
+    {
+    public:
+        static constexpr size_t k_segment_header = 16;
+        static constexpr size_t k_record_header  = 8;
+        static constexpr uint64_t k_magic        = 0x31304754534C4C53ull;   // "SLLSTG01"
+
+        append_log( std::filesystem::path directory,
+                    std::string name,
+                    append_log_options options = {} )
+            : _directory { std::move( directory ) }
+            , _name { std::move( name ) }
+            , _options { options }
+        {
+            const auto page       = mapped_view::page_size();
+            _options.segment_size = std::max( _options.segment_size, page );
+            _options.segment_size = ( _options.segment_size + page - 1 ) & ~( page - 1 );
+
+            std::filesystem::create_directories( _directory );
+
+            auto existing = segments();
+            open_segment( existing.empty() ? 1 : existing.back().first );
+        }
+
+        ~append_log() noexcept
+        {
+            try
+            {
+                sync();
+            }
+            catch ( ... )
+            {}
+        }
+
+        uint64_t segment() const { return _segment; }
+        size_t offset() const { return _offset; }
+        size_t pending() const { return _offset - _synced; }
+
+        /**
+         * Largest payload a single record can carry with the configured segment size.
+         */
+        size_t max_record_size() const
+        {
+            return _options.segment_size - k_segment_header - k_record_header;
+        }
+
+        /**
+         * Appends one record and returns where it starts. Durable once synced, which
+         * depends on the sync policy or an explicit 'sync'.
+         */
+        log_position append( std::span< const std::byte > payload )
+        {
+            io::error::throw_if( payload.size() > max_record_size(),
+                                 "size-check",
+                                 -1,
+                                 "record exceeds the segment size" );
+
+            const auto need = aligned( k_record_header + payload.size() );
+            if ( _offset + need > _capacity )
+                roll();
+
+            auto base = static_cast< std::byte* >( _view->data() ) + _offset;
+            auto len  = static_cast< uint32_t >( payload.size() );
+            auto crc  = utils::crc32c( payload, utils::crc32c( &len, sizeof( len ) ) );
+
+            std::memcpy( base + k_record_header, payload.data(), payload.size() );
+            std::memset( base + k_record_header + payload.size(),
+                         0,
+                         need - k_record_header - payload.size() );
+            std::memcpy( base + 4, &crc, sizeof( crc ) );
+            std::memcpy( base, &len, sizeof( len ) );
+
+            auto position = log_position { _segment, _offset };
+            _offset += need;
+
+            if ( _options.sync == log_sync::always
+                 || ( _options.sync == log_sync::group && pending() >= _options.group_bytes ) )
+                sync();
+
+            return position;
+        }
+
+        log_position append( const void* data, size_t size )
+        {
+            return append( { static_cast< const std::byte* >( data ), size } );
+        }
+
+        /**
+         * Writes every record appended since the last sync to the device (msync MS_SYNC of
+         * just that range). Appends made by other threads need external synchronization.
+         */
+        void sync()
+        {
+            if ( !_view || _offset == _synced )
+                return;
+
+            _view->sync( sync_mode::sync, _synced, _offset - _synced );
+            _synced = _offset;
+        }
+
+        /**
+         * Calls 'fn( std::span< const std::byte > payload )' for every valid record of every
+         * segment, oldest first. Returns the number of records visited.
+         */
+        template< typename Fn >
+        size_t replay( Fn&& fn ) const
+        {
+            size_t count = 0;
+            for ( const auto& [seq, path] : segments() )
+            {
+                mapped_file mf( path.c_str(), cache_hint::sequential );
+                if ( mf.size() < k_segment_header )
+                    continue;
+
+                auto mv   = mf.map_view( 0, mf.size() );
+                auto base = static_cast< const std::byte* >( mv.data() );
+                if ( !valid_header( base, seq ) )
+                    continue;
+
+                scan( base, mf.size(), [&]( std::span< const std::byte > payload ) {
+                    fn( payload );
+                    ++count;
+                } );
+            }
+
+            return count;
+        }
+
+        /**
+         * Segment files of this log, ordered by sequence number.
+         */
+        std::vector< std::pair< uint64_t, std::filesystem::path > > segments() const
+        {
+            std::vector< std::pair< uint64_t, std::filesystem::path > > found;
+
+            const auto prefix = _name + "-";
+            for ( const auto& entry : std::filesystem::directory_iterator( _directory ) )
+            {
+                auto file = entry.path().filename().string();
+                if ( file.size() != prefix.size() + 20 + 4 || !file.starts_with( prefix )
+                     || !file.ends_with( ".log" ) )
+                    continue;
+
+                auto digits = file.substr( prefix.size(), 20 );
+                if ( !std::all_of( digits.begin(), digits.end(), []( char c ) {
+                         return c >= '0' && c <= '9';
+                     } ) )
+                    continue;
+
+                found.emplace_back( std::stoull( digits ), entry.path() );
+            }
+
+            std::sort( found.begin(), found.end() );
+            return found;
+        }
+
+    private:
+        static size_t aligned( size_t size ) { return ( size + 7 ) & ~size_t( 7 ); }
+
+        static bool valid_header( const std::byte* base, uint64_t seq )
+        {
+            uint64_t header[2];
+            std::memcpy( header, base, sizeof( header ) );
+            return header[0] == k_magic && header[1] == seq;
+        }
+
+        /**
+         * Visits the valid records after the segment header; returns the offset just past
+         * the last one (where the next append goes).
+         */
+        template< typename Fn >
+        static size_t scan( const std::byte* base, size_t capacity, Fn&& fn )
+        {
+            size_t off = k_segment_header;
+            while ( off + k_record_header <= capacity )
+            {
+                uint32_t len, crc;
+                std::memcpy( &len, base + off, sizeof( len ) );
+                std::memcpy( &crc, base + off + 4, sizeof( crc ) );
+
+                if ( len > capacity - off - k_record_header )
+                    break;
+
+                auto payload = std::span( base + off + k_record_header, len );
+                if ( utils::crc32c( payload, utils::crc32c( &len, sizeof( len ) ) ) != crc )
+                    break;   // Zeroed space (the end) or a torn / corrupt record
+
+                fn( payload );
+                off += aligned( k_record_header + len );
+            }
+
+            return std::min( off, capacity );
+        }
+
+        std::filesystem::path segment_path( uint64_t seq ) const
+        {
+            char suffix[32];
+            std::snprintf( suffix,
+                           sizeof( suffix ),
+                           "-%020llu.log",
+                           static_cast< unsigned long long >( seq ) );
+            return _directory / ( _name + suffix );
+        }
+
+        void roll()
+        {
+            sync();
+            open_segment( _segment + 1 );
+        }
+
+        void open_segment( uint64_t seq )
+        {
+            _view.reset();
+            _file.reset();
+
+            auto path = segment_path( seq );
+            _file.emplace( path.c_str(), access_mode::create );
+
+            // A missing or short file is new (or its creation was interrupted).
+            if ( _file->size() < _options.segment_size )
+                _file->preallocate( _options.segment_size );
+
+            _capacity = _file->size();
+            _view.emplace( _file->map_view( 0, _capacity ) );
+
+            auto base = static_cast< std::byte* >( _view->data() );
+            uint64_t header[2];
+            std::memcpy( header, base, sizeof( header ) );
+            if ( header[0] == 0 && header[1] == 0 )
+            {
+                header[0] = k_magic;
+                header[1] = seq;
+                std::memcpy( base, header, sizeof( header ) );
+                _view->sync( sync_mode::sync, 0, k_segment_header );
+                _file->sync();   // The preallocated size must survive a crash too
+            }
+            else
+            {
+                io::error::throw_if(
+                    !valid_header( base, seq ), "header-check", -1, "corrupt log segment header" );
+            }
+
+            _segment = seq;
+            _offset  = scan( base, _capacity, []( auto ) {} );
+            _synced  = _offset;
+
+            // Clear whatever a torn write left behind (possibly complete records past a lost
+            // page), so it can never be read back as records once appends resume.
+            auto rest  = std::span( base + _offset, _capacity - _offset );
+            auto dirty = []( std::byte b ) { return b != std::byte {}; };
+            if ( std::any_of( rest.begin(), rest.end(), dirty ) )
+            {
+                std::memset( rest.data(), 0, rest.size() );
+                _view->sync( sync_mode::sync, _offset, rest.size() );
+            }
+        }
+
+    private:
+        std::filesystem::path _directory;
+        std::string _name;
+        append_log_options _options;
+
+        std::optional< mapped_file > _file;
+        std::optional< mapped_view > _view;
+        uint64_t _segment { 0 };
+        size_t _capacity { 0 };
+        size_t _offset { 0 };
+        size_t _synced { 0 };
+    };
+
+}   // namespace sl::io
+
+#endif /* __APPEND_LOG_H_8B88E5A1D5E04F45B45C5DBEAAFE3A00__ */
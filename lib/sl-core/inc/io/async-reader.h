@@ -0,0 +1,634 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023-present Robert Anderson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef __ASYNC_READER_H_27217F62D19F4556A0E2262B648B8F0B__
+#define __ASYNC_READER_H_27217F62D19F4556A0E2262B648B8F0B__
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#if defined( __linux__ ) && __has_include( <linux/io_uring.h> )
+#    define SL_IO_URING_AVAILABLE 1
+#    include <linux/io_uring.h>
+#    include <sys/mman.h>
+#    include <sys/syscall.h>
+#elif defined( _WIN32 )
+#    error Async file reads not implememented for the target platform.
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <utils/noncopyable.h>
+
+#include "error.h"
+
+namespace sl::io
+{
+
+    /**
+     * Read-only file descriptor for 'async_reader'. Asking for direct I/O opens with
+     * O_DIRECT (bypassing the page cache) where the platform and file system allow it;
+     * 'direct()' tells whether that happened. Direct reads need buffers, offsets and
+     * lengths aligned to 'k_direct_alignment'.
+     */
+    struct file_handle : sl::utils::noncopyable
+    {
+    public:
+        static constexpr size_t k_direct_alignment = 4096;
+
+        file_handle() = default;
+
+        explicit file_handle( const char* name, bool direct = false )
+        {
+#if defined( O_DIRECT )
+            if ( direct )
+            {
+                _fd     = ::open( name, O_RDONLY | O_CLOEXEC | O_DIRECT );
+                _direct = _fd >= 0;
+            }
+#else
+            (void)direct;
+#endif
+
+            if ( _fd < 0 )
+                _fd = ::open( name, O_RDONLY | O_CLOEXEC );
+            io::error::throw_if( _fd == -1, "c-lib::open", errno, "failed to open file" );
+
+            struct stat si;
+            if ( ::fstat( _fd, &si ) < 0 )
+            {
+                auto err = errno;
+                ::close( _fd );
+                io::error::throw_if( true, "c-lib::fstat", err, "failed to get file size" );
+            }
+
+            _size = si.st_size;
+        }
+
+        file_handle( file_handle&& other ) noexcept { *this = std::move( other ); }
+
+        file_handle& operator=( file_handle&& other ) noexcept
+        {
+            std::swap( _fd, other._fd );
+            std::swap( _size, other._size );
+            std::swap( _direct, other._direct );
+            return *this;
+        }
+
+        ~file_handle() noexcept
+        {
+            if ( _fd >= 0 )
+                ::close( _fd );
+
+            _fd   = -1;
+            _size = 0;
+        }
+
+        int fd() const { return _fd; }
+        size_t size() const { return _size; }
+        bool direct() const { return _direct; }
+
+    private:
+        int _fd { -1 };
+        size_t _size { 0 };
+        bool _direct { false };
+    };
+
+
+    struct reader_options
+    {
+        unsigned queue_depth { 64 };   // Reads in flight at once
+        bool use_uring { true };       // false forces the pread fallback
+    };
+
+
+    /**
+     * Batched, asynchronous file reads. On Linux this drives an io_uring (raw syscalls, no
+     * liburing) with IORING_OP_READ / IORING_OP_READ_FIXED; where io_uring is missing or
+     * refused (old kernels, seccomp, io_uring_disabled) reads fall back to pread.
+     *
+     * Reads queued by 'read_at' are submitted in batches by 'poll' / 'wait', or by 'read_at'
+     * itself once a full queue depth is waiting; completions run on the calling thread from
+     * those same calls. Short reads are resubmitted until the buffer is full or the
+     * file ends, so a completion reports the bytes read (less than requested only at end
+     * of file) or a negative errno. The reader is not thread safe; use one per thread.
+     */
+    struct async_reader : sl::utils::noncopyable
+    {
+    public:
+        using completion = std::function< void( int64_t result ) >;
+
+        struct request
+        {
+            int fd;
+            size_t offset;
+            std::span< std::byte > buffer;
+            int64_t result { 0 };   // Set by 'read_many'
+        };
+
+        explicit async_reader( reader_options options = {} )
+            : _depth { std::max( options.queue_depth, 1u ) }
+        {
+#if defined( SL_IO_URING_AVAILABLE )
+            if ( options.use_uring )
+                _ring.setup( _depth );
+#endif
+        }
+
+        ~async_reader() noexcept
+        {
+            // The kernel may still be writing into caller buffers; let it finish.
+            try
+            {
+                wait();
+            }
+            catch ( ... )
+            {}
+        }
+
+        bool uses_uring() const
+        {
+#if defined( SL_IO_URING_AVAILABLE )
+            return _ring.active();
+#else
+            return false;
+#endif
+        }
+
+        size_t in_flight() const { return _ops.size() - _free.size(); }
+
+        /**
+         * Registers buffers with the kernel so reads landing entirely inside one of them
+         * skip per-read page pinning (IORING_OP_READ_FIXED). Replaces earlier buffers.
+         * Best effort: returns false when unsupported or refused (e.g. RLIMIT_MEMLOCK).
+         * Buffers must stay alive while registered or until the reader is destroyed.
+         */
+        bool register_buffers( std::span< const std::span< std::byte > > buffers )
+        {
+            wait();
+            _fixed.clear();
+
+#if defined( SL_IO_URING_AVAILABLE )
+            if ( !_ring.active() )
+                return false;
+
+            std::vector< iovec > iovs;
+            for ( auto b : buffers )
+                iovs.push_back( { b.data(), b.size() } );
+
+            if ( !_ring.register_buffers( iovs ) )
+                return false;
+
+            _fixed.assign( buffers.begin(), buffers.end() );
+            return true;
+#else
+            (void)buffers;
+            return false;
+#endif
+        }
+
+        /**
+         * Queues a read of 'buffer.size()' bytes at 'offset'; 'done' runs from a later
+         * 'poll' / 'wait'. The buffer must stay valid until then.
+         */
+        void read_at( int fd, size_t offset, std::span< std::byte > buffer, completion done )
+        {
+            uint32_t slot;
+            if ( _free.empty() )
+            {
+                slot = static_cast< uint32_t >( _ops.size() );
+                _ops.emplace_back();
+            }
+            else
+            {
+                slot = _free.back();
+                _free.pop_back();
+            }
+
+            _ops[slot] = op { fd, offset, buffer.data(), buffer.size(), 0, -1, std::move( done ) };
+            for ( size_t i = 0; i < _fixed.size(); ++i )
+            {
+                if ( buffer.data() >= _fixed[i].data()
+                     && buffer.data() + buffer.size() <= _fixed[i].data() + _fixed[i].size() )
+                {
+                    _ops[slot].fixed = static_cast< int >( i );
+                    break;
+                }
+            }
+
+            _queued.push_back( slot );
+            if ( _queued.size() >= _depth )
+                pump( false );
+        }
+
+        /**
+         * Reads every request (in parallel, up to the queue depth) and blocks until all are
+         * done. Each request's 'result' gets its completion value. Returns the number of
+         * requests that filled their whole buffer.
+         */
+        size_t read_many( std::span< request > requests )
+        {
+            size_t complete = 0;
+            for ( auto& r : requests )
+            {
+                read_at( r.fd, r.offset, r.buffer, [&r, &complete]( int64_t result ) {
+                    r.result = result;
+                    if ( result == static_cast< int64_t >( r.buffer.size() ) )
+                        ++complete;
+                } );
+            }
+
+            wait();
+            return complete;
+        }
+
+        /**
+         * Submits queued reads and runs completions that are ready, without blocking.
+         * Returns the number of completions run.
+         */
+        size_t poll() { return pump( false ); }
+
+        /**
+         * Blocks until every queued and submitted read has completed.
+         */
+        void wait()
+        {
+            while ( in_flight() > 0 )
+                pump( true );
+        }
+
+    private:
+        struct op
+        {
+            int fd;
+            size_t offset;
+            std::byte* data;
+            size_t length;
+            size_t done;
+            int fixed;
+            completion callback;
+        };
+
+        /**
+         * Moves queued reads to the kernel and reaps completions (waiting for at least one
+         * when 'block' is set), then runs the finished reads' callbacks.
+         */
+        size_t pump( bool block )
+        {
+            std::vector< std::pair< uint32_t, int64_t > > finished;
+
+#if defined( SL_IO_URING_AVAILABLE )
+            if ( _ring.active() )
+            {
+                while ( !_queued.empty() && _submitted < _depth && _ring.space() > 0 )
+                {
+                    auto slot = _queued.front();
+                    _queued.pop_front();
+                    prepare( slot );
+                    ++_submitted;
+                }
+
+                _ring.enter( block && _submitted > 0 ? 1 : 0 );
+                _ring.reap( [this, &finished]( uint64_t slot, int32_t res ) {
+                    --_submitted;
+                    complete( static_cast< uint32_t >( slot ), res, finished );
+                } );
+            }
+            else
+#endif
+            {
+                (void)block;
+                while ( !_queued.empty() )
+                {
+                    auto slot = _queued.front();
+                    _queued.pop_front();
+                    finished.emplace_back( slot, read_sync( _ops[slot] ) );
+                }
+            }
+
+            // Slots are released before callbacks run, so callbacks may queue more reads.
+            std::vector< completion > callbacks;
+            callbacks.reserve( finished.size() );
+            for ( auto [slot, result] : finished )
+            {
+                callbacks.push_back( std::move( _ops[slot].callback ) );
+                _free.push_back( slot );
+            }
+
+            for ( size_t i = 0; i < callbacks.size(); ++i )
+            {
+                if ( callbacks[i] )
+                    callbacks[i]( finished[i].second );
+            }
+
+            return finished.size();
+        }
+
+        static int64_t read_sync( const op& o )
+        {
+            size_t done = 0;
+            while ( done < o.length )
+            {
+                auto n = ::pread( o.fd, o.data + done, o.length - done, o.offset + done );
+                if ( n < 0 && errno == EINTR )
+                    continue;
+                if ( n < 0 )
+                    return -errno;
+                if ( n == 0 )
+                    break;
+                done += static_cast< size_t >( n );
+            }
+
+            return static_cast< int64_t >( done );
+        }
+
+#if defined( SL_IO_URING_AVAILABLE )
+        void prepare( uint32_t slot )
+        {
+            constexpr size_t k_max_read = 1u << 30;
+
+            const auto& o = _ops[slot];
+            auto& sqe     = _ring.next_sqe();
+
+            std::memset( &sqe, 0, sizeof( sqe ) );
+            sqe.opcode    = o.fixed >= 0 ? IORING_OP_READ_FIXED : IORING_OP_READ;
+            sqe.fd        = o.fd;
+            sqe.off       = o.offset + o.done;
+            sqe.addr      = reinterpret_cast< uint64_t >( o.data + o.done );
+            sqe.len       = static_cast< uint32_t >( std::min( o.length - o.done, k_max_read ) );
+            sqe.user_data = slot;
+            if ( o.fixed >= 0 )
+                sqe.buf_index = static_cast< uint16_t >( o.fixed );
+        }
+
+        void complete( uint32_t slot,
+                       int32_t res,
+                       std::vector< std::pair< uint32_t, int64_t > >& finished )
+        {
+            auto& o = _ops[slot];
+
+            if ( res == -EINTR || res == -EAGAIN )
+            {
+                _queued.push_front( slot );
+            }
+            else if ( res < 0 )
+            {
+                finished.emplace_back( slot, res );
+            }
+            else
+            {
+                o.done += static_cast< size_t >( res );
+                if ( res == 0 || o.done >= o.length )
+                    finished.emplace_back( slot, static_cast< int64_t >( o.done ) );
+                else
+                    _queued.push_front( slot );   // Short read; go again for the rest
+            }
+        }
+
+        /**
+         * The raw io_uring: setup, the three ring mappings and submission / completion
+         * bookkeeping. Inactive (and never used) when setup or the opcode probe fails.
+         */
+        struct ring : sl::utils::noncopyable
+        {
+            ring() = default;
+
+            ~ring() noexcept { close(); }
+
+            bool active() const { return _fd >= 0; }
+
+            void setup( unsigned entries )
+            {
+                io_uring_params p {};
+                auto fd = static_cast< int >( ::syscall( __NR_io_uring_setup, entries, &p ) );
+                if ( fd < 0 )
+                    return;
+
+                _fd     = fd;
+                _sq_len = p.sq_off.array + p.sq_entries * sizeof( unsigned );
+                _cq_len = p.cq_off.cqes + p.cq_entries * sizeof( io_uring_cqe );
+                if ( p.features & IORING_FEAT_SINGLE_MMAP )
+                    _sq_len = _cq_len = std::max( _sq_len, _cq_len );
+
+                _sq = map( _sq_len, IORING_OFF_SQ_RING );
+                _cq = ( p.features & IORING_FEAT_SINGLE_MMAP ) ? _sq
+                                                               : map( _cq_len, IORING_OFF_CQ_RING );
+                _sqes_len = p.sq_entries * sizeof( io_uring_sqe );
+                _sqes     = static_cast< io_uring_sqe* >( map( _sqes_len, IORING_OFF_SQES ) );
+
+                if ( !_sq || !_cq || !_sqes || !supports_read() )
+                {
+                    close();
+                    return;
+                }
+
+                auto sq = static_cast< unsigned char* >( _sq );
+                auto cq = static_cast< unsigned char* >( _cq );
+
+                _sq_head  = reinterpret_cast< unsigned* >( sq + p.sq_off.head );
+                _sq_tail  = reinterpret_cast< unsigned* >( sq + p.sq_off.tail );
+                _sq_mask  = *reinterpret_cast< unsigned* >( sq + p.sq_off.ring_mask );
+                _sq_array = reinterpret_cast< unsigned* >( sq + p.sq_off.array );
+                _sq_count = p.sq_entries;
+                _cq_head  = reinterpret_cast< unsigned* >( cq + p.cq_off.head );
+                _cq_tail  = reinterpret_cast< unsigned* >( cq + p.cq_off.tail );
+                _cq_mask  = *reinterpret_cast< unsigned* >( cq + p.cq_off.ring_mask );
+                _cqes     = reinterpret_cast< io_uring_cqe* >( cq + p.cq_off.cqes );
+                _tail     = *_sq_tail;
+            }
+
+            bool register_buffers( const std::vector< iovec >& iovs )
+            {
+                ::syscall( __NR_io_uring_register, _fd, IORING_UNREGISTER_BUFFERS, nullptr, 0 );
+                if ( iovs.empty() )
+                    return true;
+
+                return ::syscall( __NR_io_uring_register,
+                                  _fd,
+                                  IORING_REGISTER_BUFFERS,
+                                  iovs.data(),
+                                  static_cast< unsigned >( iovs.size() ) )
+                       == 0;
+            }
+
+            unsigned space() const
+            {
+                return _sq_count - ( _tail - load( _sq_head, std::memory_order_acquire ) );
+            }
+
+            /**
+             * Claims the next submission slot; published to the kernel by 'enter'.
+             */
+            io_uring_sqe& next_sqe()
+            {
+                auto idx       = _tail & _sq_mask;
+                _sq_array[idx] = idx;
+                ++_tail;
+                return _sqes[idx];
+            }
+
+            void enter( unsigned min_complete )
+            {
+                store( _sq_tail, _tail, std::memory_order_release );
+
+                for ( ;; )
+                {
+                    auto pending = _tail - load( _sq_head, std::memory_order_acquire );
+                    if ( pending == 0 && min_complete == 0 )
+                        return;
+
+                    auto rc = ::syscall( __NR_io_uring_enter,
+                                         _fd,
+                                         pending,
+                                         min_complete,
+                                         min_complete ? IORING_ENTER_GETEVENTS : 0u,
+                                         nullptr,
+                                         0 );
+                    if ( rc >= 0 )
+                        return;
+
+                    // EBUSY: completions must be reaped first, which our caller does next.
+                    if ( errno == EBUSY )
+                        return;
+
+                    io::error::throw_if(
+                        errno != EINTR, "io_uring_enter", errno, "failed to submit reads" );
+                }
+            }
+
+            template< typename Fn >
+            void reap( Fn&& fn )
+            {
+                auto head = load( _cq_head, std::memory_order_relaxed );
+                auto tail = load( _cq_tail, std::memory_order_acquire );
+                for ( ; head != tail; ++head )
+                {
+                    const auto& cqe = _cqes[head & _cq_mask];
+                    fn( cqe.user_data, cqe.res );
+                }
+                store( _cq_head, head, std::memory_order_release );
+            }
+
+        private:
+            void close() noexcept
+            {
+                if ( _sqes )
+                    ::munmap( _sqes, _sqes_len );
+                if ( _cq && _cq != _sq )
+                    ::munmap( _cq, _cq_len );
+                if ( _sq )
+                    ::munmap( _sq, _sq_len );
+                if ( _fd >= 0 )
+                    ::close( _fd );
+
+                _fd   = -1;
+                _sq   = nullptr;
+                _cq   = nullptr;
+                _sqes = nullptr;
+            }
+
+            static unsigned load( unsigned* p, std::memory_order order )
+            {
+                return std::atomic_ref< unsigned >( *p ).load( order );
+            }
+
+            static void store( unsigned* p, unsigned v, std::memory_order order )
+            {
+                std::atomic_ref< unsigned >( *p ).store( v, order );
+            }
+
+            void* map( size_t len, off_t offset ) const
+            {
+                auto p = ::mmap(
+                    nullptr, len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd, offset );
+                return p == MAP_FAILED ? nullptr : p;
+            }
+
+            bool supports_read() const
+            {
+                constexpr unsigned k_ops = 256;
+
+                std::vector< unsigned char > buf( sizeof( io_uring_probe )
+                                                  + k_ops * sizeof( io_uring_probe_op ) );
+                auto probe = reinterpret_cast< io_uring_probe* >( buf.data() );
+                if ( ::syscall( __NR_io_uring_register, _fd, IORING_REGISTER_PROBE, probe, k_ops )
+                     < 0 )
+                    return false;
+
+                auto ops = reinterpret_cast< io_uring_probe_op* >( buf.data()
+                                                                   + sizeof( io_uring_probe ) );
+                return probe->last_op >= IORING_OP_READ
+                       && ( ops[IORING_OP_READ].flags & IO_URING_OP_SUPPORTED );
+            }
+
+        private:
+            int _fd { -1 };
+            void* _sq { nullptr };
+            void* _cq { nullptr };
+            io_uring_sqe* _sqes { nullptr };
+            size_t _sq_len { 0 };
+            size_t _cq_len { 0 };
+            size_t _sqes_len { 0 };
+
+            unsigned* _sq_head { nullptr };
+            unsigned* _sq_tail { nullptr };
+            unsigned* _sq_array { nullptr };
+            unsigned _sq_mask { 0 };
+            unsigned _sq_count { 0 };
+            unsigned _tail { 0 };
+
+            unsigned* _cq_head { nullptr };
+            unsigned* _cq_tail { nullptr };
+            io_uring_cqe* _cqes { nullptr };
+            unsigned _cq_mask { 0 };
+        };
+
+        ring _ring;
+        unsigned _submitted { 0 };
+#endif
+
+    private:
+        unsigned _depth;
+        std::vector< op > _ops;
+        std::vector< uint32_t > _free;
+        std::deque< uint32_t > _queued;
+        std::vector< std::span< std::byte > > _fixed;
+    };
+
+}   // namespace sl::io
+
+#endif /* __ASYNC_READER_H_27217F62D19F4556A0E2262B648B8F0B__ */
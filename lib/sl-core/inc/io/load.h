@@ -25,8 +25,15 @@
 #ifndef __LOAD_H_F9612BABF26B46F8869C646386B65F27__
 #define __LOAD_H_F9612BABF26B46F8869C646386B65F27__
 
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
 #include <filesystem>
 #include <fstream>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #if defined( _WIN32 )
@@ -38,6 +45,18 @@
 #    include <sys/syslimits.h>
 #endif
 
+#if defined( __linux__ ) || defined( __APPLE__ )
+#    include <errno.h>
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+#include <utils/noncopyable.h>
+
+#include "error.h"
+
 namespace sl::io
 {
 
@@ -67,6 +86,184 @@ namespace sl::io
         return load_file< T >( filePath.c_str() );
     }
 
+#if defined( __linux__ ) || defined( __APPLE__ )
+
+    enum class load_strategy
+    {
+        automatic,   // Map files of at least 'map_threshold' bytes, read the rest
+        map,         // Private (copy-on-write) mapping; pages fault in on first access
+        read,        // Uninitialized heap buffer filled by parallel, chunked pread
+    };
+
+    struct load_options
+    {
+        load_strategy strategy { load_strategy::automatic };
+        size_t map_threshold { 64 * 1024 * 1024 };
+        size_t chunk_size { 4 * 1024 * 1024 };   // Bytes per pread task
+        unsigned threads { 0 };                   // Readers for large files (0 = up to 4)
+    };
+
+
+    /**
+     * Owning, move-only buffer of a file's contents as items of T. Backed either by a
+     * private mapping of the file or by an uninitialized heap block, never zero filled.
+     * Items may be modified; a mapped buffer keeps changes private to the process.
+     */
+    template< typename T >
+    struct file_buffer : sl::utils::noncopyable
+    {
+    public:
+        file_buffer() = default;
+
+        file_buffer( file_buffer&& other ) noexcept { *this = std::move( other ); }
+
+        file_buffer& operator=( file_buffer&& other ) noexcept
+        {
+            std::swap( _data, other._data );
+            std::swap( _bytes, other._bytes );
+            std::swap( _mapped, other._mapped );
+            return *this;
+        }
+
+        ~file_buffer() noexcept
+        {
+            if ( _mapped && _data )
+                ::munmap( _data, _bytes );
+            else
+                std::free( _data );
+
+            _data  = nullptr;
+            _bytes = 0;
+        }
+
+        T* data() const noexcept { return static_cast< T* >( _data ); }
+        size_t size() const noexcept { return _bytes / sizeof( T ); }
+        bool empty() const noexcept { return _bytes == 0; }
+        bool mapped() const noexcept { return _mapped; }
+
+        T* begin() const noexcept { return data(); }
+        T* end() const noexcept { return data() + size(); }
+
+        T& operator[]( size_t index ) const noexcept { return data()[index]; }
+
+        operator std::span< T >() const noexcept { return { data(), size() }; }
+        operator std::span< const T >() const noexcept { return { data(), size() }; }
+
+    private:
+        template< typename U >
+        friend file_buffer< U > load_buffer( const char*, load_options );
+
+        void* _data { nullptr };
+        size_t _bytes { 0 };
+        bool _mapped { false };
+    };
+
+
+    /**
+     * Loads a whole file without zero filling or copying through a stream. The size must
+     * be a multiple of sizeof(T); both that and T's alignment are checked before any data
+     * is read. Files larger than one chunk are read by a small team of threads, each
+     * pread-ing whole chunks straight into place.
+     */
+    template< typename T >
+    file_buffer< T > load_buffer( const char* filename, load_options options = {} )
+    {
+        static_assert( std::is_trivially_copyable_v< T >, "file data is copied bytewise" );
+
+        const auto page = static_cast< size_t >( ::sysconf( _SC_PAGESIZE ) );
+        io::error::throw_if(
+            alignof( T ) > page, "T-align-check", -1, "type alignment exceeds the page size" );
+
+        auto fd = ::open( filename, O_RDONLY | O_CLOEXEC );
+        io::error::throw_if( fd == -1, "c-lib::open", errno, "failed to open file" );
+
+        struct closer
+        {
+            ~closer() { ::close( fd ); }
+            int fd;
+        } close_fd { fd };
+
+        struct stat si;
+        io::error::throw_if(
+            ::fstat( fd, &si ) < 0, "c-lib::fstat", errno, "failed to get file size" );
+
+        const auto bytes = static_cast< size_t >( si.st_size );
+        io::error::throw_if( bytes % sizeof( T ) != 0,
+                             "T-size-check",
+                             -1,
+                             "file is not a multiple of requested type" );
+
+        file_buffer< T > buf;
+        if ( bytes == 0 )
+            return buf;
+
+        const bool map = options.strategy == load_strategy::map
+                         || ( options.strategy == load_strategy::automatic
+                              && bytes >= options.map_threshold );
+        if ( map )
+        {
+            auto p = ::mmap( nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0 );
+            io::error::throw_if( p == MAP_FAILED, "c-lib::mmap", errno, "failed to map file" );
+
+            buf._data   = p;
+            buf._bytes  = bytes;
+            buf._mapped = true;
+            return buf;
+        }
+
+        // Page aligned (so aligned_alloc's size rule holds and T is always satisfied).
+        buf._data = std::aligned_alloc( page, ( bytes + page - 1 ) & ~( page - 1 ) );
+        if ( !buf._data )
+            throw std::bad_alloc();
+        buf._bytes = bytes;
+
+        const auto chunk  = std::max< size_t >( options.chunk_size, page ) & ~( page - 1 );
+        const auto chunks = ( bytes + chunk - 1 ) / chunk;
+        const auto team   = static_cast< size_t >(
+            options.threads ? options.threads
+                            : std::min( std::max( std::thread::hardware_concurrency(), 1u ), 4u ) );
+
+        std::atomic< size_t > next { 0 };
+        std::atomic< int > failure { 0 };
+        auto worker = [&] {
+            auto dst = static_cast< unsigned char* >( buf._data );
+            for ( auto c = next++; c < chunks && failure == 0; c = next++ )
+            {
+                auto off = c * chunk;
+                auto end = std::min( off + chunk, bytes );
+                while ( off < end )
+                {
+                    auto n = ::pread( fd, dst + off, end - off, static_cast< off_t >( off ) );
+                    if ( n < 0 && errno == EINTR )
+                        continue;
+                    if ( n <= 0 )
+                    {
+                        failure = n < 0 ? errno : EIO;   // EOF early: the file shrank
+                        return;
+                    }
+                    off += static_cast< size_t >( n );
+                }
+            }
+        };
+
+        std::vector< std::jthread > readers;
+        for ( size_t i = 1; i < std::min( team, chunks ); ++i )
+            readers.emplace_back( worker );
+        worker();
+        readers.clear();
+
+        io::error::throw_if( failure != 0, "c-lib::pread", failure, "failed to read file" );
+        return buf;
+    }
+
+    template< typename T >
+    file_buffer< T > load_buffer( std::filesystem::path filePath, load_options options = {} )
+    {
+        return load_buffer< T >( filePath.c_str(), options );
+    }
+
+#endif
+
 }   // namespace sl::io
 
 #endif /* __LOAD_H_F9612BABF26B46F8869C646386B65F27__ */
@@ -37,6 +37,25 @@ namespace sl::io
         sequential,
     };
 
+    enum class access_mode
+    {
+        read_only,    // Existing file, read-only views
+        read_write,   // Existing file, writable (shared) views
+        create,       // Like read_write, but creates the file if it is missing
+    };
+
+    enum class sync_mode
+    {
+        async,   // Schedule write back and return
+        sync,    // Wait for write back to complete
+    };
+
+    enum class release_mode
+    {
+        drop,   // Unmap the pages now; the next touch faults them back in (MADV_DONTNEED)
+        cold,   // Keep the pages, but make them the first to be reclaimed (MADV_COLD)
+    };
+
 }
 
 #if defined( _WIN32 )
@@ -0,0 +1,181 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023-present Robert Anderson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef __MAPPED_STREAM_H_D57E45A4C09C48A991A1906BBB06029C__
+#define __MAPPED_STREAM_H_D57E45A4C09C48A991A1906BBB06029C__
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <type_traits>
+
+#include <utils/noncopyable.h>
+
+#include "mapped-file.h"
+
+namespace sl::io
+{
+
+    /**
+     * Forward-only cursor over a file that keeps a single, fixed-size window mapped at a
+     * time, so arbitrarily large inputs stream through a bounded address range / RSS.
+     *
+     * Windows start on the page holding the read head. A record that straddles the end of
+     * the current window moves the window up to that page instead of being copied, so
+     * every returned span is contiguous, zero-copy and valid until the window next moves
+     * (any read / peek / next that does not fit the current window). Records larger than
+     * the window get a window of their own size.
+     *
+     * The file is mapped with MADV_SEQUENTIAL, and each new window starts readahead
+     * of the one after it.
+     */
+    struct mapped_stream : sl::utils::noncopyable
+    {
+    public:
+        static constexpr size_t k_default_window = 64 * 1024 * 1024;
+
+        explicit mapped_stream( const char* name, size_t window_size = k_default_window )
+            : _file { name, cache_hint::sequential }
+            , _window { round_to_page( std::max< size_t >( window_size, 1 ) ) }
+            , _position { 0 }
+            , _base { 0 }
+        {}
+
+        size_t size() const { return _file.size(); }
+        size_t position() const { return _position; }
+        size_t remaining() const { return size() - _position; }
+        bool eof() const { return _position >= size(); }
+
+        size_t window_size() const { return _window; }
+        size_t mapped_bytes() const { return _view ? _view->size() : 0; }
+
+        /**
+         * The next 'count' bytes, without advancing the read head.
+         */
+        std::span< const std::byte > peek( size_t count )
+        {
+            io::error::throw_if( count > remaining(),
+                                 "size-check",
+                                 -1,
+                                 "read extends beyond the end of the file" );
+
+            if ( count == 0 )
+                return {};
+
+            slide( count );
+            auto ptr = static_cast< const std::byte* >( _view->data() ) + ( _position - _base );
+            return { ptr, count };
+        }
+
+        /**
+         * The next 'count' bytes; advances the read head past them.
+         */
+        std::span< const std::byte > read( size_t count )
+        {
+            auto bytes = peek( count );
+            _position += count;
+            return bytes;
+        }
+
+        /**
+         * Copies out the next record of type T (so alignment does not matter).
+         */
+        template< typename T >
+        T read_as()
+        {
+            static_assert( std::is_trivially_copyable_v< T > );
+
+            T value;
+            std::memcpy( &value, read( sizeof( T ) ).data(), sizeof( T ) );
+            return value;
+        }
+
+        /**
+         * Up to 'max' bytes, as many as the current window holds without moving it (only
+         * an exhausted window is moved). Empty at the end of the file. Suits bulk scans
+         * that do not care about record boundaries.
+         */
+        std::span< const std::byte > next( size_t max = SIZE_MAX )
+        {
+            if ( eof() )
+                return {};
+
+            if ( !_view || _position >= _base + _view->size() )
+                slide( 1 );
+
+            return read( std::min( max, _base + _view->size() - _position ) );
+        }
+
+        void skip( size_t count )
+        {
+            io::error::throw_if(
+                count > remaining(), "size-check", -1, "skip extends beyond the end of the file" );
+
+            _position += count;
+        }
+
+    private:
+        static size_t round_to_page( size_t size )
+        {
+            const auto page = mapped_view::page_size();
+            return ( size + page - 1 ) & ~( page - 1 );
+        }
+
+        /**
+         * Makes [position, position + count) mapped, moving the window when it is not.
+         */
+        void slide( size_t count )
+        {
+            if ( _view && _position >= _base && _position + count <= _base + _view->size() )
+                return;
+
+            const auto base = _position & ~( mapped_view::page_size() - 1 );
+            const auto len
+                = std::min( std::max( _window, round_to_page( _position + count - base ) ),
+                            size() - base );
+
+            // Unmap behind before mapping ahead, so only one window is ever mapped.
+            _view.reset();
+            _view.emplace( _file.map_view( base, len ) );
+            _base = base;
+
+            if ( base + len < size() )
+                _file.prefetch( base + len, std::min( _window, size() - base - len ) );
+        }
+
+    private:
+        mapped_file _file;
+        size_t _window;
+        size_t _position;
+        size_t _base;
+        std::optional< mapped_view > _view;
+    };
+
+}   // namespace sl::io
+
+#endif /* __MAPPED_STREAM_H_D57E45A4C09C48A991A1906BBB06029C__ */
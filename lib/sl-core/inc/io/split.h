@@ -0,0 +1,375 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023-present Robert Anderson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef __SPLIT_H_8F841A3F1B2F43FEAE0661CD74E78030__
+#define __SPLIT_H_8F841A3F1B2F43FEAE0661CD74E78030__
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <span>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#if defined( __x86_64__ ) || defined( _M_X64 ) || defined( __i386__ )
+#    include <immintrin.h>
+#    define SL_IO_SPLIT_SSE2 1
+#    if defined( __GNUC__ ) || defined( __clang__ )
+#        define SL_IO_SPLIT_AVX2 1   // Compiled with a target attribute, picked at runtime
+#    endif
+#elif defined( __ARM_NEON ) || defined( __aarch64__ )
+#    include <arm_neon.h>
+#    define SL_IO_SPLIT_NEON 1
+#endif
+
+namespace sl::io
+{
+
+    namespace detail
+    {
+
+        inline const char* find_any_scalar( const char* p, const char* end, char a, char b )
+        {
+            for ( ; p < end; ++p )
+            {
+                if ( *p == a || *p == b )
+                    return p;
+            }
+            return end;
+        }
+
+#if defined( SL_IO_SPLIT_SSE2 )
+        inline const char* find_any_sse2( const char* p, const char* end, char a, char b )
+        {
+            const auto va = _mm_set1_epi8( a );
+            const auto vb = _mm_set1_epi8( b );
+            for ( ; end - p >= 16; p += 16 )
+            {
+                auto v    = _mm_loadu_si128( reinterpret_cast< const __m128i* >( p ) );
+                auto hits = _mm_or_si128( _mm_cmpeq_epi8( v, va ), _mm_cmpeq_epi8( v, vb ) );
+                auto mask = static_cast< unsigned >( _mm_movemask_epi8( hits ) );
+                if ( mask )
+                    return p + std::countr_zero( mask );
+            }
+            return find_any_scalar( p, end, a, b );
+        }
+#endif
+
+#if defined( SL_IO_SPLIT_AVX2 )
+        __attribute__( ( target( "avx2" ) ) ) inline const char*
+        find_any_avx2( const char* p, const char* end, char a, char b )
+        {
+            const auto va = _mm256_set1_epi8( a );
+            const auto vb = _mm256_set1_epi8( b );
+            for ( ; end - p >= 32; p += 32 )
+            {
+                auto v    = _mm256_loadu_si256( reinterpret_cast< const __m256i* >( p ) );
+                auto hits
+                    = _mm256_or_si256( _mm256_cmpeq_epi8( v, va ), _mm256_cmpeq_epi8( v, vb ) );
+                auto mask = static_cast< unsigned >( _mm256_movemask_epi8( hits ) );
+                if ( mask )
+                    return p + std::countr_zero( mask );
+            }
+            return find_any_sse2( p, end, a, b );
+        }
+#endif
+
+#if defined( SL_IO_SPLIT_NEON )
+        inline const char* find_any_neon( const char* p, const char* end, char a, char b )
+        {
+            const auto va = vdupq_n_u8( static_cast< uint8_t >( a ) );
+            const auto vb = vdupq_n_u8( static_cast< uint8_t >( b ) );
+            for ( ; end - p >= 16; p += 16 )
+            {
+                auto v    = vld1q_u8( reinterpret_cast< const uint8_t* >( p ) );
+                auto hits = vorrq_u8( vceqq_u8( v, va ), vceqq_u8( v, vb ) );
+
+                // Narrow each 0x00 / 0xFF byte to a nibble, giving a 64-bit mask.
+                auto nibbles = vshrn_n_u16( vreinterpretq_u16_u8( hits ), 4 );
+                auto mask    = vget_lane_u64( vreinterpret_u64_u8( nibbles ), 0 );
+                if ( mask )
+                    return p + ( std::countr_zero( mask ) >> 2 );
+            }
+            return find_any_scalar( p, end, a, b );
+        }
+#endif
+
+        using find_any_fn = const char* ( * )( const char*, const char*, char, char );
+
+        inline find_any_fn select_find_any()
+        {
+#if defined( SL_IO_SPLIT_AVX2 )
+            if ( __builtin_cpu_supports( "avx2" ) )
+                return &find_any_avx2;
+#endif
+#if defined( SL_IO_SPLIT_SSE2 )
+            return &find_any_sse2;
+#elif defined( SL_IO_SPLIT_NEON )
+            return &find_any_neon;
+#else
+            return &find_any_scalar;
+#endif
+        }
+
+    }   // namespace detail
+
+
+    /**
+     * First occurrence of 'a' or 'b' in [p, end), or 'end'. Vectorized with the widest
+     * instruction set the CPU has (AVX2 is picked at runtime on x86, SSE2 / NEON are the
+     * baselines), falling back to a scalar loop elsewhere.
+     */
+    inline const char* find_any( const char* p, const char* end, char a, char b ) noexcept
+    {
+        static const auto impl = detail::select_find_any();
+        return impl( p, end, a, b );
+    }
+
+    inline const char* find_byte( const char* p, const char* end, char c ) noexcept
+    {
+        return find_any( p, end, c, c );
+    }
+
+    inline std::string_view as_chars( std::span< const std::byte > bytes ) noexcept
+    {
+        return { reinterpret_cast< const char* >( bytes.data() ), bytes.size() };
+    }
+
+
+    /**
+     * Forward range of the records in 'data' separated by 'delimiter', as views into it
+     * (the delimiter itself is excluded). An empty record after a final delimiter is only
+     * produced when 'keep_trailing' is set, so "a\nb\n" is two lines but "a,b," is three
+     * fields (and "" is no lines but one empty field). Quoting (as in CSV) is not interpreted.
+     */
+    struct split_range
+    {
+    public:
+        struct sentinel
+        {};
+
+        struct iterator
+        {
+            using value_type      = std::string_view;
+            using difference_type = std::ptrdiff_t;
+
+            std::string_view operator*() const noexcept { return _current; }
+            const std::string_view* operator->() const noexcept { return &_current; }
+
+            iterator& operator++() noexcept
+            {
+                advance();
+                return *this;
+            }
+
+            iterator operator++( int ) noexcept
+            {
+                auto it = *this;
+                advance();
+                return it;
+            }
+
+            bool operator==( sentinel ) const noexcept { return _done; }
+
+        private:
+            friend struct split_range;
+
+            void advance() noexcept
+            {
+                if ( !_pos )
+                {
+                    _done = true;
+                    return;
+                }
+
+                if ( _pos == _end )
+                {
+                    _current = { _end, 0 };
+                    _done    = !( _keep_trailing && _after_delimiter );
+                    _pos     = nullptr;
+                    return;
+                }
+
+                auto hit = find_byte( _pos, _end, _delimiter );
+                _current = { _pos, static_cast< size_t >( hit - _pos ) };
+                if ( hit == _end )
+                {
+                    _pos = nullptr;
+                }
+                else
+                {
+                    _pos             = hit + 1;
+                    _after_delimiter = true;
+                }
+            }
+
+            const char* _pos { nullptr };
+            const char* _end { nullptr };
+            std::string_view _current {};
+            char _delimiter { '\n' };
+            bool _keep_trailing { false };
+            bool _after_delimiter { false };
+            bool _done { true };
+        };
+
+        split_range( std::string_view data, char delimiter = '\n', bool keep_trailing = false )
+            : _data { data }
+            , _delimiter { delimiter }
+            , _keep_trailing { keep_trailing }
+        {}
+
+        split_range( std::span< const std::byte > data,
+                     char delimiter     = '\n',
+                     bool keep_trailing = false )
+            : split_range( as_chars( data ), delimiter, keep_trailing )
+        {}
+
+        iterator begin() const noexcept
+        {
+            // An empty input is one empty field when trailing records are kept, the same as
+            // the empty record after a final delimiter.
+            const char* data = _data.empty() ? "" : _data.data();
+
+            iterator it;
+            it._pos             = data;
+            it._end             = data + _data.size();
+            it._delimiter       = _delimiter;
+            it._keep_trailing   = _keep_trailing;
+            it._after_delimiter = _data.empty();
+            it._done            = false;
+            it.advance();
+            return it;
+        }
+
+        sentinel end() const noexcept { return {}; }
+
+    private:
+        std::string_view _data;
+        char _delimiter;
+        bool _keep_trailing;
+    };
+
+    inline split_range split_lines( std::string_view data ) { return split_range( data, '\n' ); }
+
+    inline split_range split_lines( std::span< const std::byte > data )
+    {
+        return split_range( data, '\n' );
+    }
+
+    inline split_range split_fields( std::string_view record, char delimiter = ',' )
+    {
+        return split_range( record, delimiter, true );
+    }
+
+
+    /**
+     * Splits 'data' into at most 'parts' chunks of roughly equal size, each ending just
+     * after a delimiter (except possibly the last), so no record spans two chunks.
+     */
+    inline std::vector< std::string_view >
+    partition( std::string_view data, size_t parts, char delimiter = '\n' )
+    {
+        std::vector< std::string_view > chunks;
+        const auto end = data.data() + data.size();
+
+        size_t start = 0;
+        for ( size_t i = 1; i < parts && start < data.size(); ++i )
+        {
+            const auto target = data.size() / parts * i;
+            if ( target < start )
+                continue;
+
+            auto hit = find_byte( data.data() + target, end, delimiter );
+            auto cut = hit == end ? data.size() : static_cast< size_t >( hit - data.data() ) + 1;
+            chunks.push_back( data.substr( start, cut - start ) );
+            start = cut;
+        }
+
+        if ( start < data.size() )
+            chunks.push_back( data.substr( start ) );
+
+        return chunks;
+    }
+
+    /**
+     * Runs 'fn( chunk_index, record )' for every record of 'data', with one thread per
+     * balanced chunk (see 'partition'). Records of a chunk are visited in order; chunks run
+     * concurrently, so 'fn' must be thread safe. A 'threads' of zero uses every core.
+     *
+     * If 'fn' throws, the remaining chunks stop at their next record and the first
+     * exception is rethrown on the calling thread once every worker has joined.
+     */
+    template< typename Fn >
+    void parallel_for_each_record( std::string_view data,
+                                   unsigned threads,
+                                   Fn&& fn,
+                                   char delimiter = '\n' )
+    {
+        if ( threads == 0 )
+            threads = std::max( std::thread::hardware_concurrency(), 1u );
+
+        auto chunks = partition( data, threads, delimiter );
+
+        std::atomic< bool > failed { false };
+        std::exception_ptr failure;
+
+        auto scan = [&]( size_t index ) {
+            try
+            {
+                for ( auto record : split_range( chunks[index], delimiter ) )
+                {
+                    if ( failed.load( std::memory_order_relaxed ) )
+                        return;
+                    fn( index, record );
+                }
+            }
+            catch ( ... )
+            {
+                // Only the first failing chunk records its exception.
+                if ( !failed.exchange( true ) )
+                    failure = std::current_exception();
+            }
+        };
+
+        {
+            std::vector< std::jthread > workers;
+            for ( size_t i = 1; i < chunks.size(); ++i )
+                workers.emplace_back( scan, i );
+
+            if ( !chunks.empty() )
+                scan( 0 );
+        }
+
+        if ( failure )
+            std::rethrow_exception( failure );
+    }
+
+}   // namespace sl::io
+
+#endif /* __SPLIT_H_8F841A3F1B2F43FEAE0661CD74E78030__ */
@@ -42,11 +42,22 @@ namespace sl::io
     {
     public:
         mapped_file( const char* name, cache_hint hint = cache_hint::none )
+            : mapped_file( name, access_mode::read_only, hint )
+        {}
+
+        mapped_file( const char* name, access_mode mode, cache_hint hint = cache_hint::none )
             : _hint { MADV_NORMAL }
             , _fd { -1 }
             , _size { 0 }
+            , _writable { mode != access_mode::read_only }
         {
-            _fd = ::open( name, O_RDONLY );
+            int flags = O_RDONLY;
+            if ( mode == access_mode::read_write )
+                flags = O_RDWR;
+            else if ( mode == access_mode::create )
+                flags = O_RDWR | O_CREAT;
+
+            _fd = ::open( name, flags | O_CLOEXEC, 0644 );
             io::error::throw_if( _fd == -1, "c-lib::open", errno, "failed to open file" );
 
             struct stat si;
@@ -83,16 +94,101 @@ namespace sl::io
         }
 
         size_t size() const { return _size; }
+        bool writable() const { return _writable; }
 
+        /**
+         * Views must lie within the file; use 'resize' / 'preallocate' first to extend it.
+         * Views of a writable file are shared, so stores land in the file.
+         */
         mapped_view map_view( size_t offset, size_t size ) const
         {
-            return mapped_view( _fd, offset, size, _hint );
+            io::error::throw_if( offset + size > _size,
+                                 "size-check",
+                                 -1,
+                                 "view extends beyond the end of the file" );
+
+            return mapped_view(
+                _fd, offset, size, _hint, _writable ? PROT_READ | PROT_WRITE : PROT_READ );
+        }
+
+        /**
+         * Sets the file size (ftruncate). Growing fills with zeros, usually sparsely.
+         * Existing views are not resized; use 'mapped_view::remap' for that.
+         */
+        void resize( size_t size )
+        {
+            check_writable();
+
+            auto rc = ::ftruncate( _fd, static_cast< off_t >( size ) );
+            io::error::throw_if( rc != 0, "c-lib::ftruncate", errno, "failed to resize file" );
+
+            _size = size;
+        }
+
+        /**
+         * Reserves disk blocks for the first 'size' bytes and grows the file to at least
+         * that size, so later stores through a view can not fail (SIGBUS) on a full disk.
+         * Never shrinks the file.
+         */
+        void preallocate( size_t size )
+        {
+            check_writable();
+
+#if defined( __linux__ )
+            auto rc = ::posix_fallocate( _fd, 0, static_cast< off_t >( size ) );
+            io::error::throw_if( rc != 0, "c-lib::posix_fallocate", rc, "failed to preallocate" );
+#elif defined( __APPLE__ )
+            if ( size > _size )
+            {
+                fstore_t store { F_ALLOCATEALL, F_PEOFPOSMODE, 0, off_t( size - _size ), 0 };
+                ::fcntl( _fd, F_PREALLOCATE, &store );   // Best effort; ftruncate below.
+                auto rc = ::ftruncate( _fd, static_cast< off_t >( size ) );
+                io::error::throw_if( rc != 0, "c-lib::ftruncate", errno, "failed to preallocate" );
+            }
+#endif
+
+            if ( size > _size )
+                _size = size;
+        }
+
+        /**
+         * Starts asynchronous readahead of a file range into the page cache, without
+         * mapping it. Advisory only.
+         */
+        void prefetch( size_t offset, size_t count ) const
+        {
+#if defined( __linux__ )
+            ::posix_fadvise( _fd, static_cast< off_t >( offset ), count, POSIX_FADV_WILLNEED );
+#elif defined( __APPLE__ )
+            radvisory ra { static_cast< off_t >( offset ), static_cast< int >( count ) };
+            ::fcntl( _fd, F_RDADVISE, &ra );
+#endif
+        }
+
+        /**
+         * Flushes file data (not views; see 'mapped_view::sync') to the device.
+         */
+        void sync() const
+        {
+#if defined( __linux__ )
+            auto rc = ::fdatasync( _fd );
+#else
+            auto rc = ::fsync( _fd );
+#endif
+            io::error::throw_if( rc != 0, "c-lib::fdatasync", errno, "failed to sync file" );
+        }
+
+    private:
+        void check_writable() const
+        {
+            io::error::throw_if( !_writable, "mode-check", -1, "file is not opened for writing" );
         }
 
     private:
         int _hint;
         int _fd;
         size_t _size;
+        bool _writable;
     };
 
 }   // namespace sl::io
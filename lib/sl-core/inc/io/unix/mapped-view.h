@@ -27,8 +27,11 @@
 
 #include <errno.h>
 #include <sys/mman.h>
+#include <unistd.h>
 
 #include <span>
+#include <utility>
+#include <vector>
 
 #include <utils/noncopyable.h>
 
@@ -38,16 +41,42 @@ namespace sl::io
     struct mapped_view : sl::utils::noncopyable
     {
     public:
-        mapped_view( int fd, size_t offset, size_t size, int hint )
+        mapped_view( int fd, size_t offset, size_t size, int hint, int prot = PROT_READ )
             : _size { size }
+            , _offset { offset }
+            , _fd { fd }
+            , _hint { hint }
+            , _prot { prot }
         {
-            _view = ::mmap( nullptr, size, PROT_READ, MAP_SHARED, fd, offset );
+            _view = ::mmap( nullptr, size, prot, MAP_SHARED, fd, offset );
             io::error::throw_if( _view == MAP_FAILED, "c-lib::mmap", errno, "failed to map view" );
 
             // We are going to ignore the failure here. Worst case, we don't get to "tweak".
             ::madvise( _view, size, hint );
         }
 
+        mapped_view( mapped_view&& other ) noexcept
+            : _size { 0 }
+            , _offset { 0 }
+            , _fd { -1 }
+            , _hint { MADV_NORMAL }
+            , _prot { PROT_NONE }
+            , _view { nullptr }
+        {
+            *this = std::move( other );
+        }
+
+        mapped_view& operator=( mapped_view&& other ) noexcept
+        {
+            std::swap( _size, other._size );
+            std::swap( _offset, other._offset );
+            std::swap( _fd, other._fd );
+            std::swap( _hint, other._hint );
+            std::swap( _prot, other._prot );
+            std::swap( _view, other._view );
+            return *this;
+        }
+
         ~mapped_view() noexcept
         {
             if ( _view != nullptr )
@@ -57,6 +86,130 @@ namespace sl::io
             _size = 0;
         }
 
+        void* data() const noexcept { return _view; }
+        size_t size() const noexcept { return _size; }
+        bool writable() const noexcept { return ( _prot & PROT_WRITE ) != 0; }
+
+        /**
+         * Grows (or shrinks) the view in place when the kernel allows it (mremap on Linux),
+         * otherwise maps it again. Either way, pointers into the old view are invalidated.
+         * The file must already be large enough (see 'mapped_file::resize').
+         */
+        void remap( size_t size )
+        {
+#if defined( __linux__ )
+            auto view = ::mremap( _view, _size, size, MREMAP_MAYMOVE );
+            io::error::throw_if( view == MAP_FAILED, "c-lib::mremap", errno, "failed to remap" );
+#else
+            auto view = ::mmap( nullptr, size, _prot, MAP_SHARED, _fd, _offset );
+            io::error::throw_if( view == MAP_FAILED, "c-lib::mmap", errno, "failed to remap" );
+            ::munmap( _view, _size );
+#endif
+
+            _view = view;
+            _size = size;
+            ::madvise( _view, _size, _hint );
+        }
+
+        /**
+         * Writes dirty pages in [offset, offset + count) back to the file. A count of zero
+         * means "to the end of the view". The range is widened to page boundaries.
+         */
+        void sync( sync_mode mode = sync_mode::sync, size_t offset = 0, size_t count = 0 ) const
+        {
+            auto [sp, len] = page_range( offset, count );
+            auto rc        = ::msync( sp, len, mode == sync_mode::async ? MS_ASYNC : MS_SYNC );
+            io::error::throw_if( rc != 0, "c-lib::msync", errno, "failed to sync view" );
+        }
+
+        /**
+         * Faults the range in now (page cache reads plus page table entries), so the first
+         * real access does not stall. Uses MADV_POPULATE_READ where the kernel has it and
+         * falls back to touching one byte per page.
+         */
+        void populate( size_t offset = 0, size_t count = 0 ) const
+        {
+            auto [sp, len] = page_range( offset, count );
+
+#if defined( MADV_POPULATE_READ )
+            if ( ::madvise( sp, len, MADV_POPULATE_READ ) == 0 )
+                return;
+#endif
+
+            const auto page = page_size();
+            for ( size_t off = 0; off < len; off += page )
+                static_cast< const volatile unsigned char* >( sp )[off];
+        }
+
+        /**
+         * Starts asynchronous readahead of the range (MADV_WILLNEED). Advisory only.
+         */
+        void prefetch( size_t offset = 0, size_t count = 0 ) const
+        {
+            auto [sp, len] = page_range( offset, count );
+            ::madvise( sp, len, MADV_WILLNEED );   // Failure only costs the readahead.
+        }
+
+        /**
+         * Gives the range's memory back. The data stays in the file (dirty shared pages are
+         * kept in the page cache), so this never loses writes. Advisory only.
+         */
+        void release( size_t offset = 0, size_t count = 0, release_mode mode = release_mode::drop )
+        {
+            auto [sp, len] = page_range( offset, count );
+
+#if defined( MADV_COLD )
+            if ( mode == release_mode::cold )
+            {
+                ::madvise( sp, len, MADV_COLD );
+                return;
+            }
+#else
+            (void)mode;
+#endif
+
+            ::madvise( sp, len, MADV_DONTNEED );
+        }
+
+        /**
+         * Pins the range in memory (mlock). Fails when it exceeds RLIMIT_MEMLOCK.
+         */
+        void lock( size_t offset = 0, size_t count = 0 ) const
+        {
+            auto [sp, len] = page_range( offset, count );
+            io::error::throw_if(
+                ::mlock( sp, len ) != 0, "c-lib::mlock", errno, "failed to lock view" );
+        }
+
+        void unlock( size_t offset = 0, size_t count = 0 ) const
+        {
+            auto [sp, len] = page_range( offset, count );
+            ::munlock( sp, len );   // Unlocking pages that are not locked is harmless.
+        }
+
+        /**
+         * Number of pages in the range currently resident in memory (mincore).
+         */
+        size_t resident_pages( size_t offset = 0, size_t count = 0 ) const
+        {
+            auto [sp, len] = page_range( offset, count );
+
+            std::vector< residency_t > pages( ( len + page_size() - 1 ) / page_size() );
+            auto rc = ::mincore( sp, len, pages.data() );
+            io::error::throw_if( rc != 0, "c-lib::mincore", errno, "failed to query residency" );
+
+            size_t resident = 0;
+            for ( auto p : pages )
+                resident += ( p & 1 );
+            return resident;
+        }
+
+        static size_t page_size() noexcept
+        {
+            static const size_t size = static_cast< size_t >( ::sysconf( _SC_PAGESIZE ) );
+            return size;
+        }
+
         /**
          * Caller is responsible for not violating alignment rules for the CPU
          */
@@ -101,8 +254,35 @@ namespace sl::io
             return as_items< std::byte >( offset, count );
         }
 
+    private:
+#if defined( __APPLE__ )
+        using residency_t = char;
+#else
+        using residency_t = unsigned char;
+#endif
+
+        /**
+         * Widens [offset, offset + count) to page boundaries; a count of zero (or one
+         * running past the end) means "to the end of the view".
+         */
+        std::pair< void*, size_t > page_range( size_t offset, size_t count ) const
+        {
+            io::error::throw_if(
+                offset > _size, "offset-check", -1, "range offset is beyond mapped view" );
+
+            if ( count == 0 || offset + count > _size )
+                count = _size - offset;
+
+            const auto start = offset & ~( page_size() - 1 );
+            return { static_cast< unsigned char* >( _view ) + start, offset + count - start };
+        }
+
     private:
         size_t _size;
+        size_t _offset;
+        int _fd;
+        int _hint;
+        int _prot;
         void* _view;
     };
 
@@ -0,0 +1,362 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023-present Robert Anderson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef __ASYNC_H_3602F5F9711445CB9F6043F02EDDAB84__
+#define __ASYNC_H_3602F5F9711445CB9F6043F02EDDAB84__
+
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <utils/noncopyable.h>
+
+#include "format.h"
+#include "sink.h"
+
+#ifndef SL_MAX_LOG_LINE
+#    define SL_MAX_LOG_LINE 512U
+#endif
+
+namespace sl::logging
+{
+
+    enum class overflow_policy
+    {
+        block,    // Producers wait for the drainer to free space
+        drop,     // Lines that do not fit are discarded (see 'dropped')
+        report,   // Like drop, and the drainer logs how many lines were lost
+    };
+
+    struct async_options
+    {
+        size_t capacity { 4096 };   // Lines in flight (rounded up to a power of two)
+        overflow_policy overflow { overflow_policy::block };
+        size_t batch { 256 };   // Most lines handed to the sink in one write
+        bool deferred { false };   // Loggers queue format + raw arguments (see 'push')
+    };
+
+
+    /**
+     * Moves log output off the calling threads. Producers copy finished lines into a
+     * bounded, lock-free multi-producer ring (fixed-size slots, one CAS per line); a single
+     * drainer thread hands ready lines to the sink in batches (one 'writev' per batch with
+     * 'fd_sink') and sleeps when the ring is empty. Producers only make a syscall to wake a
+     * sleeping drainer, or when 'block'-ing on a full ring.
+     *
+     * With 'deferred' set, loggers skip formatting altogether: they queue the format string's
+     * address plus the raw argument bytes, and the drainer formats the line (or, for a
+     * binary sink, writes the record as is). Format strings must then outlive the backend,
+     * which string literals do.
+     *
+     * Lines longer than 'k_max_line' are truncated. Destroying the backend writes every
+     * line already pushed; producers must be done by then.
+     */
+    struct async_backend : sl::utils::noncopyable
+    {
+    public:
+        static constexpr size_t k_max_line = SL_MAX_LOG_LINE + 32;
+
+        explicit async_backend( sink& out, async_options options = {} )
+            : _sink { out }
+            , _options { options }
+            , _capacity { std::bit_ceil( std::max< size_t >( options.capacity, 2 ) ) }
+            , _slots { std::make_unique< slot[] >( _capacity ) }
+        {
+            for ( size_t i = 0; i < _capacity; ++i )
+                _slots[i].seq.store( i, std::memory_order_relaxed );
+
+            _drainer = std::jthread( [this]( std::stop_token stop ) { drain( stop ); } );
+        }
+
+        ~async_backend() noexcept
+        {
+            _drainer.request_stop();
+            wake();
+            _drainer.join();
+        }
+
+        size_t capacity() const { return _capacity; }
+        bool deferred() const { return _options.deferred; }
+        size_t dropped() const { return _dropped.load( std::memory_order_relaxed ); }
+
+        /**
+         * Queues a finished line (which should end with a newline). Returns false when the
+         * line was dropped because the ring was full.
+         */
+        bool push( std::string_view line )
+        {
+            return emplace( [line]( char* data ) {
+                auto size = std::min( line.size(), k_max_line );
+                std::memcpy( data + sizeof( entry_header ), line.data(), size );
+                if ( size < line.size() )
+                    data[sizeof( entry_header ) + size - 1] = '\n';
+
+                auto length = static_cast< uint32_t >( size );
+                return put_header( data, { entry_kind::text, log_level::info, 0, length, 0 } );
+            } );
+        }
+
+        /**
+         * Queues a record to be formatted on the drainer thread: the address of 'format' and
+         * the raw argument bytes (C strings are copied). 'format' must outlive the backend.
+         */
+        template< deferrable_arg... Args >
+        bool push( log_level level, const char* format, Args... args )
+        {
+            return emplace( [&]( char* data ) {
+                auto out  = reinterpret_cast< std::byte* >( data + sizeof( entry_header ) );
+                auto size = static_cast< uint32_t >( encode_args( out, k_max_line, args... ) );
+                auto id   = static_cast< uint64_t >( reinterpret_cast< uintptr_t >( format ) );
+
+                return put_header( data, { entry_kind::record, level, 0, size, id } );
+            } );
+        }
+
+        /**
+         * Blocks until every line pushed before the call has reached the sink, then
+         * flushes the sink.
+         */
+        void flush()
+        {
+            const auto target = _head.load( std::memory_order_acquire );
+            wake();
+
+            for ( auto w = _written.load( std::memory_order_acquire ); w < target;
+                  w      = _written.load( std::memory_order_acquire ) )
+                _written.wait( w, std::memory_order_acquire );
+
+            const auto request = _flush_requests.fetch_add( 1, std::memory_order_acq_rel ) + 1;
+            wake();
+
+            for ( auto f = _flushed.load( std::memory_order_acquire ); f < request;
+                  f      = _flushed.load( std::memory_order_acquire ) )
+                _flushed.wait( f, std::memory_order_acquire );
+        }
+
+    private:
+        struct alignas( 64 ) slot
+        {
+            std::atomic< size_t > seq;
+            uint32_t size;
+            char data[sizeof( entry_header ) + k_max_line];
+        };
+
+        static uint32_t put_header( char* data, entry_header header )
+        {
+            std::memcpy( data, &header, sizeof( header ) );
+            return static_cast< uint32_t >( sizeof( header ) + header.size );
+        }
+
+        /**
+         * Claims a slot, lets 'fill( data )' write an entry into it (returning its size) and
+         * publishes it.
+         */
+        template< typename Fill >
+        bool emplace( Fill&& fill )
+        {
+            auto pos = _head.load( std::memory_order_relaxed );
+            slot* s  = nullptr;
+            for ( ;; )
+            {
+                s        = &_slots[pos & ( _capacity - 1 )];
+                auto seq = s->seq.load( std::memory_order_acquire );
+                auto dif = static_cast< intptr_t >( seq ) - static_cast< intptr_t >( pos );
+
+                if ( dif == 0 )
+                {
+                    if ( _head.compare_exchange_weak( pos, pos + 1, std::memory_order_relaxed ) )
+                        break;
+                }
+                else if ( dif < 0 )
+                {
+                    if ( _options.overflow != overflow_policy::block )
+                    {
+                        _dropped.fetch_add( 1, std::memory_order_relaxed );
+                        return false;
+                    }
+
+                    wake();
+                    std::this_thread::yield();
+                    pos = _head.load( std::memory_order_relaxed );
+                }
+                else
+                {
+                    pos = _head.load( std::memory_order_relaxed );
+                }
+            }
+
+            s->size = fill( s->data );
+            s->seq.store( pos + 1, std::memory_order_release );
+
+            // Pairs with the fence in 'drain': either we see it sleeping, or it sees us.
+            std::atomic_thread_fence( std::memory_order_seq_cst );
+            if ( _sleeping.load( std::memory_order_relaxed ) )
+                wake();
+
+            return true;
+        }
+
+        void wake()
+        {
+            _wake.fetch_add( 1, std::memory_order_release );
+            _wake.notify_one();
+        }
+
+        bool ready( size_t pos ) const
+        {
+            return _slots[pos & ( _capacity - 1 )].seq.load( std::memory_order_acquire ) == pos + 1;
+        }
+
+        static std::string_view render( const slot& s, char* out )
+        {
+            entry_header header;
+            std::memcpy( &header, s.data, sizeof( header ) );
+            auto payload = s.data + sizeof( header );
+
+            if ( header.kind == entry_kind::text )
+                return { payload, header.size };
+
+            auto format = reinterpret_cast< const char* >( uintptr_t( header.format ) );
+            auto args   = std::span( reinterpret_cast< const std::byte* >( payload ), header.size );
+            return { out, render_record( out, k_max_line, header.level, format, args ) };
+        }
+
+        void drain( std::stop_token stop )
+        {
+            std::vector< std::string_view > lines;
+            lines.reserve( _options.batch + 1 );
+
+            // Binary sinks take entries verbatim; everything else gets rendered lines.
+            const bool binary = _sink.binary();
+            std::vector< char > rendered( binary ? 0 : _options.batch * k_max_line );
+
+            size_t pos      = 0;
+            size_t reported = 0;
+            char report[sizeof( entry_header ) + 96];
+
+            for ( ;; )
+            {
+                lines.clear();
+
+                size_t n = 0;
+                while ( n < _options.batch && ready( pos + n ) )
+                {
+                    const auto& s = _slots[( pos + n ) & ( _capacity - 1 )];
+                    if ( binary )
+                        lines.emplace_back( s.data, s.size );
+                    else
+                        lines.push_back( render( s, rendered.data() + n * k_max_line ) );
+                    ++n;
+                }
+
+                auto dropped = _dropped.load( std::memory_order_relaxed );
+                if ( _options.overflow == overflow_policy::report && dropped != reported )
+                {
+                    auto text = report + sizeof( entry_header );
+                    auto len  = static_cast< uint32_t >(
+                        std::snprintf( text,
+                                       sizeof( report ) - sizeof( entry_header ),
+                                       "[WARNING] log queue full, dropped %zu line(s)\n",
+                                       dropped - reported ) );
+
+                    if ( binary )
+                    {
+                        entry_header header { entry_kind::text, log_level::warning, 0, len, 0 };
+                        lines.emplace_back( report, put_header( report, header ) );
+                    }
+                    else
+                    {
+                        lines.emplace_back( text, len );
+                    }
+                    reported = dropped;
+                }
+
+                if ( !lines.empty() )
+                {
+                    _sink.write( lines );
+
+                    for ( size_t i = 0; i < n; ++i )
+                        _slots[( pos + i ) & ( _capacity - 1 )].seq.store(
+                            pos + i + _capacity, std::memory_order_release );
+
+                    pos += n;
+                    _written.store( pos, std::memory_order_release );
+                    _written.notify_all();
+                    continue;
+                }
+
+                auto requested = _flush_requests.load( std::memory_order_acquire );
+                if ( requested != _flushed.load( std::memory_order_relaxed ) )
+                {
+                    _sink.flush();
+                    _flushed.store( requested, std::memory_order_release );
+                    _flushed.notify_all();
+                    continue;
+                }
+
+                if ( stop.stop_requested() )
+                    break;
+
+                // Nothing to do; sleep until a producer (or flush / shutdown) wakes us.
+                auto w = _wake.load( std::memory_order_acquire );
+                _sleeping.store( true, std::memory_order_relaxed );
+                std::atomic_thread_fence( std::memory_order_seq_cst );
+
+                if ( !ready( pos ) && !stop.stop_requested()
+                     && _flush_requests.load( std::memory_order_acquire ) == requested )
+                    _wake.wait( w, std::memory_order_acquire );
+
+                _sleeping.store( false, std::memory_order_relaxed );
+            }
+
+            _sink.flush();
+        }
+
+    private:
+        sink& _sink;
+        async_options _options;
+        size_t _capacity;
+        std::unique_ptr< slot[] > _slots;
+
+        alignas( 64 ) std::atomic< size_t > _head { 0 };
+        alignas( 64 ) std::atomic< size_t > _written { 0 };
+        std::atomic< size_t > _dropped { 0 };
+        std::atomic< uint64_t > _flush_requests { 0 };
+        std::atomic< uint64_t > _flushed { 0 };
+        alignas( 64 ) std::atomic< bool > _sleeping { false };
+        std::atomic< uint32_t > _wake { 0 };
+
+        std::jthread _drainer;
+    };
+
+}   // namespace sl::logging
+
+#endif /* __ASYNC_H_3602F5F9711445CB9F6043F02EDDAB84__ */
@@ -0,0 +1,183 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023-present Robert Anderson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef __BINARY_H_91149B4E50A642BDAC639D38F56AD0B2__
+#define __BINARY_H_91149B4E50A642BDAC639D38F56AD0B2__
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <deque>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <io/error.h>
+
+#include "format.h"
+#include "sink.h"
+
+namespace sl::logging
+{
+
+    /**
+     * Binary log files start with this magic, followed by queue entries exactly as they
+     * sat in the ring ('entry_header' + payload). A 'format' entry carrying the text of a
+     * format string precedes the first record that uses it.
+     */
+    constexpr std::string_view k_binary_log_magic { "SLBLOG01", 8 };
+
+
+    /**
+     * Writes deferred records to a compact binary file without formatting them. Pair with
+     * 'async_options::deferred'; decode with 'decode_binary_log' (or the log-decode tool).
+     */
+    struct binary_sink : sink
+    {
+    public:
+        explicit binary_sink( const char* path )
+            : _fd { ::open( path, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644 ) }
+            , _out { _fd }
+        {
+            io::error::throw_if( _fd == -1, "c-lib::open", errno, "failed to open log file" );
+
+            struct stat st;
+            if ( ::fstat( _fd, &st ) == 0 && st.st_size == 0 )
+                _out.write( std::span( &k_binary_log_magic, 1 ) );
+        }
+
+        ~binary_sink() noexcept override
+        {
+            if ( _fd >= 0 )
+                ::close( _fd );
+        }
+
+        bool binary() const override { return true; }
+
+        void write( std::span< const std::string_view > entries ) override
+        {
+            _batch.clear();
+            _formats.clear();
+
+            for ( auto entry : entries )
+            {
+                entry_header header;
+                std::memcpy( &header, entry.data(), sizeof( header ) );
+
+                // Format ids are addresses in this process, so every run of the writer
+                // (re)defines the ids it uses before their first record.
+                if ( header.kind == entry_kind::record && _known.insert( header.format ).second )
+                {
+                    auto text = reinterpret_cast< const char* >( uintptr_t( header.format ) );
+                    auto size = static_cast< uint32_t >( std::strlen( text ) );
+
+                    auto& def = _formats.emplace_back(
+                        entry_header { entry_kind::format, header.level, 0, size, header.format } );
+                    _batch.emplace_back( reinterpret_cast< const char* >( &def ), sizeof( def ) );
+                    _batch.emplace_back( text, size );
+                }
+
+                _batch.push_back( entry );
+            }
+
+            _out.write( _batch );
+        }
+
+    private:
+        int _fd;
+        fd_sink _out;
+        std::vector< std::string_view > _batch;
+        std::deque< entry_header > _formats;   // Stable addresses for the batch
+        std::unordered_set< uint64_t > _known;
+    };
+
+
+    /**
+     * Renders every entry of a binary log through 'fn( std::string_view line )', each line
+     * formatted as the logger would have written it. Returns false when the data is not a
+     * binary log or ends in a torn / corrupt entry (everything before it is delivered).
+     */
+    template< typename Fn >
+    bool decode_binary_log( std::span< const char > data, Fn&& fn )
+    {
+        std::string_view rest( data.data(), data.size() );
+        if ( !rest.starts_with( k_binary_log_magic ) )
+            return false;
+        rest.remove_prefix( k_binary_log_magic.size() );
+
+        std::unordered_map< uint64_t, std::string > formats;
+        std::vector< char > line( 64 * 1024 );
+
+        while ( !rest.empty() )
+        {
+            entry_header header;
+            if ( rest.size() < sizeof( header ) )
+                return false;
+            std::memcpy( &header, rest.data(), sizeof( header ) );
+            if ( rest.size() - sizeof( header ) < header.size )
+                return false;
+
+            auto payload = rest.substr( sizeof( header ), header.size );
+            rest.remove_prefix( sizeof( header ) + header.size );
+
+            switch ( header.kind )
+            {
+            case entry_kind::format:
+                formats[header.format] = payload;
+                break;
+            case entry_kind::text:
+                fn( payload );
+                break;
+
+            case entry_kind::record:
+            {
+                auto format = formats.find( header.format );
+                if ( format == formats.end() )
+                    return false;
+
+                auto args = std::as_bytes( std::span( payload.data(), payload.size() ) );
+                auto size = render_record(
+                    line.data(), line.size(), header.level, format->second.c_str(), args );
+                fn( std::string_view( line.data(), size ) );
+                break;
+            }
+
+            default:
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+}   // namespace sl::logging
+
+#endif /* __BINARY_H_91149B4E50A642BDAC639D38F56AD0B2__ */
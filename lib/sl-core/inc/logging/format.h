@@ -0,0 +1,502 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023-present Robert Anderson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef __FORMAT_H_920ED8A9BF99470CAACCC0112D7DDBDA__
+#define __FORMAT_H_920ED8A9BF99470CAACCC0112D7DDBDA__
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <span>
+#include <string_view>
+#include <type_traits>
+
+namespace sl::logging
+{
+
+    enum class log_level : uint8_t
+    {
+        fatal,
+        error,
+        warning,
+        info,
+        trace,
+    };
+
+    inline const char* level_name( log_level level )
+    {
+        static constexpr std::array< const char*, 5 > levels {
+            "FATAL", "ERROR", "WARNING", "INFO", "TRACE" };
+
+        auto index = static_cast< size_t >( level );
+        return index < levels.size() ? levels[index] : "?";
+    }
+
+
+    enum class entry_kind : uint8_t
+    {
+        text   = 'T',   // A finished line
+        record = 'R',   // A format string (by address / id) plus encoded arguments
+        format = 'F',   // Binary files only: defines the text of a format id
+    };
+
+    /**
+     * Fixed header in front of every queued entry (and every entry of a binary log file).
+     * 'size' counts the payload bytes that follow. For records, 'format' is the address of
+     * the format string, which doubles as its id in binary files.
+     */
+    struct entry_header
+    {
+        entry_kind kind;
+        log_level level;
+        uint16_t reserved;
+        uint32_t size;
+        uint64_t format;
+    };
+
+    static_assert( sizeof( entry_header ) == 16 );
+
+    /**
+     * Argument types that can be captured as raw bytes and formatted later.
+     */
+    template< typename T >
+    concept deferrable_arg = std::is_arithmetic_v< T > || std::is_enum_v< T >
+                             || std::is_pointer_v< T > || std::is_null_pointer_v< T >;
+
+    namespace detail
+    {
+
+        enum class arg_tag : uint8_t
+        {
+            sint,
+            uint,
+            real,
+            str,
+            ptr,
+        };
+
+        constexpr uint16_t k_null_str = 0xFFFF;
+
+        struct arg_writer
+        {
+            std::byte* pos;
+            std::byte* end;
+            bool complete { true };
+
+            bool put( arg_tag tag, const void* value, size_t size )
+            {
+                if ( !complete || static_cast< size_t >( end - pos ) < size + 1 )
+                {
+                    complete = false;
+                    return false;
+                }
+
+                *pos++ = static_cast< std::byte >( tag );
+                std::memcpy( pos, value, size );
+                pos += size;
+                return true;
+            }
+
+            void put_str( const char* s )
+            {
+                if ( !complete || end - pos < 3 )
+                {
+                    complete = false;
+                    return;
+                }
+
+                // Strings are copied (truncated to whatever room is left), not referenced.
+                auto room = std::min< size_t >( static_cast< size_t >( end - pos ) - 3, 0xFFFE );
+                auto len  = s ? static_cast< uint16_t >( strnlen( s, room ) ) : k_null_str;
+
+                *pos++ = static_cast< std::byte >( arg_tag::str );
+                std::memcpy( pos, &len, sizeof( len ) );
+                pos += sizeof( len );
+                if ( s )
+                {
+                    std::memcpy( pos, s, len );
+                    pos += len;
+                }
+            }
+
+            template< typename T >
+            void operator()( T value )
+            {
+                if constexpr ( std::is_same_v< T, const char* > || std::is_same_v< T, char* > )
+                {
+                    put_str( value );
+                }
+                else if constexpr ( std::is_pointer_v< T > || std::is_null_pointer_v< T > )
+                {
+                    auto v = reinterpret_cast< uintptr_t >( static_cast< const void* >( value ) );
+                    put( arg_tag::ptr, &v, sizeof( v ) );
+                }
+                else if constexpr ( std::is_enum_v< T > )
+                {
+                    ( *this )( static_cast< std::underlying_type_t< T > >( value ) );
+                }
+                else if constexpr ( std::is_floating_point_v< T > )
+                {
+                    auto v = static_cast< double >( value );
+                    put( arg_tag::real, &v, sizeof( v ) );
+                }
+                else if constexpr ( std::is_signed_v< T > )
+                {
+                    auto v = static_cast< int64_t >( value );
+                    put( arg_tag::sint, &v, sizeof( v ) );
+                }
+                else
+                {
+                    auto v = static_cast< uint64_t >( value );
+                    put( arg_tag::uint, &v, sizeof( v ) );
+                }
+            }
+        };
+
+        struct arg
+        {
+            arg_tag tag {};
+            union
+            {
+                int64_t i { 0 };
+                uint64_t u;
+                double d;
+            };
+            std::string_view s;
+            bool null_str { false };
+
+            long long as_int() const
+            {
+                return tag == arg_tag::real ? static_cast< long long >( d )
+                                            : static_cast< long long >( i );
+            }
+
+            double as_real() const
+            {
+                switch ( tag )
+                {
+                case arg_tag::real:
+                    return d;
+                case arg_tag::sint:
+                    return static_cast< double >( i );
+                default:
+                    return static_cast< double >( u );
+                }
+            }
+        };
+
+        struct arg_reader
+        {
+            const std::byte* pos;
+            const std::byte* end;
+
+            bool next( arg& out )
+            {
+                if ( pos >= end )
+                    return false;
+
+                out.tag = static_cast< arg_tag >( *pos++ );
+                if ( out.tag == arg_tag::str )
+                {
+                    uint16_t len;
+                    if ( end - pos < 2 )
+                        return false;
+                    std::memcpy( &len, pos, sizeof( len ) );
+                    pos += sizeof( len );
+
+                    out.null_str = len == k_null_str;
+                    len          = out.null_str ? 0 : len;
+                    if ( static_cast< size_t >( end - pos ) < len )
+                        return false;
+
+                    out.s = { reinterpret_cast< const char* >( pos ), len };
+                    pos += len;
+                    return true;
+                }
+
+                if ( end - pos < 8 || out.tag > arg_tag::ptr )
+                    return false;
+
+                std::memcpy( &out.u, pos, sizeof( out.u ) );
+                pos += sizeof( out.u );
+                return true;
+            }
+        };
+
+        struct text_buffer
+        {
+            char* data;
+            size_t cap;   // Includes room for the terminating null
+            size_t len { 0 };
+
+            void append( const char* s, size_t n )
+            {
+                n = std::min( n, cap - 1 - len );
+                std::memcpy( data + len, s, n );
+                len += n;
+                data[len] = '\0';
+            }
+
+            template< typename T >
+            void print( const char* spec, const int* stars, int count, T value )
+            {
+                auto room = cap - len;
+                int n     = 0;
+                switch ( count )
+                {
+                case 0:
+                    n = std::snprintf( data + len, room, spec, value );
+                    break;
+                case 1:
+                    n = std::snprintf( data + len, room, spec, stars[0], value );
+                    break;
+                default:
+                    n = std::snprintf( data + len, room, spec, stars[0], stars[1], value );
+                }
+
+                if ( n > 0 )
+                    len = std::min( len + static_cast< size_t >( n ), cap - 1 );
+            }
+        };
+
+    }   // namespace detail
+
+
+    /**
+     * Encodes printf arguments as tagged raw bytes: integers are widened to 64 bits, floats
+     * to double, pointers to their address and C strings are copied inline. Arguments that
+     * do not fit in 'cap' bytes are left off (and show up unformatted). Returns the number
+     * of bytes written.
+     */
+    template< deferrable_arg... Args >
+    size_t encode_args( std::byte* out, size_t cap, Args... args )
+    {
+        detail::arg_writer writer { out, out + cap };
+        ( writer( args ), ... );
+        return static_cast< size_t >( writer.pos - out );
+    }
+
+    /**
+     * printf-style formatting of 'format' against arguments captured by 'encode_args'. Each
+     * conversion is handed to snprintf on its own, with the stored value converted to the
+     * type the conversion (and its length modifier) expects, so a record decoded on another
+     * machine formats the same. Writes at most 'cap - 1' characters plus a null and returns
+     * the length written.
+     */
+    inline size_t format_args( char* out,
+                               size_t cap,
+                               const char* format,
+                               std::span< const std::byte > args )
+    {
+        if ( cap == 0 )
+            return 0;
+
+        detail::text_buffer buf { out, cap };
+        detail::arg_reader reader { args.data(), args.data() + args.size() };
+        out[0] = '\0';
+
+        const char* p = format;
+        while ( *p )
+        {
+            auto pct = std::strchr( p, '%' );
+            if ( !pct )
+            {
+                buf.append( p, std::strlen( p ) );
+                break;
+            }
+
+            buf.append( p, static_cast< size_t >( pct - p ) );
+            p = pct + 1;
+            if ( *p == '%' )
+            {
+                buf.append( "%", 1 );
+                ++p;
+                continue;
+            }
+
+            // Parse %[flags][width][.precision][length]conversion.
+            bool missing = false;
+            int stars[2];
+            int star_count = 0;
+            auto star      = [&] {
+                detail::arg a {};
+                if ( !reader.next( a ) || a.tag == detail::arg_tag::str )
+                    missing = true;
+                else
+                    stars[star_count++] = static_cast< int >( a.as_int() );
+            };
+
+            while ( *p && std::strchr( "-+ #0'", *p ) )
+                ++p;
+            if ( *p == '*' )
+            {
+                star();
+                ++p;
+            }
+            while ( *p >= '0' && *p <= '9' )
+                ++p;
+            if ( *p == '.' )
+            {
+                ++p;
+                if ( *p == '*' )
+                {
+                    star();
+                    ++p;
+                }
+                while ( *p >= '0' && *p <= '9' )
+                    ++p;
+            }
+
+            auto length_at = p;
+            while ( *p && std::strchr( "hlLqjzt", *p ) )
+                ++p;
+            std::string_view length( length_at, static_cast< size_t >( p - length_at ) );
+
+            const char conv = *p;
+            if ( !conv )
+            {
+                buf.append( pct, std::strlen( pct ) );
+                break;
+            }
+            ++p;
+
+            // Rebuild the spec with a length modifier matching the value we will pass.
+            char spec[48];
+            auto head = static_cast< size_t >( length_at - pct );
+            if ( head + 4 > sizeof( spec ) )
+            {
+                buf.append( pct, static_cast< size_t >( p - pct ) );
+                continue;
+            }
+            std::memcpy( spec, pct, head );
+            auto finish = [&]( std::string_view len ) {
+                std::memcpy( spec + head, len.data(), len.size() );
+                spec[head + len.size()]     = conv;
+                spec[head + len.size() + 1] = '\0';
+            };
+
+            detail::arg a {};
+            if ( conv == 'n' )
+                continue;
+            if ( missing || !std::strchr( "diuoxXcfFeEgGaAsp", conv ) || !reader.next( a ) )
+            {
+                buf.append( pct, static_cast< size_t >( p - pct ) );
+                continue;
+            }
+
+            // A string where a number is expected (or the reverse) would be undefined
+            // behaviour in printf; show a marker instead.
+            if ( ( a.tag == detail::arg_tag::str ) != ( conv == 's' ) )
+            {
+                buf.append( "(?)", 3 );
+                continue;
+            }
+
+            const bool narrow = length.empty() || length == "h" || length == "hh";
+            switch ( conv )
+            {
+            case 'd':
+            case 'i':
+                finish( narrow ? length : "ll" );
+                if ( narrow )
+                    buf.print( spec, stars, star_count, static_cast< int >( a.as_int() ) );
+                else
+                    buf.print( spec, stars, star_count, a.as_int() );
+                break;
+
+            case 'u':
+            case 'o':
+            case 'x':
+            case 'X':
+                finish( narrow ? length : "ll" );
+                using ull = unsigned long long;
+                if ( narrow )
+                    buf.print( spec, stars, star_count, static_cast< unsigned >( a.as_int() ) );
+                else
+                    buf.print( spec, stars, star_count, static_cast< ull >( a.u ) );
+                break;
+
+            case 'c':
+                finish( "" );
+                buf.print( spec, stars, star_count, static_cast< int >( a.as_int() ) );
+                break;
+
+            case 's':
+            {
+                // snprintf needs a terminated string; the payload copy is not.
+                std::array< char, 1024 > str;
+                auto n = std::min( a.s.size(), str.size() - 1 );
+                std::memcpy( str.data(), a.s.data(), n );
+                str[n] = '\0';
+
+                finish( "" );
+                buf.print( spec, stars, star_count, a.null_str ? "(null)" : str.data() );
+                break;
+            }
+
+            case 'p':
+                finish( "" );
+                buf.print( spec, stars, star_count, reinterpret_cast< void* >( a.u ) );
+                break;
+
+            default:   // Floating point conversions
+                finish( length == "L" ? "L" : "" );
+                if ( length == "L" )
+                    buf.print( spec, stars, star_count, static_cast< long double >( a.as_real() ) );
+                else
+                    buf.print( spec, stars, star_count, a.as_real() );
+            }
+        }
+
+        return buf.len;
+    }
+
+    /**
+     * Renders a record as the logger would have written it: "[LEVEL] <formatted>\n". The
+     * result is truncated to 'cap' bytes (no null terminator), keeping the newline.
+     */
+    inline size_t render_record( char* out,
+                                 size_t cap,
+                                 log_level level,
+                                 const char* format,
+                                 std::span< const std::byte > args )
+    {
+        if ( cap < 2 )
+            return 0;
+
+        auto prefix = std::snprintf( out, cap, "[%s] ", level_name( level ) );
+        auto len    = std::min( static_cast< size_t >( std::max( prefix, 0 ) ), cap - 1 );
+
+        // 'format_args' terminates with a null, which the newline then replaces.
+        len      = std::min( len + format_args( out + len, cap - len, format, args ), cap - 1 );
+        out[len] = '\n';
+        return len + 1;
+    }
+
+}   // namespace sl::logging
+
+#endif /* __FORMAT_H_920ED8A9BF99470CAACCC0112D7DDBDA__ */
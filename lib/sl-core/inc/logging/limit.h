@@ -0,0 +1,178 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023-present Robert Anderson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef __LIMIT_H_A5AAF004E6D445D89B61C787E670FE28__
+#define __LIMIT_H_A5AAF004E6D445D89B61C787E670FE28__
+
+#include <time.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include "logger.h"
+
+namespace sl::logging
+{
+
+    namespace detail
+    {
+
+        /**
+         * Cheap monotonic nanoseconds. The coarse Linux clock (tick resolution, no
+         * syscall) is plenty for limits measured in messages per second.
+         */
+        inline uint64_t coarse_now_ns()
+        {
+#if defined( CLOCK_MONOTONIC_COARSE )
+            timespec ts;
+            ::clock_gettime( CLOCK_MONOTONIC_COARSE, &ts );
+            return static_cast< uint64_t >( ts.tv_sec ) * 1'000'000'000ULL
+                   + static_cast< uint64_t >( ts.tv_nsec );
+#else
+            using namespace std::chrono;
+            return static_cast< uint64_t >(
+                duration_cast< nanoseconds >( steady_clock::now().time_since_epoch() ).count() );
+#endif
+        }
+
+    }   // namespace detail
+
+
+    /**
+     * Lock-free token bucket: lets through 'burst' messages back to back, then one every
+     * 1 / 'per_second' seconds. Kept as a single "theoretical arrival time" (the GCRA form
+     * of a token bucket), so a pass costs one CAS and a rejection one counter increment.
+     * Rejections are counted and handed to the next caller let through.
+     */
+    struct rate_limiter
+    {
+    public:
+        constexpr rate_limiter( uint32_t per_second, uint32_t burst = 1 )
+            : _interval { 1'000'000'000ULL / std::max< uint32_t >( per_second, 1 ) }
+            , _tolerance { _interval * ( std::max< uint32_t >( burst, 1 ) - 1 ) }
+        {}
+
+        /**
+         * True when the caller may log. 'suppressed' receives how many calls were turned
+         * away since the last one let through.
+         */
+        bool try_acquire( uint64_t& suppressed )
+        {
+            return try_acquire( suppressed, detail::coarse_now_ns() );
+        }
+
+        bool try_acquire( uint64_t& suppressed, uint64_t now )
+        {
+            auto tat = _tat.load( std::memory_order_relaxed );
+            for ( ;; )
+            {
+                auto base = std::max( tat, now );
+                if ( base - now > _tolerance )
+                {
+                    _suppressed.fetch_add( 1, std::memory_order_relaxed );
+                    return false;
+                }
+
+                auto next = base + _interval;
+                if ( _tat.compare_exchange_weak( tat, next, std::memory_order_relaxed ) )
+                    break;
+            }
+
+            suppressed = _suppressed.load( std::memory_order_relaxed )
+                             ? _suppressed.exchange( 0, std::memory_order_relaxed )
+                             : 0;
+            return true;
+        }
+
+    private:
+        uint64_t _interval;
+        uint64_t _tolerance;
+        std::atomic< uint64_t > _tat { 0 };
+        std::atomic< uint64_t > _suppressed { 0 };
+    };
+
+
+    /**
+     * Lets through the first of every 'every' calls.
+     */
+    struct sampler
+    {
+    public:
+        constexpr explicit sampler( uint32_t every )
+            : _every { std::max< uint32_t >( every, 1 ) }
+        {}
+
+        bool sample() { return _count.fetch_add( 1, std::memory_order_relaxed ) % _every == 0; }
+
+    private:
+        uint64_t _every;
+        std::atomic< uint64_t > _count { 0 };
+    };
+
+}   // namespace sl::logging
+
+/**
+ * Rate limited logging. Each expansion owns a static limiter, so the limit applies per call
+ * site (per instantiation, inside templates). When a line gets through after others were
+ * dropped, a "(suppressed N ...)" line at the same level precedes it. Disabled levels never
+ * touch the limiter.
+ */
+#define SL_LOG_LIMITED_TO( logger, level, per_second, burst, ... )                                 \
+    do                                                                                             \
+    {                                                                                              \
+        static sl::logging::rate_limiter sl_limiter_ { per_second, burst };                        \
+        auto& sl_log_           = ( logger );                                                      \
+        uint64_t sl_suppressed_ = 0;                                                               \
+        if ( sl_log_.enabled( level ) && sl_limiter_.try_acquire( sl_suppressed_ ) )               \
+        {                                                                                          \
+            if ( sl_suppressed_ )                                                                  \
+                sl_log_.log( level,                                                                \
+                             "(suppressed %llu message(s) from this call site)",                   \
+                             static_cast< unsigned long long >( sl_suppressed_ ) );                \
+            sl_log_.log( level, __VA_ARGS__ );                                                     \
+        }                                                                                          \
+    } while ( 0 )
+
+/**
+ * Sampled logging: only the first of every 'n' calls at this call site is logged.
+ */
+#define SL_LOG_SAMPLED_TO( logger, level, n, ... )                                                 \
+    do                                                                                             \
+    {                                                                                              \
+        static sl::logging::sampler sl_sampler_ { n };                                             \
+        auto& sl_log_ = ( logger );                                                                \
+        if ( sl_log_.enabled( level ) && sl_sampler_.sample() )                                    \
+            sl_log_.log( level, __VA_ARGS__ );                                                     \
+    } while ( 0 )
+
+#define SL_LOG_LIMITED( level, per_second, burst, ... )                                            \
+    SL_LOG_LIMITED_TO( sl::logging::default_logger(), level, per_second, burst, __VA_ARGS__ )
+
+#define SL_LOG_SAMPLED( level, n, ... )                                                            \
+    SL_LOG_SAMPLED_TO( sl::logging::default_logger(), level, n, __VA_ARGS__ )
+
+#endif /* __LIMIT_H_A5AAF004E6D445D89B61C787E670FE28__ */
@@ -26,27 +26,41 @@
 #define __LOGGER__72f05cc0_82e2_40ad_8073_d8771df22ef8__
 
 #include <array>
+#include <atomic>
+#include <cstdio>
 #include <fstream>
 #include <iostream>
+#include <stdexcept>
+#include <string_view>
 
-#include <utils/lazy.h>
 #include <utils/noncopyable.h>
 
 #ifndef SL_MAX_LOG_LINE
 #    define SL_MAX_LOG_LINE 512U
 #endif
 
+#define SL_LOG_LEVEL_FATAL   0
+#define SL_LOG_LEVEL_ERROR   1
+#define SL_LOG_LEVEL_WARNING 2
+#define SL_LOG_LEVEL_INFO    3
+#define SL_LOG_LEVEL_TRACE   4
+
+/**
+ * Least severe level compiled in. SL_* macros for levels past it expand to nothing (their
+ * arguments are type checked but never evaluated) and logger calls for them fold away.
+ * Set build wide (see SL_LOG_MIN_LEVEL in sl-core's CMakeLists.txt).
+ */
+#ifndef SL_LOG_MIN_LEVEL
+#    define SL_LOG_MIN_LEVEL SL_LOG_LEVEL_TRACE
+#endif
+
+#include "async.h"
+#include "structured.h"
+
 namespace sl::logging
 {
 
-    enum class log_level
-    {
-        fatal,
-        error,
-        warning,
-        info,
-        trace,
-    };
+    constexpr log_level k_min_level = static_cast< log_level >( SL_LOG_MIN_LEVEL );
 
     struct logger : public sl::utils::noncopyable
     {
@@ -60,25 +74,104 @@ namespace sl::logging
             , _log( _f_log )
         {}
 
-        void log( log_level level, const char* msg )
+        /**
+         * Hands finished lines to an async backend instead of writing (and flushing) them
+         * on the calling thread. The backend must outlive the logger.
+         */
+        explicit logger( async_backend& backend )
+            : _log( std::cout )
+            , _async( &backend )
+        {}
+
+        /**
+         * Re-points the logger at 'backend', or back to its stream / sink when null. Meant
+         * for start-up and shutdown (see set_default_backend): the backend must outlive every
+         * call that may still pick it up.
+         */
+        void attach( async_backend* backend )
         {
-            const std::array< const char*, 5 > levels {
-                "FATAL", "ERROR", "WARNING", "INFO", "TRACE" };
+            _async.store( backend, std::memory_order_release );
+        }
 
-            _log << "[" << levels[static_cast< int >( level )] << "] " << msg << "\n";
-            _log.flush();
+        /**
+         * Hands each line straight to 'out' on the calling thread, leaving buffering and
+         * flushing to the sink (see rotating_file_sink). The sink must outlive the logger.
+         */
+        explicit logger( sink& out )
+            : _log( std::cout )
+            , _sink( &out )
+        {}
+
+        /**
+         * Runtime threshold (defaults to everything compiled in). Lines less severe than
+         * 'level' are skipped before any formatting, at the cost of one relaxed load.
+         */
+        void set_level( log_level level ) { _level.store( level, std::memory_order_relaxed ); }
+        log_level level() const { return _level.load( std::memory_order_relaxed ); }
+
+        bool enabled( log_level level ) const
+        {
+            return level <= k_min_level && level <= _level.load( std::memory_order_relaxed );
+        }
+
+        void log( log_level level, const char* msg )
+        {
+            if ( enabled( level ) )
+                write( level, msg );
         }
 
         template< typename... Args >
         void log( log_level level, const char* format, Args... args )
         {
+            if ( !enabled( level ) )
+                return;
+
+            if constexpr ( ( deferrable_arg< Args > && ... ) )
+            {
+                auto async = _async.load( std::memory_order_acquire );
+                if ( async && async->deferred() )
+                {
+                    async->push( level, format, args... );
+                    return;
+                }
+            }
+
             std::array< char, SL_MAX_LOG_LINE > buf;
 
             auto count = std::snprintf( buf.data(), buf.size(), format, args... );
             if ( count <= 0 )
                 throw std::runtime_error( "error formatting log string" );
 
-            log( level, buf.data() );
+            write( level, buf.data() );
+        }
+
+        /**
+         * Structured record: 'msg' plus 'kv( key, value )' fields, written as one JSON line
+         * (see structured.h) rather than "[LEVEL] text". Encoding uses a stack buffer; there
+         * is no allocation per record.
+         */
+        template< structured_field... Fields >
+        void log( log_level level, const char* msg, Fields... fields )
+        {
+            if ( !enabled( level ) )
+                return;
+
+            std::array< char, async_backend::k_max_line > buf;
+            auto size = encode_json_line( buf.data(), buf.size(), level, msg, fields... );
+            emit( std::string_view( buf.data(), size ) );
+        }
+
+        /**
+         * Waits for queued lines to be written (async mode) or flushes the sink / stream.
+         */
+        void flush()
+        {
+            if ( auto async = _async.load( std::memory_order_acquire ) )
+                async->flush();
+            else if ( _sink )
+                _sink->flush();
+            else
+                _log.flush();
         }
 
         template< typename... Args >
@@ -111,20 +204,125 @@ namespace sl::logging
             log( log_level::trace, format, std::forward< Args >( args )... );
         }
 
+    private:
+        void write( log_level level, const char* msg )
+        {
+            if ( _async.load( std::memory_order_acquire ) || _sink )
+            {
+                std::array< char, async_backend::k_max_line > buf;
+                auto count = std::snprintf(
+                    buf.data(), buf.size(), "[%s] %s\n", level_name( level ), msg );
+                push( buf, count );
+                return;
+            }
+
+            _log << "[" << level_name( level ) << "] " << msg << "\n";
+            _log.flush();
+        }
+
+        void push( std::array< char, async_backend::k_max_line >& buf, int count )
+        {
+            if ( count <= 0 )
+                throw std::runtime_error( "error formatting log string" );
+
+            // Truncated lines still end with a newline.
+            auto size = std::min( static_cast< size_t >( count ), buf.size() - 1 );
+            if ( size < static_cast< size_t >( count ) )
+                buf[size - 1] = '\n';
+
+            emit( std::string_view( buf.data(), size ) );
+        }
+
+        void emit( std::string_view line )
+        {
+            if ( auto async = _async.load( std::memory_order_acquire ) )
+            {
+                async->push( line );
+            }
+            else if ( _sink )
+            {
+                _sink->write( std::span( &line, 1 ) );
+            }
+            else
+            {
+                _log.write( line.data(), static_cast< std::streamsize >( line.size() ) );
+                _log.flush();
+            }
+        }
+
     private:
         std::ofstream _f_log;
         std::ostream& _log;
+        std::atomic< async_backend* > _async { nullptr };
+        sink* _sink { nullptr };
+        std::atomic< log_level > _level { k_min_level };
     };
 
-    inline sl::utils::lazy< logger > s_default {};
+    /**
+     * Process-wide logger behind the SL_* macros, created on first use. Function-local
+     * statics are initialized exactly once even when first used by several threads at once.
+     */
+    inline logger& default_logger()
+    {
+        static logger s_default;
+        return s_default;
+    }
+
+    /**
+     * Routes the SL_* macros through 'backend' instead of writing (and flushing) std::cout
+     * on the calling thread. With a deferred backend they only queue the format address and
+     * raw argument bytes. Install it before other threads start logging, and call
+     * 'clear_default_backend' before destroying it (its destructor writes what is queued).
+     */
+    inline void set_default_backend( async_backend& backend )
+    {
+        default_logger().attach( &backend );
+    }
+
+    inline void clear_default_backend() { default_logger().attach( nullptr ); }
 
 }   // namespace sl::logging
 
-#define SL_LOG( level, ... ) sl::logging::s_default.get().log( level, __VA_ARGS__ );
-#define SL_FATAL( ... )      SL_LOG( sl::logging::log_level::fatal, __VA_ARGS__ );
-#define SL_ERROR( ... )      SL_LOG( sl::logging::log_level::error, __VA_ARGS__ );
-#define SL_WARN( ... )       SL_LOG( sl::logging::log_level::warning, __VA_ARGS__ );
-#define SL_INFO( ... )       SL_LOG( sl::logging::log_level::info, __VA_ARGS__ );
-#define SL_TRACE( ... )      SL_LOG( sl::logging::log_level::trace, __VA_ARGS__ );
+#define SL_LOG( level, ... )                                                                       \
+    do                                                                                             \
+    {                                                                                              \
+        auto& sl_logger_ = sl::logging::default_logger();                                          \
+        if ( sl_logger_.enabled( level ) )                                                         \
+            sl_logger_.log( level, __VA_ARGS__ );                                                  \
+    } while ( 0 )
+
+// Compiled out: arguments are checked but the statement generates no code.
+#define SL_LOG_DISCARD( ... )                                                                      \
+    do                                                                                             \
+    {                                                                                              \
+        if constexpr ( false )                                                                     \
+            sl::logging::default_logger().log( sl::logging::log_level::trace, __VA_ARGS__ );       \
+    } while ( 0 )
+
+#define SL_FATAL( ... ) SL_LOG( sl::logging::log_level::fatal, __VA_ARGS__ )
+
+#if SL_LOG_MIN_LEVEL >= SL_LOG_LEVEL_ERROR
+#    define SL_ERROR( ... ) SL_LOG( sl::logging::log_level::error, __VA_ARGS__ )
+#else
+#    define SL_ERROR( ... ) SL_LOG_DISCARD( __VA_ARGS__ )
+#endif
+
+#if SL_LOG_MIN_LEVEL >= SL_LOG_LEVEL_WARNING
+#    define SL_WARN( ... ) SL_LOG( sl::logging::log_level::warning, __VA_ARGS__ )
+#else
+#    define SL_WARN( ... ) SL_LOG_DISCARD( __VA_ARGS__ )
+#endif
+
+#if SL_LOG_MIN_LEVEL >= SL_LOG_LEVEL_INFO
+#    define SL_INFO( ... ) SL_LOG( sl::logging::log_level::info, __VA_ARGS__ )
+#else
+#    define SL_INFO( ... ) SL_LOG_DISCARD( __VA_ARGS__ )
+#endif
+
+#if SL_LOG_MIN_LEVEL >= SL_LOG_LEVEL_TRACE
+#    define SL_TRACE( ... ) SL_LOG( sl::logging::log_level::trace, __VA_ARGS__ )
+#else
+#    define SL_TRACE( ... ) SL_LOG_DISCARD( __VA_ARGS__ )
+#endif
 
 #endif   //__LOGGER__72f05cc0_82e2_40ad_8073_d8771df22ef8__
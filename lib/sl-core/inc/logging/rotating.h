@@ -0,0 +1,400 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023-present Robert Anderson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef __ROTATING_H_B0DA43CC45EB487C9D945BC6A135FADA__
+#define __ROTATING_H_B0DA43CC45EB487C9D945BC6A135FADA__
+
+#include <errno.h>
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <io/error.h>
+
+#include "sink.h"
+
+extern char** environ;
+
+namespace sl::logging
+{
+
+    /**
+     * Compresses a rotated log file in place (e.g. 'x.log.3' -> 'x.log.3.gz'). Returns
+     * false if the file was left as is.
+     */
+    using log_compressor = std::function< bool( const std::filesystem::path& ) >;
+
+    /**
+     * Runs 'gzip' (found on PATH) on the file and waits for it.
+     */
+    inline bool gzip_compressor( const std::filesystem::path& file )
+    {
+        std::string arg = file.string();
+        char gzip[]     = "gzip";
+        char force[]    = "-f";
+        char* argv[]    = { gzip, force, arg.data(), nullptr };
+
+        pid_t pid;
+        if ( ::posix_spawnp( &pid, "gzip", nullptr, nullptr, argv, environ ) != 0 )
+            return false;
+
+        int status = 0;
+        while ( ::waitpid( pid, &status, 0 ) < 0 )
+        {
+            if ( errno != EINTR )
+                return false;
+        }
+
+        return WIFEXITED( status ) && WEXITSTATUS( status ) == 0;
+    }
+
+    struct rotation_options
+    {
+        size_t max_size { 64 << 20 };              // Rotate before a file grows past this (0: off)
+        std::chrono::milliseconds max_age { 0 };   // Rotate files open longer than this (0: off)
+        size_t max_files { 8 };                    // Rotated files kept; older ones are deleted
+        size_t buffer_size { 1 << 20 };            // User-space write buffer
+        std::chrono::milliseconds flush_interval { 1000 };   // Longest a line sits buffered
+        bool preallocate { true };                           // Reserve 'max_size' up front
+        log_compressor compressor { gzip_compressor };       // Empty: keep rotated files as is
+    };
+
+
+    /**
+     * File sink for long-running processes. Lines collect in a large buffer that is written
+     * when full, on 'flush', or by a background thread once the oldest buffered line is
+     * 'flush_interval' old; there is no per-line syscall. When the file would grow past
+     * 'max_size' (or has been open for 'max_age') it is renamed to '<path>.<n>', with 'n'
+     * increasing, and a fresh file is started. The background thread compresses rotated
+     * files and deletes all but the newest 'max_files'.
+     *
+     * Each file's blocks are reserved up front without changing its size (Linux fallocate
+     * KEEP_SIZE / macOS F_PREALLOCATE), so appends do not fragment; the slack is released
+     * on rotation. Writes are serialized internally, so a synchronous logger may share it
+     * across threads.
+     */
+    struct rotating_file_sink : sink
+    {
+    public:
+        explicit rotating_file_sink( std::filesystem::path path, rotation_options options = {} )
+            : _path { std::move( path ) }
+            , _options { std::move( options ) }
+        {
+            _buffer.reserve( _options.buffer_size );
+            _next = newest_rotation() + 1;
+            open();
+
+            _worker = std::jthread( [this]( std::stop_token stop ) { work( stop ); } );
+        }
+
+        ~rotating_file_sink() noexcept override
+        {
+            _worker.request_stop();
+            _worker.join();
+
+            write_buffer();
+            close();
+        }
+
+        const std::filesystem::path& path() const { return _path; }
+
+        /**
+         * Number of the next rotated file ('<path>.<n>').
+         */
+        size_t next_rotation() const
+        {
+            std::scoped_lock lock( _mutex );
+            return _next;
+        }
+
+        void write( std::span< const std::string_view > lines ) override
+        {
+            std::scoped_lock lock( _mutex );
+
+            if ( _options.max_age.count() > 0 && clock::now() - _opened >= _options.max_age
+                 && _written + _buffer.size() > 0 )
+                rotate();
+
+            for ( auto line : lines )
+            {
+                auto pending = _written + _buffer.size();
+                if ( _options.max_size && pending > 0 && pending + line.size() > _options.max_size )
+                    rotate();
+
+                if ( _buffer.size() + line.size() > _options.buffer_size )
+                    write_buffer();
+
+                if ( line.size() > _options.buffer_size )
+                {
+                    write_all( line.data(), line.size() );
+                    continue;
+                }
+
+                if ( _buffer.empty() )
+                    _buffered_at = clock::now();
+                _buffer.insert( _buffer.end(), line.begin(), line.end() );
+            }
+
+            if ( _options.flush_interval.count() == 0 )
+                write_buffer();
+        }
+
+        void flush() override
+        {
+            std::scoped_lock lock( _mutex );
+            write_buffer();
+        }
+
+        /**
+         * Rotates now (if anything was written), regardless of size or age.
+         */
+        void rotate_now()
+        {
+            std::scoped_lock lock( _mutex );
+            if ( _written + _buffer.size() > 0 )
+                rotate();
+        }
+
+        /**
+         * Blocks until every rotated file queued so far has been compressed and pruned.
+         */
+        void wait_idle()
+        {
+            std::unique_lock lock( _mutex );
+            _idle.wait( lock, [this] { return _pending.empty() && !_busy; } );
+        }
+
+    private:
+        using clock = std::chrono::steady_clock;
+
+        void open()
+        {
+            _fd = ::open( _path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644 );
+            io::error::throw_if( _fd == -1, "c-lib::open", errno, "failed to open log file" );
+
+            struct stat st;
+            _written = ::fstat( _fd, &st ) == 0 ? static_cast< size_t >( st.st_size ) : 0;
+            _opened  = clock::now();
+
+            if ( _options.preallocate && _options.max_size > _written )
+            {
+                // Best effort; not every file system can reserve space.
+#if defined( __linux__ )
+                auto size = static_cast< off_t >( _options.max_size );
+                ::fallocate( _fd, FALLOC_FL_KEEP_SIZE, 0, size );
+#elif defined( __APPLE__ )
+                fstore_t store {
+                    F_ALLOCATEALL, F_PEOFPOSMODE, 0, off_t( _options.max_size - _written ), 0 };
+                ::fcntl( _fd, F_PREALLOCATE, &store );
+#endif
+            }
+        }
+
+        void close()
+        {
+            if ( _fd < 0 )
+                return;
+
+            // Hand back preallocated blocks past the data.
+            if ( _options.preallocate )
+                ::ftruncate( _fd, static_cast< off_t >( _written ) );
+
+            ::close( _fd );
+            _fd = -1;
+        }
+
+        void rotate()
+        {
+            write_buffer();
+            close();
+
+            auto rotated = _path;
+            rotated += "." + std::to_string( _next++ );
+
+            std::error_code ec;
+            std::filesystem::rename( _path, rotated, ec );
+            open();
+
+            if ( !ec )
+            {
+                _pending.push_back( std::move( rotated ) );
+                _wake.notify_one();
+            }
+        }
+
+        void write_buffer()
+        {
+            if ( _buffer.empty() )
+                return;
+
+            write_all( _buffer.data(), _buffer.size() );
+            _buffer.clear();
+        }
+
+        void write_all( const char* data, size_t size )
+        {
+            while ( size > 0 )
+            {
+                auto n = ::write( _fd, data, size );
+                if ( n < 0 && errno == EINTR )
+                    continue;
+                if ( n <= 0 )
+                    return;   // Nowhere left to report a logging failure; drop the data.
+
+                data += n;
+                size -= static_cast< size_t >( n );
+                _written += static_cast< size_t >( n );
+            }
+        }
+
+        /**
+         * Background thread: writes out buffers that have aged past 'flush_interval' and
+         * compresses / prunes rotated files (outside the lock, so logging continues).
+         */
+        void work( std::stop_token stop )
+        {
+            using namespace std::chrono_literals;
+
+            auto interval = _options.flush_interval.count() > 0 ? _options.flush_interval : 1000ms;
+
+            std::unique_lock lock( _mutex );
+            for ( ;; )
+            {
+                _wake.wait_for( lock, stop, std::max( interval / 2, 1ms ), [this] {
+                    return !_pending.empty();
+                } );
+
+                if ( !_buffer.empty() && clock::now() - _buffered_at >= _options.flush_interval )
+                    write_buffer();
+
+                while ( !_pending.empty() )
+                {
+                    auto file = std::move( _pending.front() );
+                    _pending.pop_front();
+                    _busy = true;
+
+                    lock.unlock();
+                    if ( _options.compressor )
+                        _options.compressor( file );
+                    prune();
+                    lock.lock();
+
+                    _busy = false;
+                }
+                _idle.notify_all();
+
+                if ( stop.stop_requested() )
+                    break;
+            }
+        }
+
+        /**
+         * Rotated files of this log, as (number, path), newest first.
+         */
+        std::vector< std::pair< size_t, std::filesystem::path > > rotations() const
+        {
+            std::vector< std::pair< size_t, std::filesystem::path > > found;
+
+            auto dir    = _path.has_parent_path() ? _path.parent_path() : ".";
+            auto prefix = _path.filename().string() + ".";
+
+            std::error_code ec;
+            for ( const auto& entry : std::filesystem::directory_iterator( dir, ec ) )
+            {
+                auto name = entry.path().filename().string();
+                if ( !name.starts_with( prefix ) )
+                    continue;
+
+                // '<name>.<n>' optionally followed by a compressor's extension.
+                auto rest   = std::string_view( name ).substr( prefix.size() );
+                auto digits = std::min( rest.find_first_not_of( "0123456789" ), rest.size() );
+                if ( digits == 0 || ( digits < rest.size() && rest[digits] != '.' ) )
+                    continue;
+
+                found.emplace_back( std::stoull( std::string( rest.substr( 0, digits ) ) ),
+                                    entry.path() );
+            }
+
+            std::sort( found.begin(), found.end(), []( auto& a, auto& b ) {
+                return a.first > b.first;
+            } );
+            return found;
+        }
+
+        size_t newest_rotation() const
+        {
+            auto found = rotations();
+            return found.empty() ? 0 : found.front().first;
+        }
+
+        void prune() const
+        {
+            auto found = rotations();
+            for ( size_t i = _options.max_files; i < found.size(); ++i )
+            {
+                std::error_code ec;
+                std::filesystem::remove( found[i].second, ec );
+            }
+        }
+
+    private:
+        std::filesystem::path _path;
+        rotation_options _options;
+
+        mutable std::mutex _mutex;
+        std::condition_variable_any _wake;
+        std::condition_variable_any _idle;
+
+        int _fd { -1 };
+        size_t _written { 0 };   // Bytes in the current file
+        size_t _next { 1 };      // Number of the next rotated file
+        clock::time_point _opened;
+        clock::time_point _buffered_at;
+        std::vector< char > _buffer;
+
+        std::deque< std::filesystem::path > _pending;   // Rotated, awaiting compression
+        bool _busy { false };
+
+        std::jthread _worker;
+    };
+
+}   // namespace sl::logging
+
+#endif /* __ROTATING_H_B0DA43CC45EB487C9D945BC6A135FADA__ */
@@ -0,0 +1,164 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023-present Robert Anderson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef __SINK_H_307728F8DF6642D6864AD3CC72D98F4B__
+#define __SINK_H_307728F8DF6642D6864AD3CC72D98F4B__
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <ostream>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include <io/error.h>
+#include <utils/noncopyable.h>
+
+namespace sl::logging
+{
+
+    /**
+     * Destination for finished log lines (each already newline terminated). Sinks are
+     * driven by one thread at a time: the async backend's drainer, or a caller holding
+     * whatever lock protects a synchronous logger.
+     */
+    struct sink : sl::utils::noncopyable
+    {
+        virtual ~sink() noexcept = default;
+
+        virtual void write( std::span< const std::string_view > lines ) = 0;
+        virtual void flush() {}
+
+        /**
+         * Binary sinks are handed raw queue entries (an 'entry_header' plus payload, see
+         * format.h) instead of rendered lines.
+         */
+        virtual bool binary() const { return false; }
+    };
+
+
+    /**
+     * Gathers lines straight into 'writev' calls on a file descriptor. There is no
+     * user-space buffering (so nothing to flush); every batch costs one syscall, or a few
+     * past IOV_MAX lines.
+     */
+    struct fd_sink : sink
+    {
+    public:
+        explicit fd_sink( int fd = STDOUT_FILENO )
+            : _fd { fd }
+            , _owned { false }
+        {}
+
+        explicit fd_sink( const char* path )
+            : _fd { ::open( path, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644 ) }
+            , _owned { true }
+        {
+            io::error::throw_if( _fd == -1, "c-lib::open", errno, "failed to open log file" );
+        }
+
+        ~fd_sink() noexcept override
+        {
+            if ( _owned && _fd >= 0 )
+                ::close( _fd );
+        }
+
+        void write( std::span< const std::string_view > lines ) override
+        {
+            constexpr size_t k_max_iov = IOV_MAX < 1024 ? IOV_MAX : 1024;
+
+            _iov.resize( std::min( lines.size(), k_max_iov ) );
+            while ( !lines.empty() )
+            {
+                auto count = std::min( lines.size(), k_max_iov );
+                for ( size_t i = 0; i < count; ++i )
+                    _iov[i] = { const_cast< char* >( lines[i].data() ), lines[i].size() };
+
+                write_all( _iov.data(), static_cast< int >( count ) );
+                lines = lines.subspan( count );
+            }
+        }
+
+    private:
+        void write_all( iovec* iov, int count )
+        {
+            while ( count > 0 )
+            {
+                auto n = ::writev( _fd, iov, count );
+                if ( n < 0 && errno == EINTR )
+                    continue;
+                if ( n < 0 )
+                    return;   // Nowhere left to report a logging failure; drop the batch.
+
+                // Skip what a short write already consumed.
+                auto done = static_cast< size_t >( n );
+                while ( count > 0 && done >= iov->iov_len )
+                {
+                    done -= iov->iov_len;
+                    ++iov;
+                    --count;
+                }
+                if ( count > 0 )
+                {
+                    iov->iov_base = static_cast< char* >( iov->iov_base ) + done;
+                    iov->iov_len -= done;
+                }
+            }
+        }
+
+    private:
+        int _fd;
+        bool _owned;
+        std::vector< iovec > _iov;
+    };
+
+
+    struct ostream_sink : sink
+    {
+    public:
+        explicit ostream_sink( std::ostream& out )
+            : _out { out }
+        {}
+
+        void write( std::span< const std::string_view > lines ) override
+        {
+            for ( auto line : lines )
+                _out.write( line.data(), static_cast< std::streamsize >( line.size() ) );
+        }
+
+        void flush() override { _out.flush(); }
+
+    private:
+        std::ostream& _out;
+    };
+
+}   // namespace sl::logging
+
+#endif /* __SINK_H_307728F8DF6642D6864AD3CC72D98F4B__ */
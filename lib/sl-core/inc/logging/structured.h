@@ -0,0 +1,299 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023-present Robert Anderson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef __STRUCTURED_H_996B7ECEF2E24A0A92A522886BDD4D0E__
+#define __STRUCTURED_H_996B7ECEF2E24A0A92A522886BDD4D0E__
+
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+#include "format.h"
+
+namespace sl::logging
+{
+
+    /**
+     * One key / value pair of a structured record; build with 'kv'. Strings are held by
+     * view, so the referenced data only needs to live until the log call returns.
+     */
+    template< typename T >
+    struct kv_field
+    {
+        std::string_view key;
+        T value;
+    };
+
+    template< typename T >
+    struct is_kv_field : std::false_type
+    {};
+
+    template< typename T >
+    struct is_kv_field< kv_field< T > > : std::true_type
+    {};
+
+    template< typename T >
+    concept structured_field = is_kv_field< T >::value;
+
+    template< typename T >
+    auto kv( std::string_view key, const T& value )
+    {
+        if constexpr ( std::is_null_pointer_v< T > )
+            return kv_field< std::nullptr_t > { key, nullptr };
+        else if constexpr ( std::is_same_v< std::decay_t< T >, const char* >
+                       || std::is_same_v< std::decay_t< T >, char* > )
+            return kv_field< const char* > { key, value };   // May be null
+        else if constexpr ( std::is_convertible_v< const T&, std::string_view > )
+            return kv_field< std::string_view > { key, std::string_view( value ) };
+        else if constexpr ( std::is_enum_v< T > )
+            return kv_field< std::underlying_type_t< T > > {
+                key, static_cast< std::underlying_type_t< T > >( value ) };
+        else
+        {
+            static_assert( std::is_arithmetic_v< T > || std::is_null_pointer_v< T >,
+                           "kv values must be strings, numbers, bools, enums or nullptr" );
+            return kv_field< T > { key, value };
+        }
+    }
+
+
+    /**
+     * Writes one JSON object per line into a caller-provided buffer, with no allocation:
+     *
+     *   {"ts":1700000000123456,"level":"info","msg":"...","key":value,...}\n
+     *
+     * 'ts' is microseconds since the Unix epoch. Numbers use std::to_chars (shortest round
+     * trip form for floating point; NaN / infinity become null) and strings are escaped per
+     * RFC 8259. A field that does not fit is left out entirely and the record gains
+     * "truncated":true, so the line is always valid JSON.
+     */
+    struct json_line_writer
+    {
+    public:
+        json_line_writer( char* out, size_t cap )
+            : _out { out }
+            , _limit { cap > k_reserve ? cap - k_reserve : 0 }
+        {}
+
+        void begin( log_level level, std::string_view msg )
+        {
+            using namespace std::chrono;
+            auto us = duration_cast< microseconds >( system_clock::now().time_since_epoch() );
+
+            _len = 0;
+            put( "{\"ts\":" );
+            put_number( static_cast< int64_t >( us.count() ) );
+            put( ",\"level\":\"" );
+            put( json_level_name( level ) );
+            put( "\"" );
+            field( "msg", msg );
+        }
+
+        template< typename T >
+        void field( std::string_view key, const T& value )
+        {
+            auto mark = _len;
+            _full     = false;
+
+            put( ",\"" );
+            put_escaped( key );
+            put( "\":" );
+            put_value( value );
+
+            if ( _full )
+            {
+                _len       = mark;
+                _truncated = true;
+            }
+        }
+
+        template< typename T >
+        void field( const kv_field< T >& f )
+        {
+            field( f.key, f.value );
+        }
+
+        /**
+         * Closes the object and returns the length of the line (newline included).
+         */
+        size_t finish()
+        {
+            // Room for this tail is held back from '_limit'.
+            auto tail = _truncated ? std::string_view( ",\"truncated\":true}\n" )
+                                   : std::string_view( "}\n" );
+            std::memcpy( _out + _len, tail.data(), tail.size() );
+            return _len + tail.size();
+        }
+
+        bool truncated() const { return _truncated; }
+
+    private:
+        static constexpr size_t k_reserve = std::string_view( ",\"truncated\":true}\n" ).size();
+
+        static const char* json_level_name( log_level level )
+        {
+            static constexpr std::array< const char*, 5 > levels {
+                "fatal", "error", "warning", "info", "trace" };
+
+            auto index = static_cast< size_t >( level );
+            return index < levels.size() ? levels[index] : "unknown";
+        }
+
+        void put( std::string_view s )
+        {
+            if ( _full || _len + s.size() > _limit )
+            {
+                _full = true;
+                return;
+            }
+
+            std::memcpy( _out + _len, s.data(), s.size() );
+            _len += s.size();
+        }
+
+        void put_char( char c )
+        {
+            if ( _full || _len + 1 > _limit )
+            {
+                _full = true;
+                return;
+            }
+            _out[_len++] = c;
+        }
+
+        template< typename T >
+        void put_number( T value )
+        {
+            char buf[32];
+            auto [end, ec] = std::to_chars( buf, buf + sizeof( buf ), value );
+            put( std::string_view( buf, static_cast< size_t >( end - buf ) ) );
+        }
+
+        void put_escaped( std::string_view s )
+        {
+            static constexpr char k_hex[] = "0123456789abcdef";
+
+            // Copy runs that need no escaping in one go.
+            size_t run = 0;
+            for ( size_t i = 0; i < s.size(); ++i )
+            {
+                auto c = static_cast< unsigned char >( s[i] );
+                if ( c >= 0x20 && c != '"' && c != '\\' )
+                    continue;
+
+                put( s.substr( run, i - run ) );
+                run = i + 1;
+
+                switch ( c )
+                {
+                case '"':
+                    put( "\\\"" );
+                    break;
+                case '\\':
+                    put( "\\\\" );
+                    break;
+                case '\n':
+                    put( "\\n" );
+                    break;
+                case '\r':
+                    put( "\\r" );
+                    break;
+                case '\t':
+                    put( "\\t" );
+                    break;
+                case '\b':
+                    put( "\\b" );
+                    break;
+                case '\f':
+                    put( "\\f" );
+                    break;
+                default:
+                {
+                    char u[6] = { '\\', 'u', '0', '0', k_hex[c >> 4], k_hex[c & 0xF] };
+                    put( std::string_view( u, sizeof( u ) ) );
+                }
+                }
+            }
+            put( s.substr( run ) );
+        }
+
+        void put_string( std::string_view s )
+        {
+            put_char( '"' );
+            put_escaped( s );
+            put_char( '"' );
+        }
+
+        template< typename T >
+        void put_value( const T& value )
+        {
+            if constexpr ( std::is_same_v< T, bool > )
+                put( value ? "true" : "false" );
+            else if constexpr ( std::is_null_pointer_v< T > )
+                put( "null" );
+            else if constexpr ( std::is_same_v< T, const char* > )
+                value ? put_string( value ) : put( "null" );
+            else if constexpr ( std::is_same_v< T, std::string_view > )
+                put_string( value );
+            else if constexpr ( std::is_floating_point_v< T > )
+                std::isfinite( value ) ? put_number( value ) : put( "null" );
+            else if constexpr ( std::is_same_v< T, char > )
+                put_string( std::string_view( &value, 1 ) );
+            else
+                put_number( value );
+        }
+
+    private:
+        char* _out;
+        size_t _limit;
+        size_t _len { 0 };
+        bool _full { false };
+        bool _truncated { false };
+    };
+
+    /**
+     * Encodes a full record into 'out' and returns its length (see json_line_writer).
+     */
+    template< structured_field... Fields >
+    size_t encode_json_line( char* out,
+                             size_t cap,
+                             log_level level,
+                             std::string_view msg,
+                             const Fields&... fields )
+    {
+        json_line_writer writer( out, cap );
+        writer.begin( level, msg );
+        ( writer.field( fields ), ... );
+        return writer.finish();
+    }
+
+}   // namespace sl::logging
+
+#endif /* __STRUCTURED_H_996B7ECEF2E24A0A92A522886BDD4D0E__ */
@@ -25,53 +25,185 @@
 #ifndef __MEMORY_ALLOCATOR_H_A9C88781D5F44B93BA58F78A062930D0__
 #define __MEMORY_ALLOCATOR_H_A9C88781D5F44B93BA58F78A062930D0__
 
+#include <cstdlib>
 #include <functional>
 #include <memory>
+#include <new>
+#include <source_location>
+#include <type_traits>
 
 #include <utils/pointers.h>
 
 namespace sl::mem
 {
 
-    struct allocator
+    /**
+     *
+     * Allocation policies supply the raw memory operations for basic_allocator:
+     *
+     *  void* alloc( size_t size ) const noexcept;
+     *  void* realloc( void* ptr, size_t size ) const noexcept;
+     *  void free( void* ptr ) const noexcept;
+     *
+     * Calls are resolved statically, so a policy's backend is inlined into the call site.
+     * An empty (stateless) policy also makes the deleter of 'alloc_sp' results empty,
+     * leaving the returned std::unique_ptr pointer-sized.
+     *
+     **/
+    struct malloc_policy
     {
-        struct raw_functions
+        void* alloc( size_t size ) const noexcept { return std::malloc( size ); }
+        void* realloc( void* ptr, size_t size ) const noexcept { return std::realloc( ptr, size ); }
+        void free( void* ptr ) const noexcept { std::free( ptr ); }
+    };
+
+    /**
+     * Type-erased policy over three callbacks (the original sl::mem::allocator form).
+     **/
+    struct function_policy
+    {
+        function_policy( std::function< void*( size_t ) > alloc,
+                         std::function< void*( void*, size_t ) > realloc,
+                         std::function< void( void* ) > free )
+            : _alloc { std::move( alloc ) }
+            , _realloc { std::move( realloc ) }
+            , _free { std::move( free ) }
+        {}
+
+        /**
+         * Type-erases any other policy (e.g. to hand it to an arena as its upstream).
+         **/
+        template< typename Policy >
+            requires( !std::is_same_v< std::remove_cvref_t< Policy >, function_policy > )
+        function_policy( Policy policy )
+            : _alloc { [policy]( size_t size ) { return policy.alloc( size ); } }
+            , _realloc { [policy]( void* ptr, size_t size ) {
+                return policy.realloc( ptr, size );
+            } }
+            , _free { [policy]( void* ptr ) { policy.free( ptr ); } }
+        {}
+
+        void* alloc( size_t size ) const noexcept { return _alloc( size ); }
+        void* realloc( void* ptr, size_t size ) const noexcept { return _realloc( ptr, size ); }
+        void free( void* ptr ) const noexcept { _free( ptr ); }
+
+    private:
+        std::function< void*( size_t ) > _alloc;
+        std::function< void*( void*, size_t ) > _realloc;
+        std::function< void( void* ) > _free;
+    };
+
+
+    /**
+     * Destroys and frees objects created by 'alloc_sp'. Inheriting the policy lets
+     * the empty base optimization remove it entirely for stateless policies.
+     **/
+    template< typename Policy >
+    struct policy_deleter : private Policy
+    {
+        policy_deleter() = default;
+
+        explicit policy_deleter( const Policy& policy )
+            : Policy { policy }
+        {}
+
+        template< typename T >
+        void operator()( T* t ) const noexcept
         {
-            std::function< void*( size_t ) > alloc;
-            std::function< void*( void*, size_t ) > realloc;
-            std::function< void( void* ) > free;
-        };
+            // Call destructor directly on T first
+            t->~T();
+
+            // Now we can free the memory
+            Policy::free( t );
+        }
+    };
+
+
+    /**
+     * Policies may optionally accept the allocation call site (see mem/tracking.h).
+     **/
+    template< typename Policy >
+    concept located_policy = requires( const Policy& p,
+                                       void* ptr,
+                                       const std::source_location& loc ) {
+        p.alloc( size_t {}, loc );
+        p.realloc( ptr, size_t {}, loc );
+    };
 
-        explicit allocator( raw_functions raw )
-            : _mem( raw )
+
+    template< typename Policy >
+    struct basic_allocator
+    {
+        using policy_type = Policy;
+
+        template< typename T >
+        using unique_ptr = std::unique_ptr< T, policy_deleter< Policy > >;
+
+        explicit basic_allocator( Policy policy = Policy {} )
+            : _policy { std::move( policy ) }
         {}
 
+        const Policy& policy() const noexcept { return _policy; }
+
         /**
          * Raw memory allocations. Returns need to be cast, no management, must free using
          * this same allocator instance.
          **/
-        void* alloc( size_t size ) const noexcept { return _mem.alloc( size ); }
-        void* realloc( void* ptr, size_t size ) const noexcept { return _mem.realloc( ptr, size ); }
-        void free( void* ptr ) const noexcept { _mem.free( ptr ); }
+        void* alloc( size_t size,
+                     const std::source_location& loc
+                     = std::source_location::current() ) const noexcept
+        {
+            if constexpr ( located_policy< Policy > )
+                return _policy.alloc( size, loc );
+            else
+                return _policy.alloc( size );
+        }
+
+        void* realloc( void* ptr,
+                       size_t size,
+                       const std::source_location& loc
+                       = std::source_location::current() ) const noexcept
+        {
+            if constexpr ( located_policy< Policy > )
+                return _policy.realloc( ptr, size, loc );
+            else
+                return _policy.realloc( ptr, size );
+        }
+
+        void free( void* ptr ) const noexcept { _policy.free( ptr ); }
 
         /**
          * Templated allocators for allocating type instances, and returning raw pointers.
+         *
+         * These cannot default the caller's source location (the parameter pack comes last),
+         * so location aware policies must go through 'at().alloc_t< T >( ... )' instead.
          **/
         template< typename T, typename... Args >
-        T* alloc_t( Args... args ) const
+        T* alloc_t( Args&&... args ) const
         {
-            auto mem_free = _mem.free;
+            static_assert( !located_policy< Policy >,
+                           "use alloc.at().alloc_t< T >( ... ) to record the call site" );
+            return alloc_t_at< T >( std::source_location {}, std::forward< Args >( args )... );
+        }
 
-            // Allocate and store the object into a custom std::unique_ptr
-            auto sp = std::unique_ptr< void, decltype( mem_free ) >( _mem.alloc( sizeof( T ) ),
-                                                                     mem_free );
+        template< typename T, typename... Args >
+        T* alloc_t_at( const std::source_location& loc, Args&&... args ) const
+        {
+            auto mem = alloc( sizeof( T ), loc );
+            if ( !mem )
+                throw std::bad_alloc();
 
             // To have the ctor run, we need to perform a placement new here.
-            // If it throws, the unique_ptr should clean up the memory still.
-            new ( sp.get() ) T( std::forward< Args >( args )... );
-
-            // Don't forget to release pointer from unique_ptr so it stays alive
-            return static_cast< T* >( sp.release() );
+            // If it throws, the memory still needs to go back to the policy.
+            try
+            {
+                return new ( mem ) T( std::forward< Args >( args )... );
+            }
+            catch ( ... )
+            {
+                _policy.free( mem );
+                throw;
+            }
         }
 
         /**
@@ -84,44 +216,68 @@ namespace sl::mem
             t->~T();
 
             // Now we can free the memory
-            _mem.free( t );
+            _policy.free( t );
         }
 
         /**
          * Templated allocation of typed values with "custom" unique_ptr returned for de-allocation.
          **/
         template< typename T, typename... Args >
-        auto alloc_sp( Args... args ) const
+        unique_ptr< T > alloc_sp( Args&&... args ) const
         {
-            // The custom deleter for this std::unique_ptr will need to properly
-            // destruct object before freeing memory
-            auto mem_free = _mem.free;
-            auto deleter  = [mem_free]( T* t ) {
-                // Call destructor directly on T first
-                t->~T();
+            static_assert( !located_policy< Policy >,
+                           "use alloc.at().alloc_sp< T >( ... ) to record the call site" );
+            return alloc_sp_at< T >( std::source_location {}, std::forward< Args >( args )... );
+        }
 
-                // Now we can free the memory
-                mem_free( t );
-            };
+        template< typename T, typename... Args >
+        unique_ptr< T > alloc_sp_at( const std::source_location& loc, Args&&... args ) const
+        {
+            return unique_ptr< T >( alloc_t_at< T >( loc, std::forward< Args >( args )... ),
+                                    policy_deleter< Policy > { _policy } );
+        }
 
-            // Allocate and store the object into a custom std::unique_ptr
-            auto sp = std::unique_ptr< void, decltype( mem_free ) >( _mem.alloc( sizeof( T ) ),
-                                                                     mem_free );
+        /**
+         * Binds the caller's source location for the templated allocators, which cannot
+         * default it themselves because of their trailing parameter packs.
+         *
+         * Ex.
+         *  auto f = alloc.at().alloc_t< foo >( 42 );
+         **/
+        struct located
+        {
+            template< typename T, typename... Args >
+            T* alloc_t( Args&&... args ) const
+            {
+                return _alloc.template alloc_t_at< T >( _loc, std::forward< Args >( args )... );
+            }
 
-            // To have the ctor run, we need to perform a placement new here.
-            T* ptr = new ( sp.get() ) T( std::forward< Args >( args )... );
+            template< typename T, typename... Args >
+            unique_ptr< T > alloc_sp( Args&&... args ) const
+            {
+                return _alloc.template alloc_sp_at< T >( _loc, std::forward< Args >( args )... );
+            }
 
-            // Steal the pointer into a new unique_ptr and release the temporary one.
-            auto res = std::unique_ptr< T, decltype( deleter ) >( ptr, deleter );
-            sp.release();
+            const basic_allocator& _alloc;
+            std::source_location _loc;
+        };
 
-            return res;
+        located at( const std::source_location& loc
+                    = std::source_location::current() ) const noexcept
+        {
+            return located { *this, loc };
         }
 
     private:
-        raw_functions _mem;
+        [[no_unique_address]] Policy _policy;
     };
 
+
+    /**
+     * The general purpose, type-erased allocator.
+     **/
+    using allocator = basic_allocator< function_policy >;
+
 }   // namespace sl::mem
 
 #endif /* __MEMORY_ALLOCATOR_H_A9C88781D5F44B93BA58F78A062930D0__ */
@@ -0,0 +1,325 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023-present Robert Anderson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef __ARENA_H_6010974B79A64B23AB1F6ADCD2499E12__
+#define __ARENA_H_6010974B79A64B23AB1F6ADCD2499E12__
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include <mem/allocator.h>
+#include <utils/noncopyable.h>
+
+namespace sl::mem
+{
+
+    /**
+     *
+     * Monotonic (bump) arena. Memory is carved out of large chunks obtained from an
+     * upstream allocator and is only ever given back in bulk, either by rewinding to a
+     * previously taken marker or by resetting the whole arena. Both are O(1); chunks are
+     * retained and reused until the arena itself is destroyed.
+     *
+     * Ex.
+     *  sl::mem::arena a;
+     *  {
+     *      sl::mem::arena::scope _( a );
+     *
+     *      auto alloc = a.allocator();   // sl::mem::basic_allocator< arena::policy >
+     *      auto f     = alloc.alloc_t< foo >( 42 );
+     *      // ...
+     *  }   // everything allocated in the scope is released here
+     *
+     **/
+    struct arena : sl::utils::noncopyable
+    {
+    private:
+        struct chunk
+        {
+            chunk* next;
+            size_t size;
+        };
+
+        static constexpr size_t k_header_size
+            = ( sizeof( chunk ) + alignof( std::max_align_t ) - 1 )
+              & ~( alignof( std::max_align_t ) - 1 );
+
+    public:
+        static constexpr size_t k_default_chunk_size = 64 * 1024;
+
+        /**
+         * Opaque position within the arena. Rewinding to a marker releases everything
+         * allocated after it was taken.
+         **/
+        struct marker
+        {
+            chunk* _chunk;
+            size_t _used;
+        };
+
+        /**
+         * Rewinds the arena to the position it had at construction when the scope exits.
+         **/
+        struct scope : sl::utils::noncopyable
+        {
+            explicit scope( arena& a )
+                : _arena { a }
+                , _marker { a.mark() }
+            {}
+
+            ~scope() noexcept { _arena.rewind( _marker ); }
+
+        private:
+            arena& _arena;
+            marker _marker;
+        };
+
+        explicit arena( size_t chunk_size = k_default_chunk_size )
+            : arena( chunk_size,
+                     mem::allocator( {
+                         []( size_t size ) { return std::malloc( size ); },
+                         []( void* ptr, size_t size ) { return std::realloc( ptr, size ); },
+                         []( void* ptr ) { std::free( ptr ); },
+                     } ) )
+        {}
+
+        explicit arena( size_t chunk_size, mem::allocator upstream )
+            : _upstream { std::move( upstream ) }
+            , _chunk_size { chunk_size }
+            , _head { nullptr }
+            , _current { nullptr }
+            , _used { 0 }
+        {}
+
+        ~arena() noexcept
+        {
+            auto c = _head;
+            while ( c )
+            {
+                auto next = c->next;
+                _upstream.free( c );
+                c = next;
+            }
+
+            _head    = nullptr;
+            _current = nullptr;
+            _used    = 0;
+        }
+
+        /**
+         * Bump allocate 'size' bytes aligned to 'align' (must be a power of 2).
+         * Throws std::bad_alloc if the upstream allocator cannot supply a new chunk.
+         **/
+        void* allocate( size_t size, size_t align = alignof( std::max_align_t ) )
+        {
+            if ( _current )
+            {
+                auto p = aligned_in( _current, _used, size, align );
+                if ( p )
+                    return p;
+            }
+
+            // Walk forward into chunks retained from before a rewind / reset, but only
+            // if the request fits. Otherwise splice in a fresh chunk after the current one.
+            while ( _current && _current->next )
+            {
+                _current = _current->next;
+                _used    = 0;
+
+                auto p = aligned_in( _current, _used, size, align );
+                if ( p )
+                    return p;
+            }
+
+            auto c = new_chunk( std::max( _chunk_size, size + align ) );
+            if ( _current )
+            {
+                c->next        = _current->next;
+                _current->next = c;
+            }
+            else
+            {
+                c->next = _head;
+                _head   = c;
+            }
+
+            _current = c;
+            _used    = 0;
+
+            return aligned_in( _current, _used, size, align );
+        }
+
+        marker mark() const noexcept { return marker { _current, _used }; }
+
+        void rewind( marker m ) noexcept
+        {
+            _current = m._chunk ? m._chunk : _head;
+            _used    = m._chunk ? m._used : 0;
+        }
+
+        void reset() noexcept { rewind( marker { nullptr, 0 } ); }
+
+        /**
+         * Total bytes of chunk memory currently held from the upstream allocator.
+         **/
+        size_t capacity() const noexcept
+        {
+            size_t total = 0;
+            for ( auto c = _head; c; c = c->next )
+                total += c->size;
+            return total;
+        }
+
+        /**
+         * Allocation policy that adapts an arena for sl::mem::basic_allocator. Each block
+         * carries a small size header so 'realloc' works; 'free' only reclaims the most
+         * recent block (LIFO) and is otherwise a no-op. The arena must outlive the policy.
+         **/
+        struct policy
+        {
+            void* alloc( size_t size ) const noexcept { return _arena->block_alloc( size ); }
+            void* realloc( void* ptr, size_t size ) const noexcept
+            {
+                return _arena->block_realloc( ptr, size );
+            }
+            void free( void* ptr ) const noexcept { _arena->block_free( ptr ); }
+
+            arena* _arena;
+        };
+
+        mem::basic_allocator< policy > allocator() noexcept
+        {
+            return mem::basic_allocator< policy >( policy { this } );
+        }
+
+    private:
+        static constexpr size_t k_block_header = alignof( std::max_align_t );
+
+        static unsigned char* data( chunk* c )
+        {
+            return reinterpret_cast< unsigned char* >( c ) + k_header_size;
+        }
+
+        static void* aligned_in( chunk* c, size_t& used, size_t size, size_t align )
+        {
+            auto base    = reinterpret_cast< uintptr_t >( data( c ) );
+            auto aligned = ( base + used + align - 1 ) & ~( static_cast< uintptr_t >( align ) - 1 );
+            auto end     = aligned + size;
+
+            if ( end > base + c->size )
+                return nullptr;
+
+            used = end - base;
+            return reinterpret_cast< void* >( aligned );
+        }
+
+        chunk* new_chunk( size_t size )
+        {
+            auto c = static_cast< chunk* >( _upstream.alloc( k_header_size + size ) );
+            if ( !c )
+                throw std::bad_alloc();
+
+            c->next = nullptr;
+            c->size = size;
+            return c;
+        }
+
+        static size_t& block_size( void* ptr )
+        {
+            return *reinterpret_cast< size_t* >( static_cast< unsigned char* >( ptr )
+                                                 - k_block_header );
+        }
+
+        bool is_top( void* ptr ) const
+        {
+            return _current
+                   && static_cast< unsigned char* >( ptr ) + block_size( ptr )
+                          == data( _current ) + _used;
+        }
+
+        void* block_alloc( size_t size ) noexcept
+        {
+            try
+            {
+                auto p = static_cast< unsigned char* >(
+                             allocate( size + k_block_header, k_block_header ) )
+                         + k_block_header;
+                block_size( p ) = size;
+                return p;
+            }
+            catch ( const std::bad_alloc& )
+            {
+                return nullptr;
+            }
+        }
+
+        void* block_realloc( void* ptr, size_t size ) noexcept
+        {
+            if ( !ptr )
+                return block_alloc( size );
+
+            auto old = block_size( ptr );
+
+            // The most recent block can grow / shrink in place if the chunk has room.
+            if ( is_top( ptr ) )
+            {
+                auto offset = static_cast< unsigned char* >( ptr ) - data( _current );
+                if ( offset + size <= _current->size )
+                {
+                    _used             = offset + size;
+                    block_size( ptr ) = size;
+                    return ptr;
+                }
+            }
+
+            auto p = block_alloc( size );
+            if ( p )
+                std::memcpy( p, ptr, std::min( old, size ) );
+
+            return p;
+        }
+
+        void block_free( void* ptr ) noexcept
+        {
+            if ( !ptr || !is_top( ptr ) )
+                return;
+
+            _used = static_cast< unsigned char* >( ptr ) - k_block_header - data( _current );
+        }
+
+    private:
+        mem::allocator _upstream;
+        size_t _chunk_size;
+        chunk* _head;
+        chunk* _current;
+        size_t _used;
+    };
+
+}   // namespace sl::mem
+
+#endif /* __ARENA_H_6010974B79A64B23AB1F6ADCD2499E12__ */
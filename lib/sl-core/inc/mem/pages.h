@@ -0,0 +1,300 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023-present Robert Anderson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef __PAGES_H_39BE39412CA94545BF566543B4B6D2F7__
+#define __PAGES_H_39BE39412CA94545BF566543B4B6D2F7__
+
+#include <errno.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+#if defined( __linux__ )
+#    include <linux/mempolicy.h>
+#    include <sys/syscall.h>
+#elif !defined( __APPLE__ )
+#    error Page mapping not implememented for the target platform.
+#endif
+
+#include <utils/noncopyable.h>
+
+namespace sl::mem
+{
+
+    enum class page_kind
+    {
+        normal,            // Base (usually 4K) pages
+        transparent_huge,  // Normal mapping advised for transparent huge pages
+        huge_tlb,          // Explicit MAP_HUGETLB mapping from the reserved huge page pool
+    };
+
+    struct page_options
+    {
+        bool huge_pages { true };
+        int numa_node { -1 };   // Bind the region to this node (-1 leaves the policy alone)
+    };
+
+
+    /**
+     *
+     * An anonymous, page-aligned mapping. With huge pages requested, an explicit
+     * MAP_HUGETLB mapping is tried first, then a 2M aligned mapping advised with
+     * MADV_HUGEPAGE, then plain base pages. Binding to a NUMA node uses the raw mbind
+     * syscall (no libnuma); failure to bind is reported through 'numa_bound' only.
+     *
+     **/
+    struct page_region : sl::utils::noncopyable
+    {
+        static constexpr size_t k_huge_page_size = 2 * 1024 * 1024;
+
+        page_region() = default;
+
+        explicit page_region( size_t size, page_options options = {} )
+        {
+            if ( options.huge_pages )
+                map_huge( size );
+
+            if ( !_data )
+                map_normal( size, options.huge_pages );
+
+            if ( _data && options.numa_node >= 0 )
+                _numa_bound = bind( options.numa_node );
+        }
+
+        page_region( page_region&& other ) noexcept { *this = std::move( other ); }
+
+        page_region& operator=( page_region&& other ) noexcept
+        {
+            std::swap( _data, other._data );
+            std::swap( _size, other._size );
+            std::swap( _kind, other._kind );
+            std::swap( _numa_bound, other._numa_bound );
+            return *this;
+        }
+
+        ~page_region() noexcept
+        {
+            if ( _data )
+                ::munmap( _data, _size );   // Any failure (unlikely) is ignored.
+
+            _data = nullptr;
+            _size = 0;
+        }
+
+        explicit operator bool() const noexcept { return _data != nullptr; }
+
+        void* data() const noexcept { return _data; }
+        size_t size() const noexcept { return _size; }
+        page_kind kind() const noexcept { return _kind; }
+        bool numa_bound() const noexcept { return _numa_bound; }
+
+        /**
+         * Hands ownership of the mapping to the caller (unmap with 'size()' bytes).
+         **/
+        void* release() noexcept
+        {
+            auto p = _data;
+            _data  = nullptr;
+            _size  = 0;
+            return p;
+        }
+
+        static size_t base_page_size() noexcept
+        {
+            static const size_t size = static_cast< size_t >( ::sysconf( _SC_PAGESIZE ) );
+            return size;
+        }
+
+    private:
+        static size_t round_up( size_t size, size_t to ) { return ( size + to - 1 ) & ~( to - 1 ); }
+
+        void map_huge( size_t size )
+        {
+#if defined( __linux__ ) && defined( MAP_HUGETLB )
+            auto len = round_up( size, k_huge_page_size );
+            auto p   = ::mmap( nullptr,
+                             len,
+                             PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB,
+                             -1,
+                             0 );
+            if ( p == MAP_FAILED )
+                return;
+
+            _data = p;
+            _size = len;
+            _kind = page_kind::huge_tlb;
+#else
+            (void)size;
+#endif
+        }
+
+        void map_normal( size_t size, bool advise_huge )
+        {
+            auto len = round_up( size, advise_huge ? k_huge_page_size : base_page_size() );
+
+#if defined( __linux__ ) && defined( MADV_HUGEPAGE )
+            if ( advise_huge )
+            {
+                // Over-map so the region can be trimmed to a huge page boundary, which
+                // transparent huge pages need to back it fully.
+                auto p = ::mmap( nullptr,
+                                 len + k_huge_page_size,
+                                 PROT_READ | PROT_WRITE,
+                                 MAP_PRIVATE | MAP_ANONYMOUS,
+                                 -1,
+                                 0 );
+                if ( p == MAP_FAILED )
+                    return;
+
+                auto raw  = reinterpret_cast< uintptr_t >( p );
+                auto base = round_up( raw, k_huge_page_size );
+                if ( base > raw )
+                    ::munmap( p, base - raw );
+                if ( base + len < raw + len + k_huge_page_size )
+                    ::munmap( reinterpret_cast< void* >( base + len ),
+                              raw + len + k_huge_page_size - ( base + len ) );
+
+                _data = reinterpret_cast< void* >( base );
+                _size = len;
+                _kind = ::madvise( _data, _size, MADV_HUGEPAGE ) == 0 ? page_kind::transparent_huge
+                                                                       : page_kind::normal;
+                return;
+            }
+#endif
+
+            auto p = ::mmap(
+                nullptr, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+            if ( p == MAP_FAILED )
+                return;
+
+            _data = p;
+            _size = len;
+            _kind = page_kind::normal;
+        }
+
+        bool bind( int node )
+        {
+#if defined( __linux__ )
+            constexpr size_t k_bits = sizeof( unsigned long ) * 8;
+            unsigned long mask[16] {};
+            if ( static_cast< size_t >( node ) >= k_bits * 16 )
+                return false;
+
+            mask[node / k_bits] = 1UL << ( node % k_bits );
+            return ::syscall( SYS_mbind,
+                              _data,
+                              _size,
+                              MPOL_BIND,
+                              mask,
+                              static_cast< unsigned long >( k_bits * 16 + 1 ),
+                              MPOL_MF_MOVE )
+                   == 0;
+#else
+            (void)node;
+            return false;
+#endif
+        }
+
+    private:
+        void* _data { nullptr };
+        size_t _size { 0 };
+        page_kind _kind { page_kind::normal };
+        bool _numa_bound { false };
+    };
+
+
+    /**
+     * Allocation policy giving every block its own page mapping. Meant for large, long
+     * lived buffers and as the upstream of an arena, not for small objects. Blocks are
+     * offset by a small header (mapping length), so they are max_align_t aligned only.
+     **/
+    struct page_policy
+    {
+        void* alloc( size_t size ) const noexcept
+        {
+            auto region = page_region( size + k_header, options );
+            if ( !region )
+                return nullptr;
+
+            auto len = region.size();
+            auto p   = static_cast< unsigned char* >( region.release() );
+            *reinterpret_cast< size_t* >( p ) = len;
+            return p + k_header;
+        }
+
+        void* realloc( void* ptr, size_t size ) const noexcept
+        {
+            if ( !ptr )
+                return alloc( size );
+
+            auto base = static_cast< unsigned char* >( ptr ) - k_header;
+            auto len  = *reinterpret_cast< size_t* >( base );
+            if ( size + k_header <= len )
+                return ptr;
+
+#if defined( __linux__ )
+            // Grow in place (or move) without copying; huge page mappings may refuse
+            // base page granular sizes, so fall back to a copy in that case.
+            auto new_len = ( size + k_header + page_region::base_page_size() - 1 )
+                           & ~( page_region::base_page_size() - 1 );
+            auto m       = ::mremap( base, len, new_len, MREMAP_MAYMOVE );
+            if ( m != MAP_FAILED )
+            {
+                *static_cast< size_t* >( m ) = new_len;
+                return static_cast< unsigned char* >( m ) + k_header;
+            }
+#endif
+
+            auto p = alloc( size );
+            if ( p )
+            {
+                std::memcpy( p, ptr, len - k_header );
+                free( ptr );
+            }
+            return p;
+        }
+
+        void free( void* ptr ) const noexcept
+        {
+            if ( !ptr )
+                return;
+
+            auto base = static_cast< unsigned char* >( ptr ) - k_header;
+            ::munmap( base, *reinterpret_cast< size_t* >( base ) );
+        }
+
+        page_options options {};
+
+    private:
+        static constexpr size_t k_header = alignof( std::max_align_t );
+    };
+
+}   // namespace sl::mem
+
+#endif /* __PAGES_H_39BE39412CA94545BF566543B4B6D2F7__ */
@@ -0,0 +1,171 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023-present Robert Anderson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef __PMR_H_C749A9D8B1BC42B880D9B32A4853AD32__
+#define __PMR_H_C749A9D8B1BC42B880D9B32A4853AD32__
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory_resource>
+#include <new>
+
+#include <mem/allocator.h>
+
+namespace sl::mem
+{
+
+    /**
+     *
+     * Exposes an sl::mem::basic_allocator as a std::pmr::memory_resource so standard
+     * pmr containers (and ankerl::unordered_dense::pmr maps) can draw from arenas, the
+     * slab, or any other policy.
+     *
+     * Ex.
+     *  sl::mem::arena a;
+     *  sl::mem::resource_adapter res { a.allocator() };
+     *  std::pmr::vector< int > v { &res };
+     *
+     * Policies only guarantee alignof( std::max_align_t ). Stricter requests are served
+     * by over-allocating and stashing the original pointer in front of the aligned block.
+     *
+     **/
+    template< typename Policy >
+    struct resource_adapter : std::pmr::memory_resource
+    {
+        explicit resource_adapter( mem::basic_allocator< Policy > alloc )
+            : _alloc { std::move( alloc ) }
+        {}
+
+        const mem::basic_allocator< Policy >& allocator() const noexcept { return _alloc; }
+
+    private:
+        static constexpr size_t k_natural_align = alignof( std::max_align_t );
+
+        void* do_allocate( size_t bytes, size_t align ) override
+        {
+            if ( align <= k_natural_align )
+            {
+                auto p = _alloc.alloc( bytes );
+                if ( !p )
+                    throw std::bad_alloc();
+                return p;
+            }
+
+            auto raw = _alloc.alloc( bytes + align + sizeof( void* ) );
+            if ( !raw )
+                throw std::bad_alloc();
+
+            auto base    = reinterpret_cast< uintptr_t >( raw ) + sizeof( void* );
+            auto aligned = ( base + align - 1 ) & ~( static_cast< uintptr_t >( align ) - 1 );
+            reinterpret_cast< void** >( aligned )[-1] = raw;
+
+            return reinterpret_cast< void* >( aligned );
+        }
+
+        void do_deallocate( void* p, size_t, size_t align ) override
+        {
+            if ( align <= k_natural_align )
+                _alloc.free( p );
+            else
+                _alloc.free( static_cast< void** >( p )[-1] );
+        }
+
+        bool do_is_equal( const std::pmr::memory_resource& other ) const noexcept override
+        {
+            return this == &other;
+        }
+
+    private:
+        mem::basic_allocator< Policy > _alloc;
+    };
+
+
+    /**
+     * The reverse bridge: an allocation policy drawing from a std::pmr::memory_resource.
+     * A small size header is kept in front of each block because pmr requires the size
+     * on deallocation.
+     **/
+    struct resource_policy
+    {
+        void* alloc( size_t size ) const noexcept
+        {
+            try
+            {
+                auto p = static_cast< unsigned char* >(
+                    _resource->allocate( size + k_header, alignof( std::max_align_t ) ) );
+                *reinterpret_cast< size_t* >( p ) = size;
+                return p + k_header;
+            }
+            catch ( ... )
+            {
+                return nullptr;
+            }
+        }
+
+        void* realloc( void* ptr, size_t size ) const noexcept
+        {
+            if ( !ptr )
+                return alloc( size );
+
+            auto p = alloc( size );
+            if ( p )
+            {
+                std::memcpy( p, ptr, std::min( size_of( ptr ), size ) );
+                free( ptr );
+            }
+
+            return p;
+        }
+
+        void free( void* ptr ) const noexcept
+        {
+            if ( !ptr )
+                return;
+
+            auto p = static_cast< unsigned char* >( ptr ) - k_header;
+            _resource->deallocate( p, size_of( ptr ) + k_header, alignof( std::max_align_t ) );
+        }
+
+        std::pmr::memory_resource* _resource;
+
+    private:
+        static constexpr size_t k_header = alignof( std::max_align_t );
+
+        static size_t size_of( void* ptr )
+        {
+            return *reinterpret_cast< size_t* >( static_cast< unsigned char* >( ptr ) - k_header );
+        }
+    };
+
+    inline mem::basic_allocator< resource_policy >
+    resource_allocator( std::pmr::memory_resource* resource = std::pmr::get_default_resource() )
+    {
+        return mem::basic_allocator< resource_policy >( resource_policy { resource } );
+    }
+
+}   // namespace sl::mem
+
+#endif /* __PMR_H_C749A9D8B1BC42B880D9B32A4853AD32__ */
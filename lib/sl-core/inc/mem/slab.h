@@ -0,0 +1,379 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023-present Robert Anderson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef __SLAB_H_12DC6DA2B7DC4CE6B487172A62542C2A__
+#define __SLAB_H_12DC6DA2B7DC4CE6B487172A62542C2A__
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+
+#include <mem/allocator.h>
+#include <utils/noncopyable.h>
+
+namespace sl::mem
+{
+
+    /**
+     *
+     * Process-wide slab allocator for small objects.
+     *
+     * Requests are rounded up to one of 24 size classes (16 .. 2048 bytes). Objects of a
+     * class are carved out of 64K aligned spans whose header records the class, so 'free'
+     * needs nothing but the pointer. Each thread keeps a small magazine of free objects
+     * per class and only touches the (locked) shared depot to refill or drain half a
+     * magazine at a time. Requests larger than the biggest class get a dedicated span.
+     *
+     * Spans are never returned to the system; the depot only ever grows to the high
+     * water mark of live objects.
+     *
+     **/
+    struct slab : sl::utils::noncopyable
+    {
+        static constexpr size_t k_span_size      = 64 * 1024;
+        static constexpr size_t k_span_header    = 64;
+        static constexpr size_t k_class_count    = 24;
+        static constexpr size_t k_max_class_size = 2048;
+        static constexpr size_t k_magazine_size  = 32;
+
+        /**
+         * Size classes step by 16 bytes up to 128, then by quarter powers of two.
+         **/
+        static constexpr size_t class_index( size_t size ) noexcept
+        {
+            if ( size <= 128 )
+                return ( std::max< size_t >( size, 1 ) + 15 ) / 16 - 1;
+
+            auto group = static_cast< size_t >( std::bit_width( size - 1 ) ) - 8;
+            auto shift = group + 5;
+            return 8 + group * 4 + ( ( size - 1 ) >> shift ) - 4;
+        }
+
+        static constexpr size_t class_size( size_t index ) noexcept
+        {
+            if ( index < 8 )
+                return ( index + 1 ) * 16;
+
+            auto group = ( index - 8 ) / 4;
+            auto step  = ( index - 8 ) % 4;
+            return ( size_t { 128 } << group ) + ( step + 1 ) * ( size_t { 32 } << group );
+        }
+
+        static slab& instance()
+        {
+            // Intentionally immortal so thread caches can still drain into it while
+            // threads (and the process) are tearing down.
+            static slab* s = new slab();
+            return *s;
+        }
+
+        void* alloc( size_t size ) noexcept
+        {
+            if ( size > k_max_class_size )
+                return alloc_large( size );
+
+            return alloc_class( class_index( size ) );
+        }
+
+        void* realloc( void* ptr, size_t size ) noexcept
+        {
+            if ( !ptr )
+                return alloc( size );
+
+            auto s        = span_of( ptr );
+            auto capacity = s->index == k_large ? s->size : class_size( s->index );
+            if ( size <= capacity )
+                return ptr;
+
+            auto p = alloc( size );
+            if ( p )
+            {
+                std::memcpy( p, ptr, capacity );
+                free( ptr );
+            }
+
+            return p;
+        }
+
+        void free( void* ptr ) noexcept
+        {
+            if ( !ptr )
+                return;
+
+            auto s = span_of( ptr );
+            if ( s->index == k_large )
+                std::free( s );
+            else
+                free_class( s->index, ptr );
+        }
+
+        /**
+         * Fast paths for callers that already know the size class (see object_pool).
+         **/
+        void* alloc_class( size_t index ) noexcept
+        {
+            if ( t_cache_gone )
+                return alloc_uncached( index );
+
+            auto& mag = cache().magazines[index];
+            if ( mag.count == 0 && !refill( index, mag ) )
+                return nullptr;
+
+            return mag.items[--mag.count];
+        }
+
+        void free_class( size_t index, void* ptr ) noexcept
+        {
+            if ( t_cache_gone )
+                return free_uncached( index, ptr );
+
+            auto& mag = cache().magazines[index];
+            if ( mag.count == k_magazine_size )
+                drain( index, mag, k_magazine_size / 2 );
+
+            mag.items[mag.count++] = ptr;
+        }
+
+        /**
+         * Stateless allocation policy over the process-wide slab. Smart pointers from
+         * 'alloc_sp' stay pointer-sized.
+         **/
+        struct policy
+        {
+            void* alloc( size_t size ) const noexcept { return slab::instance().alloc( size ); }
+            void* realloc( void* ptr, size_t size ) const noexcept
+            {
+                return slab::instance().realloc( ptr, size );
+            }
+            void free( void* ptr ) const noexcept { slab::instance().free( ptr ); }
+        };
+
+        static mem::basic_allocator< policy > allocator() noexcept
+        {
+            return mem::basic_allocator< policy > {};
+        }
+
+    private:
+        static constexpr uint32_t k_large = ~uint32_t { 0 };
+
+        struct span
+        {
+            uint32_t index;
+            size_t size;
+        };
+
+        static_assert( sizeof( span ) <= k_span_header );
+
+        struct free_node
+        {
+            free_node* next;
+        };
+
+        struct magazine
+        {
+            size_t count;
+            std::array< void*, k_magazine_size > items;
+        };
+
+        struct depot
+        {
+            std::mutex lock;
+            free_node* head { nullptr };
+        };
+
+        struct thread_cache
+        {
+            std::array< magazine, k_class_count > magazines {};
+
+            ~thread_cache() noexcept
+            {
+                t_cache_gone = true;
+                for ( size_t i = 0; i < k_class_count; ++i )
+                    if ( magazines[i].count )
+                        slab::instance().drain( i, magazines[i], magazines[i].count );
+            }
+        };
+
+        // Set once the calling thread's cache has been destroyed. Objects freed later in
+        // thread / process teardown (e.g. owned by other thread_local or static objects)
+        // then go straight to the depot. Trivially destructible, so always safe to read.
+        static inline thread_local bool t_cache_gone = false;
+
+        slab() = default;
+
+        static thread_cache& cache()
+        {
+            thread_local thread_cache c;
+            return c;
+        }
+
+        static span* span_of( void* ptr )
+        {
+            return reinterpret_cast< span* >( reinterpret_cast< uintptr_t >( ptr )
+                                              & ~( uintptr_t { k_span_size } - 1 ) );
+        }
+
+        static void* alloc_large( size_t size ) noexcept
+        {
+            auto total = ( k_span_header + size + k_span_size - 1 ) & ~( k_span_size - 1 );
+            auto s     = static_cast< span* >( std::aligned_alloc( k_span_size, total ) );
+            if ( !s )
+                return nullptr;
+
+            s->index = k_large;
+            s->size  = size;
+            return reinterpret_cast< unsigned char* >( s ) + k_span_header;
+        }
+
+        bool refill( size_t index, magazine& mag ) noexcept
+        {
+            constexpr auto half = k_magazine_size / 2;
+            auto& d             = _depots[index];
+            std::lock_guard _( d.lock );
+
+            while ( d.head && mag.count < half )
+            {
+                mag.items[mag.count++] = d.head;
+                d.head                 = d.head->next;
+            }
+
+            if ( mag.count )
+                return true;
+
+            // Depot is dry, so carve a new span. The first objects go straight into the
+            // magazine (lowest address on top), the remainder into the depot.
+            auto s = static_cast< span* >( std::aligned_alloc( k_span_size, k_span_size ) );
+            if ( !s )
+                return false;
+
+            auto sz    = class_size( index );
+            auto base  = reinterpret_cast< unsigned char* >( s ) + k_span_header;
+            auto count = ( k_span_size - k_span_header ) / sz;
+            auto take  = std::min( count, half );
+
+            s->index = static_cast< uint32_t >( index );
+            s->size  = sz;
+
+            for ( size_t i = take; i-- > 0; )
+                mag.items[mag.count++] = base + i * sz;
+
+            for ( size_t i = count; i-- > take; )
+            {
+                auto node  = reinterpret_cast< free_node* >( base + i * sz );
+                node->next = d.head;
+                d.head     = node;
+            }
+
+            return true;
+        }
+
+        void* alloc_uncached( size_t index ) noexcept
+        {
+            magazine mag {};
+            if ( !refill( index, mag ) )
+                return nullptr;
+
+            auto p = mag.items[--mag.count];
+            if ( mag.count )
+                drain( index, mag, mag.count );
+
+            return p;
+        }
+
+        void free_uncached( size_t index, void* ptr ) noexcept
+        {
+            auto& d = _depots[index];
+            std::lock_guard _( d.lock );
+
+            auto node  = static_cast< free_node* >( ptr );
+            node->next = d.head;
+            d.head     = node;
+        }
+
+        void drain( size_t index, magazine& mag, size_t count ) noexcept
+        {
+            auto& d = _depots[index];
+            std::lock_guard _( d.lock );
+
+            while ( count-- > 0 )
+            {
+                auto node  = static_cast< free_node* >( mag.items[--mag.count] );
+                node->next = d.head;
+                d.head     = node;
+            }
+        }
+
+    private:
+        std::array< depot, k_class_count > _depots;
+    };
+
+    static_assert( slab::class_size( slab::k_class_count - 1 ) == slab::k_max_class_size );
+    static_assert( slab::class_index( slab::k_max_class_size ) == slab::k_class_count - 1 );
+
+
+    /**
+     * Typed front-end over the slab. The size class is resolved at compile time.
+     **/
+    template< typename T >
+    struct object_pool
+    {
+        static_assert( sizeof( T ) <= slab::k_max_class_size, "type too large for slab pooling" );
+        static_assert( alignof( T ) <= alignof( std::max_align_t ), "over-aligned type" );
+
+        static constexpr size_t k_class = slab::class_index( sizeof( T ) );
+
+        template< typename... Args >
+        static T* make( Args&&... args )
+        {
+            auto mem = slab::instance().alloc_class( k_class );
+            if ( !mem )
+                throw std::bad_alloc();
+
+            try
+            {
+                return new ( mem ) T( std::forward< Args >( args )... );
+            }
+            catch ( ... )
+            {
+                slab::instance().free_class( k_class, mem );
+                throw;
+            }
+        }
+
+        static void destroy( T* t ) noexcept
+        {
+            t->~T();
+            slab::instance().free_class( k_class, t );
+        }
+    };
+
+}   // namespace sl::mem
+
+#endif /* __SLAB_H_12DC6DA2B7DC4CE6B487172A62542C2A__ */
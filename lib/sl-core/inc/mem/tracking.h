@@ -0,0 +1,404 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023-present Robert Anderson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef __TRACKING_H_124C66E641574222997A0A0EA11F9DDF__
+#define __TRACKING_H_124C66E641574222997A0A0EA11F9DDF__
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <mutex>
+#include <source_location>
+#include <string_view>
+#include <vector>
+
+#include <mem/allocator.h>
+#include <utils/noncopyable.h>
+
+namespace sl::mem
+{
+
+    /**
+     *
+     * Counters shared by every tracking_policy pointed at it: live / peak bytes, a log2
+     * size histogram and per call site totals. Call sites come from the std::source_location
+     * handed to basic_allocator (use 'alloc.at().alloc_t< T >( ... )' for the templated
+     * allocators).
+     *
+     * The call site table is a fixed, open addressed array of k_max_sites slots, so
+     * recording never allocates. Lookups and counter updates are lock free; only the
+     * first allocation from a new site takes a lock to claim its slot. Once the table is
+     * full, allocations from further sites are only counted as 'untracked'.
+     *
+     **/
+    struct allocation_stats : sl::utils::noncopyable
+    {
+        static constexpr size_t k_histogram_buckets = 32;
+        static constexpr size_t k_max_sites         = 1024;
+        static constexpr uint32_t k_untracked       = ~uint32_t { 0 };
+
+        struct site
+        {
+            std::string_view file;
+            std::string_view function;
+            uint32_t line;
+            uint64_t allocations;
+            uint64_t bytes;
+            uint64_t live_blocks;
+            uint64_t live_bytes;
+        };
+
+        /**
+         * Bucket 'i' counts requests in ( 2^(i-1), 2^i ] bytes; the last bucket is open ended.
+         **/
+        static constexpr size_t bucket( size_t size ) noexcept
+        {
+            auto b = static_cast< size_t >( std::bit_width( size ? size - 1 : 0 ) );
+            return std::min( b, k_histogram_buckets - 1 );
+        }
+
+        uint64_t live_bytes() const noexcept { return _live.load( std::memory_order_relaxed ); }
+        uint64_t peak_bytes() const noexcept { return _peak.load( std::memory_order_relaxed ); }
+        uint64_t allocations() const noexcept { return _allocs.load( std::memory_order_relaxed ); }
+        uint64_t frees() const noexcept { return _frees.load( std::memory_order_relaxed ); }
+
+        /**
+         * Allocations that could not be attributed because the site table was full.
+         **/
+        uint64_t untracked() const noexcept
+        {
+            return _untracked.load( std::memory_order_relaxed );
+        }
+
+        std::array< uint64_t, k_histogram_buckets > histogram() const noexcept
+        {
+            std::array< uint64_t, k_histogram_buckets > h;
+            for ( size_t i = 0; i < k_histogram_buckets; ++i )
+                h[i] = _histogram[i].load( std::memory_order_relaxed );
+            return h;
+        }
+
+        /**
+         * Snapshot of all call sites, largest live footprint first.
+         **/
+        std::vector< site > sites() const
+        {
+            std::vector< site > res;
+            for ( const auto& e : _sites )
+            {
+                if ( !e.used.load( std::memory_order_acquire ) )
+                    continue;
+
+                res.push_back( site { e.file,
+                                      e.function,
+                                      e.line,
+                                      e.allocations.load( std::memory_order_relaxed ),
+                                      e.bytes.load( std::memory_order_relaxed ),
+                                      e.live_blocks.load( std::memory_order_relaxed ),
+                                      e.live_bytes.load( std::memory_order_relaxed ) } );
+            }
+
+            std::sort( std::begin( res ), std::end( res ), []( const site& a, const site& b ) {
+                return a.live_bytes != b.live_bytes ? a.live_bytes > b.live_bytes
+                                                    : a.bytes > b.bytes;
+            } );
+            return res;
+        }
+
+        template< typename Logger >
+        void log( Logger& logger, const char* name, size_t top_sites = 10 ) const
+        {
+            using ull = unsigned long long;
+
+            logger.info( "[mem:%s] live: %llu bytes, peak: %llu bytes, allocs: %llu, frees: %llu",
+                         name,
+                         static_cast< ull >( live_bytes() ),
+                         static_cast< ull >( peak_bytes() ),
+                         static_cast< ull >( allocations() ),
+                         static_cast< ull >( frees() ) );
+
+            auto h = histogram();
+            for ( size_t i = 0; i < k_histogram_buckets; ++i )
+                if ( h[i] )
+                    logger.info( "[mem:%s]   <= %llu bytes: %llu",
+                                 name,
+                                 static_cast< ull >( uint64_t { 1 } << i ),
+                                 static_cast< ull >( h[i] ) );
+
+            auto all = sites();
+            for ( size_t i = 0; i < std::min( top_sites, all.size() ); ++i )
+            {
+                const auto& s = all[i];
+                logger.info( "[mem:%s]   %.*s:%u (%.*s) live: %llu bytes / %llu blocks, "
+                             "total: %llu bytes / %llu allocs",
+                             name,
+                             static_cast< int >( s.file.size() ),
+                             s.file.data(),
+                             s.line,
+                             static_cast< int >( s.function.size() ),
+                             s.function.data(),
+                             static_cast< ull >( s.live_bytes ),
+                             static_cast< ull >( s.live_blocks ),
+                             static_cast< ull >( s.bytes ),
+                             static_cast< ull >( s.allocations ) );
+            }
+
+            if ( auto u = untracked() )
+                logger.info( "[mem:%s]   untracked sites: %llu allocs",
+                             name,
+                             static_cast< ull >( u ) );
+        }
+
+        uint32_t record_alloc( size_t size, const std::source_location& loc ) noexcept
+        {
+            _allocs.fetch_add( 1, std::memory_order_relaxed );
+            _histogram[bucket( size )].fetch_add( 1, std::memory_order_relaxed );
+
+            auto live = _live.fetch_add( size, std::memory_order_relaxed ) + size;
+            auto peak = _peak.load( std::memory_order_relaxed );
+            while ( live > peak
+                    && !_peak.compare_exchange_weak( peak, live, std::memory_order_relaxed ) )
+                ;
+
+            auto index = find_site( loc );
+            if ( index == k_untracked )
+            {
+                _untracked.fetch_add( 1, std::memory_order_relaxed );
+                return index;
+            }
+
+            auto& s = _sites[index];
+            s.allocations.fetch_add( 1, std::memory_order_relaxed );
+            s.bytes.fetch_add( size, std::memory_order_relaxed );
+            s.live_blocks.fetch_add( 1, std::memory_order_relaxed );
+            s.live_bytes.fetch_add( size, std::memory_order_relaxed );
+
+            return index;
+        }
+
+        void record_free( size_t size, uint32_t site_index ) noexcept
+        {
+            _frees.fetch_add( 1, std::memory_order_relaxed );
+            _live.fetch_sub( size, std::memory_order_relaxed );
+
+            if ( site_index == k_untracked )
+                return;
+
+            auto& s = _sites[site_index];
+            s.live_blocks.fetch_sub( 1, std::memory_order_relaxed );
+            s.live_bytes.fetch_sub( size, std::memory_order_relaxed );
+        }
+
+    private:
+        /**
+         * Identity fields are written once, before 'used' is published (under _claim), and
+         * are immutable afterwards, so readers only need an acquire load of 'used'.
+         **/
+        struct slot
+        {
+            std::atomic< bool > used { false };
+            std::string_view file;
+            std::string_view function;
+            uint32_t line { 0 };
+            uint32_t column { 0 };
+
+            std::atomic< uint64_t > allocations { 0 };
+            std::atomic< uint64_t > bytes { 0 };
+            std::atomic< uint64_t > live_blocks { 0 };
+            std::atomic< uint64_t > live_bytes { 0 };
+
+            bool matches( const std::source_location& loc ) const noexcept
+            {
+                return line == loc.line() && column == loc.column()
+                       && file == std::string_view { loc.file_name() };
+            }
+        };
+
+        static size_t home( const std::source_location& loc ) noexcept
+        {
+            auto h = ( uint64_t { loc.line() } << 16 ) ^ loc.column();
+            return static_cast< size_t >( h * 0x9e3779b97f4a7c15ull >> 32 ) % k_max_sites;
+        }
+
+        /**
+         * Probes from the site's home slot. Returns k_untracked if the table is full.
+         **/
+        uint32_t find_site( const std::source_location& loc ) noexcept
+        {
+            auto start = home( loc );
+            for ( size_t n = 0; n < k_max_sites; ++n )
+            {
+                auto i = ( start + n ) % k_max_sites;
+                if ( !_sites[i].used.load( std::memory_order_acquire ) )
+                    return claim_site( loc, i );
+
+                if ( _sites[i].matches( loc ) )
+                    return static_cast< uint32_t >( i );
+            }
+
+            return k_untracked;
+        }
+
+        /**
+         * Slow path for a site not seen yet; 'from' is the first free slot seen while probing.
+         **/
+        uint32_t claim_site( const std::source_location& loc, size_t from ) noexcept
+        {
+            std::lock_guard _( _claim );
+
+            for ( size_t n = 0; n < k_max_sites; ++n )
+            {
+                auto i  = ( from + n ) % k_max_sites;
+                auto& s = _sites[i];
+                if ( s.used.load( std::memory_order_relaxed ) )
+                {
+                    // Another thread may have claimed this site since the lock free probe.
+                    if ( s.matches( loc ) )
+                        return static_cast< uint32_t >( i );
+                    continue;
+                }
+
+                s.file     = loc.file_name();
+                s.function = loc.function_name();
+                s.line     = loc.line();
+                s.column   = loc.column();
+                s.used.store( true, std::memory_order_release );
+                return static_cast< uint32_t >( i );
+            }
+
+            return k_untracked;
+        }
+
+        std::atomic< uint64_t > _live { 0 };
+        std::atomic< uint64_t > _peak { 0 };
+        std::atomic< uint64_t > _allocs { 0 };
+        std::atomic< uint64_t > _frees { 0 };
+        std::atomic< uint64_t > _untracked { 0 };
+        std::array< std::atomic< uint64_t >, k_histogram_buckets > _histogram {};
+
+        std::mutex _claim;
+        std::array< slot, k_max_sites > _sites {};
+    };
+
+
+    /**
+     * Decorates another policy, prefixing each block with a small header (size + call
+     * site) and reporting every operation to an allocation_stats instance.
+     **/
+    template< typename Inner >
+    struct tracking_policy
+    {
+        explicit tracking_policy( allocation_stats& stats, Inner inner = Inner {} )
+            : _inner { std::move( inner ) }
+            , _stats { &stats }
+        {}
+
+        void* alloc( size_t size ) const noexcept { return alloc( size, std::source_location {} ); }
+
+        void* alloc( size_t size, const std::source_location& loc ) const noexcept
+        {
+            auto h = static_cast< header* >( _inner.alloc( size + k_header ) );
+            if ( !h )
+                return nullptr;
+
+            h->size = size;
+            h->site = _stats->record_alloc( size, loc );
+            return reinterpret_cast< unsigned char* >( h ) + k_header;
+        }
+
+        void* realloc( void* ptr, size_t size ) const noexcept
+        {
+            return realloc( ptr, size, std::source_location {} );
+        }
+
+        void* realloc( void* ptr, size_t size, const std::source_location& loc ) const noexcept
+        {
+            if ( !ptr )
+                return alloc( size, loc );
+
+            auto old = *header_of( ptr );
+            auto h = static_cast< header* >( _inner.realloc( header_of( ptr ), size + k_header ) );
+            if ( !h )
+                return nullptr;
+
+            _stats->record_free( old.size, old.site );
+            h->size = size;
+            h->site = _stats->record_alloc( size, loc );
+            return reinterpret_cast< unsigned char* >( h ) + k_header;
+        }
+
+        void free( void* ptr ) const noexcept
+        {
+            if ( !ptr )
+                return;
+
+            auto h = header_of( ptr );
+            _stats->record_free( h->size, h->site );
+            _inner.free( h );
+        }
+
+    private:
+        struct header
+        {
+            size_t size;
+            uint32_t site;
+        };
+
+        static constexpr size_t k_header = alignof( std::max_align_t );
+        static_assert( sizeof( header ) <= k_header );
+
+        static header* header_of( void* ptr )
+        {
+            return reinterpret_cast< header* >( static_cast< unsigned char* >( ptr ) - k_header );
+        }
+
+    private:
+        [[no_unique_address]] Inner _inner;
+        allocation_stats* _stats;
+    };
+
+
+    /**
+     * Wraps 'inner' in a tracking_policy only when SL_MEM_TRACKING is defined. Otherwise
+     * the policy is returned untouched and the stats are never referenced.
+     *
+     * Ex.
+     *  sl::mem::allocation_stats stats;
+     *  sl::mem::basic_allocator alloc { sl::mem::track( stats, sl::mem::slab::policy {} ) };
+     **/
+    template< typename Inner >
+    auto track( [[maybe_unused]] allocation_stats& stats, Inner inner = Inner {} )
+    {
+#if defined( SL_MEM_TRACKING )
+        return tracking_policy< Inner > { stats, std::move( inner ) };
+#else
+        return inner;
+#endif
+    }
+
+}   // namespace sl::mem
+
+#endif /* __TRACKING_H_124C66E641574222997A0A0EA11F9DDF__ */
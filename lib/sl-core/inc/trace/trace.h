@@ -0,0 +1,495 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023-present Robert Anderson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+
+#ifndef __TRACE_H_9F0603831B9448058918FD8D1EFC80DC__
+#define __TRACE_H_9F0603831B9448058918FD8D1EFC80DC__
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#if ( defined( __x86_64__ ) || defined( __i386__ ) ) \
+    && ( defined( __GNUC__ ) || defined( __clang__ ) )
+#    include <cpuid.h>
+#    include <x86intrin.h>
+#    define SL_TRACE_TSC 1
+#endif
+
+/**
+ * Compile the trace macros out entirely with SL_TRACING_ENABLED=0. When compiled in, a
+ * trace point costs one relaxed load until tracing is started.
+ */
+#ifndef SL_TRACING_ENABLED
+#    define SL_TRACING_ENABLED 1
+#endif
+
+/**
+ * Events kept per thread. Each thread records into its own ring and overwrites the oldest
+ * events once full, so a long run keeps the most recent window.
+ */
+#ifndef SL_TRACE_BUFFER_EVENTS
+#    define SL_TRACE_BUFFER_EVENTS 16384
+#endif
+
+namespace sl::trace
+{
+
+    enum class event_type : uint8_t
+    {
+        complete = 'X',
+        instant  = 'i',
+        counter  = 'C',
+    };
+
+    /**
+     * One recorded event. Names and categories are not copied, so they must be string
+     * literals (or otherwise outlive the export). Timestamps are raw clock ticks; 'value'
+     * holds the duration in ticks for spans and the bits of a double for counters.
+     */
+    struct event
+    {
+        uint64_t start;
+        uint64_t value;
+        const char* category;
+        const char* name;
+        event_type type;
+    };
+
+    /**
+     * An exported event, converted to microseconds since the trace clock epoch.
+     */
+    struct record
+    {
+        uint32_t tid;
+        event_type type;
+        const char* category;
+        const char* name;
+        double ts_us;
+        double dur_us;
+        double value;
+    };
+
+    namespace detail
+    {
+
+        inline uint64_t steady_ns()
+        {
+            using namespace std::chrono;
+            return static_cast< uint64_t >(
+                duration_cast< nanoseconds >( steady_clock::now().time_since_epoch() ).count() );
+        }
+
+        /**
+         * The TSC is only usable as a clock when it is invariant (constant rate across
+         * P-states and synchronized across cores). Anything else falls back to steady_clock.
+         */
+        inline bool detect_invariant_tsc()
+        {
+#if defined( SL_TRACE_TSC )
+            unsigned int eax, ebx, ecx, edx;
+            if ( __get_cpuid( 0x80000000, &eax, &ebx, &ecx, &edx ) && eax >= 0x80000007
+                 && __get_cpuid( 0x80000007, &eax, &ebx, &ecx, &edx ) )
+                return ( edx & ( 1u << 8 ) ) != 0;
+#endif
+            return false;
+        }
+
+        inline const bool use_tsc = detect_invariant_tsc();
+
+        inline uint64_t now()
+        {
+#if defined( SL_TRACE_TSC )
+            if ( use_tsc )
+                return __rdtsc();
+#endif
+            return steady_ns();
+        }
+
+        struct clock_point
+        {
+            uint64_t ticks;
+            uint64_t ns;
+        };
+
+        /**
+         * Taken at static initialization; exported timestamps are relative to it, and the
+         * ticks it pairs with steady_clock calibrate the TSC rate at export time.
+         */
+        inline const clock_point epoch { now(), steady_ns() };
+
+        inline double ticks_per_us()
+        {
+            if ( !use_tsc )
+                return 1000.0;
+
+            clock_point at { now(), steady_ns() };
+            if ( at.ns - epoch.ns < 50'000'000 )
+            {
+                std::this_thread::sleep_for( std::chrono::milliseconds( 50 ) );
+                at = { now(), steady_ns() };
+            }
+            return double( at.ticks - epoch.ticks ) * 1000.0 / double( at.ns - epoch.ns );
+        }
+
+        /**
+         * Single writer ring owned by one thread. The head is published with release so
+         * an exporter can read it while the owner keeps recording; slots the owner may have
+         * overwritten during the copy are dropped by re-reading the head afterwards.
+         */
+        struct thread_buffer
+        {
+            thread_buffer( size_t capacity, uint32_t id )
+                : events { std::make_unique< event[] >( capacity ) }
+                , mask { capacity - 1 }
+                , tid { id }
+            {}
+
+            void push( const event& e ) noexcept
+            {
+                const auto h     = head.load( std::memory_order_relaxed );
+                events[h & mask] = e;
+                head.store( h + 1, std::memory_order_release );
+            }
+
+            std::unique_ptr< event[] > events;
+            size_t mask;
+            uint32_t tid;
+            std::atomic< uint64_t > head { 0 };
+            std::string name;   // Guarded by the registry mutex
+        };
+
+        struct registry
+        {
+            std::mutex mutex;
+            std::vector< std::shared_ptr< thread_buffer > > buffers;
+            size_t capacity = std::bit_ceil< size_t >( SL_TRACE_BUFFER_EVENTS );
+            uint32_t next_tid = 1;
+        };
+
+        inline registry& get_registry()
+        {
+            static registry r;
+            return r;
+        }
+
+        inline std::atomic< bool > active { false };
+
+        inline thread_buffer& local_buffer()
+        {
+            // The registry keeps the buffer alive after the thread exits so its events
+            // still export; the thread only caches a raw pointer.
+            thread_local thread_buffer* buffer = [] {
+                auto& r = get_registry();
+                std::lock_guard lock { r.mutex };
+                auto b = std::make_shared< thread_buffer >( r.capacity, r.next_tid++ );
+                r.buffers.push_back( b );
+                return b.get();
+            }();
+            return *buffer;
+        }
+
+        inline void write_json_string( std::ostream& out, std::string_view s )
+        {
+            out.put( '"' );
+            for ( char c : s )
+            {
+                if ( c == '"' || c == '\\' )
+                {
+                    out.put( '\\' );
+                    out.put( c );
+                }
+                else if ( static_cast< unsigned char >( c ) < 0x20 )
+                {
+                    char esc[8];
+                    std::snprintf( esc, sizeof( esc ), "\\u%04x", c );
+                    out << esc;
+                }
+                else
+                {
+                    out.put( c );
+                }
+            }
+            out.put( '"' );
+        }
+
+    }   // namespace detail
+
+
+    /**
+     * Tracing is off until started; trace points reached while stopped record nothing.
+     */
+    inline void start() noexcept { detail::active.store( true, std::memory_order_relaxed ); }
+    inline void stop() noexcept { detail::active.store( false, std::memory_order_relaxed ); }
+    inline bool active() noexcept { return detail::active.load( std::memory_order_relaxed ); }
+
+    /**
+     * Ring size (rounded up to a power of two) for threads that record their first event
+     * after this call. Existing buffers keep their size.
+     */
+    inline void set_buffer_capacity( size_t events )
+    {
+        auto& r = detail::get_registry();
+        std::lock_guard lock { r.mutex };
+        r.capacity = std::bit_ceil( std::max< size_t >( events, 2 ) );
+    }
+
+    /**
+     * Names the calling thread in exported traces.
+     */
+    inline void set_thread_name( std::string_view name )
+    {
+        auto& b = detail::local_buffer();
+        std::lock_guard lock { detail::get_registry().mutex };
+        b.name = name;
+    }
+
+    /**
+     * Drops everything recorded so far. Only safe while no thread is recording (e.g.
+     * after stop() once workers are idle).
+     */
+    inline void clear()
+    {
+        auto& r = detail::get_registry();
+        std::lock_guard lock { r.mutex };
+        for ( auto& b : r.buffers )
+            b->head.store( 0, std::memory_order_relaxed );
+    }
+
+    inline void instant( const char* category, const char* name ) noexcept
+    {
+        if ( active() )
+            detail::local_buffer().push(
+                { detail::now(), 0, category, name, event_type::instant } );
+    }
+
+    inline void counter( const char* category, const char* name, double value ) noexcept
+    {
+        if ( active() )
+            detail::local_buffer().push( { detail::now(),
+                                           std::bit_cast< uint64_t >( value ),
+                                           category,
+                                           name,
+                                           event_type::counter } );
+    }
+
+
+    /**
+     * Scoped span, recorded as a single complete event when it ends. 'next' ends the
+     * current span and opens another in its place, which suits a sequence of phases.
+     */
+    struct span
+    {
+    public:
+        span( const char* category, const char* name ) noexcept
+            : _category { category }
+            , _name { name }
+            , _start { active() ? detail::now() : 0 }
+        {}
+
+        ~span() { end(); }
+
+        span( const span& )            = delete;
+        span& operator=( const span& ) = delete;
+
+        void end() noexcept
+        {
+            if ( _start == 0 )
+                return;
+
+            const auto now = detail::now();
+            detail::local_buffer().push(
+                { _start, now - _start, _category, _name, event_type::complete } );
+            _start = 0;
+        }
+
+        void next( const char* name ) noexcept
+        {
+            end();
+            _name  = name;
+            _start = active() ? detail::now() : 0;
+        }
+
+    private:
+        const char* _category;
+        const char* _name;
+        uint64_t _start;
+    };
+
+
+    /**
+     * Calls 'fn' with every event still held in the thread buffers, oldest first per
+     * thread. Safe to call while other threads keep recording.
+     */
+    template< typename Fn >
+    void for_each_record( Fn&& fn )
+    {
+        std::vector< std::shared_ptr< detail::thread_buffer > > buffers;
+        {
+            auto& r = detail::get_registry();
+            std::lock_guard lock { r.mutex };
+            buffers = r.buffers;
+        }
+
+        const auto per_us = detail::ticks_per_us();
+        const auto to_us  = [per_us]( uint64_t t ) {
+            return ( double( t ) - double( detail::epoch.ticks ) ) / per_us;
+        };
+
+        std::vector< event > copy;
+        for ( const auto& b : buffers )
+        {
+            const auto capacity = b->mask + 1;
+            const auto head     = b->head.load( std::memory_order_acquire );
+            const auto first    = head > capacity ? head - capacity : 0;
+
+            copy.clear();
+            for ( auto i = first; i < head; ++i )
+                copy.push_back( b->events[i & b->mask] );
+
+            // Anything the owner may have lapped while we copied is unreliable
+            const auto after = b->head.load( std::memory_order_acquire );
+            const auto valid = after > capacity ? after - capacity : 0;
+
+            for ( auto i = std::max( first, valid ); i < head; ++i )
+            {
+                const auto& e = copy[i - first];
+                record rec { b->tid, e.type, e.category, e.name, to_us( e.start ), 0, 0 };
+                if ( e.type == event_type::complete )
+                    rec.dur_us = double( e.value ) / per_us;
+                else if ( e.type == event_type::counter )
+                    rec.value = std::bit_cast< double >( e.value );
+                fn( rec );
+            }
+        }
+    }
+
+    /**
+     * Writes the recorded events as Chrome trace-event JSON, loadable in chrome://tracing
+     * or Perfetto.
+     */
+    inline void write_chrome_json( std::ostream& out )
+    {
+        const auto pid = ::getpid();
+        bool first     = true;
+        auto separator = [&] {
+            if ( !first )
+                out << ",\n";
+            first = false;
+        };
+
+        out << "{\"traceEvents\":[\n";
+        {
+            auto& r = detail::get_registry();
+            std::lock_guard lock { r.mutex };
+            for ( const auto& b : r.buffers )
+            {
+                if ( b->name.empty() )
+                    continue;
+                separator();
+                out << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":" << pid
+                    << ",\"tid\":" << b->tid << ",\"args\":{\"name\":";
+                detail::write_json_string( out, b->name );
+                out << "}}";
+            }
+        }
+
+        char num[32];
+        auto write_num = [&]( double v ) {
+            std::snprintf( num, sizeof( num ), "%.3f", v );
+            out << num;
+        };
+
+        for_each_record( [&]( const record& r ) {
+            separator();
+            out << "{\"ph\":\"" << char( r.type ) << "\",\"cat\":";
+            detail::write_json_string( out, r.category );
+            out << ",\"name\":";
+            detail::write_json_string( out, r.name );
+            out << ",\"pid\":" << pid << ",\"tid\":" << r.tid << ",\"ts\":";
+            write_num( r.ts_us );
+            if ( r.type == event_type::complete )
+            {
+                out << ",\"dur\":";
+                write_num( r.dur_us );
+            }
+            else if ( r.type == event_type::counter )
+            {
+                out << ",\"args\":{\"value\":";
+                write_num( r.value );
+                out << "}";
+            }
+            else
+            {
+                out << ",\"s\":\"t\"";
+            }
+            out << "}";
+        } );
+        out << "\n]}\n";
+    }
+
+    inline bool write_chrome_json( const std::filesystem::path& path )
+    {
+        std::ofstream out { path, std::ios::binary | std::ios::trunc };
+        if ( !out )
+            return false;
+        write_chrome_json( out );
+        return bool( out.flush() );
+    }
+
+}   // namespace sl::trace
+
+
+#define SL_TRACE_CONCAT_( a, b ) a##b
+#define SL_TRACE_CONCAT( a, b )  SL_TRACE_CONCAT_( a, b )
+
+#if SL_TRACING_ENABLED
+#    define SL_TRACE_SPAN( category, name )                                                     \
+        sl::trace::span SL_TRACE_CONCAT( _sl_trace_span_, __LINE__ ) { category, name }
+#    define SL_TRACE_INSTANT( category, name ) sl::trace::instant( category, name )
+#    define SL_TRACE_COUNTER( category, name, value )                                           \
+        sl::trace::counter( category, name, static_cast< double >( value ) )
+#else
+#    define SL_TRACE_SPAN( category, name )           ( (void)0 )
+#    define SL_TRACE_INSTANT( category, name )        ( (void)0 )
+#    define SL_TRACE_COUNTER( category, name, value ) ( (void)0 )
+#endif
+
+#endif /* __TRACE_H_9F0603831B9448058918FD8D1EFC80DC__ */
@@ -0,0 +1,157 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023-present Robert Anderson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef __CRC32C_H_5A957130A5E54393AA602EC7BAFD6098__
+#define __CRC32C_H_5A957130A5E54393AA602EC7BAFD6098__
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+
+#if ( defined( __x86_64__ ) || defined( __i386__ ) ) \
+    && ( defined( __GNUC__ ) || defined( __clang__ ) )
+#    include <immintrin.h>
+#    define SL_CRC32C_SSE42 1   // Compiled with a target attribute, picked at runtime
+#elif defined( __ARM_FEATURE_CRC32 )
+#    include <arm_acle.h>
+#    define SL_CRC32C_ARM 1
+#endif
+
+namespace sl::utils
+{
+
+    namespace detail
+    {
+
+        /**
+         * Slicing-by-8 tables for the reflected Castagnoli polynomial.
+         */
+        inline constexpr auto crc32c_tables = [] {
+            std::array< std::array< uint32_t, 256 >, 8 > t {};
+            for ( uint32_t i = 0; i < 256; ++i )
+            {
+                uint32_t c = i;
+                for ( int k = 0; k < 8; ++k )
+                    c = ( c >> 1 ) ^ ( ( c & 1 ) ? 0x82F63B78u : 0u );
+                t[0][i] = c;
+            }
+            for ( uint32_t i = 0; i < 256; ++i )
+            {
+                for ( size_t s = 1; s < 8; ++s )
+                    t[s][i] = ( t[s - 1][i] >> 8 ) ^ t[0][t[s - 1][i] & 0xFF];
+            }
+            return t;
+        }();
+
+        inline uint32_t crc32c_scalar( uint32_t crc, const unsigned char* p, size_t n )
+        {
+            const auto& t = crc32c_tables;
+            for ( ; n >= 8; n -= 8, p += 8 )
+            {
+                uint64_t v;
+                std::memcpy( &v, p, 8 );   // Little endian only (as are all our targets)
+                v ^= crc;
+                crc = t[7][v & 0xFF] ^ t[6][( v >> 8 ) & 0xFF] ^ t[5][( v >> 16 ) & 0xFF]
+                      ^ t[4][( v >> 24 ) & 0xFF] ^ t[3][( v >> 32 ) & 0xFF]
+                      ^ t[2][( v >> 40 ) & 0xFF] ^ t[1][( v >> 48 ) & 0xFF] ^ t[0][v >> 56];
+            }
+            for ( ; n > 0; --n, ++p )
+                crc = ( crc >> 8 ) ^ t[0][( crc ^ *p ) & 0xFF];
+            return crc;
+        }
+
+#if defined( SL_CRC32C_SSE42 )
+        __attribute__( ( target( "sse4.2" ) ) ) inline uint32_t
+        crc32c_sse42( uint32_t crc, const unsigned char* p, size_t n )
+        {
+#    if defined( __x86_64__ )
+            uint64_t c = crc;
+            for ( ; n >= 8; n -= 8, p += 8 )
+            {
+                uint64_t v;
+                std::memcpy( &v, p, 8 );
+                c = _mm_crc32_u64( c, v );
+            }
+            crc = static_cast< uint32_t >( c );
+#    endif
+            for ( ; n > 0; --n, ++p )
+                crc = _mm_crc32_u8( crc, *p );
+            return crc;
+        }
+#endif
+
+#if defined( SL_CRC32C_ARM )
+        inline uint32_t crc32c_arm( uint32_t crc, const unsigned char* p, size_t n )
+        {
+            for ( ; n >= 8; n -= 8, p += 8 )
+            {
+                uint64_t v;
+                std::memcpy( &v, p, 8 );
+                crc = __crc32cd( crc, v );
+            }
+            for ( ; n > 0; --n, ++p )
+                crc = __crc32cb( crc, *p );
+            return crc;
+        }
+#endif
+
+        using crc32c_fn = uint32_t ( * )( uint32_t, const unsigned char*, size_t );
+
+        inline crc32c_fn select_crc32c()
+        {
+#if defined( SL_CRC32C_SSE42 )
+            if ( __builtin_cpu_supports( "sse4.2" ) )
+                return &crc32c_sse42;
+#elif defined( SL_CRC32C_ARM )
+            return &crc32c_arm;
+#endif
+            return &crc32c_scalar;
+        }
+
+    }   // namespace detail
+
+
+    /**
+     * CRC-32C (Castagnoli), as used by iSCSI, ext4 and most storage formats. Hardware
+     * accelerated where available (SSE4.2, picked at runtime, or the ARMv8 CRC extension)
+     * with a slicing-by-8 table fallback. Pass a previous result as 'crc' to continue a
+     * checksum over more data.
+     */
+    inline uint32_t crc32c( const void* data, size_t size, uint32_t crc = 0 ) noexcept
+    {
+        static const auto impl = detail::select_crc32c();
+        return ~impl( ~crc, static_cast< const unsigned char* >( data ), size );
+    }
+
+    inline uint32_t crc32c( std::span< const std::byte > data, uint32_t crc = 0 ) noexcept
+    {
+        return crc32c( data.data(), data.size(), crc );
+    }
+
+}   // namespace sl::utils
+
+#endif /* __CRC32C_H_5A957130A5E54393AA602EC7BAFD6098__ */
@@ -24,6 +24,9 @@
 
 #include <catch2/catch.hpp>
 
+#include <cstdlib>
+#include <stdexcept>
+
 #include <mem/allocator.h>
 
 #define FAKE_PTR reinterpret_cast< void* >( 0xDeadBeef )
@@ -148,3 +151,71 @@ TEST_CASE( "Type alloc w/ std::unique_ptr", "[utils][memory]" )
     REQUIRE( ctor_called == 1 );
     REQUIRE( dtor_called == 1 );
 }
+
+TEST_CASE( "Policy allocator w/ std::unique_ptr", "[utils][memory]" )
+{
+    static size_t allocs = 0;
+    static size_t frees  = 0;
+
+    struct counting_policy
+    {
+        void* alloc( size_t size ) const noexcept
+        {
+            allocs += 1;
+            return std::malloc( size );
+        }
+
+        void* realloc( void* ptr, size_t size ) const noexcept { return std::realloc( ptr, size ); }
+
+        void free( void* ptr ) const noexcept
+        {
+            frees += 1;
+            std::free( ptr );
+        }
+    };
+
+    sl::mem::basic_allocator< counting_policy > allocator;
+
+    {
+        auto p = allocator.alloc_sp< int >( 11 );
+        REQUIRE( *p == 11 );
+        REQUIRE( allocs == 1 );
+        REQUIRE( frees == 0 );
+
+        // Stateless policies yield pointer-sized smart pointers
+        STATIC_REQUIRE( sizeof( p ) == sizeof( int* ) );
+    }
+
+    REQUIRE( allocs == 1 );
+    REQUIRE( frees == 1 );
+
+    auto i = allocator.alloc_t< int >( 5 );
+    REQUIRE( *i == 5 );
+    allocator.free_t( i );
+    REQUIRE( frees == 2 );
+}
+
+TEST_CASE( "Type alloc frees memory when ctor throws", "[utils][memory]" )
+{
+    size_t frees = 0;
+
+    auto alloc   = []( size_t size ) -> void* { return new unsigned char[size]; };
+    auto realloc = []( void*, size_t ) {
+        REQUIRE( false );
+        return nullptr;
+    };
+    auto free = [&frees]( void* ptr ) {
+        frees += 1;
+        delete[] reinterpret_cast< unsigned char* >( ptr );
+    };
+
+    struct thrower
+    {
+        thrower() { throw std::runtime_error( "nope" ); }
+    };
+
+    sl::mem::allocator allocator( { alloc, realloc, free } );
+
+    REQUIRE_THROWS( allocator.alloc_t< thrower >() );
+    REQUIRE( frees == 1 );
+}
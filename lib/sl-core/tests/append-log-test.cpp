@@ -0,0 +1,176 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023-present Robert Anderson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <catch2/catch.hpp>
+#include <test/temp.h>
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <io/append-log.h>
+
+namespace
+{
+
+    std::string record( int i )
+    {
+        return "event-" + std::to_string( i ) + std::string( i % 13, '.' );
+    }
+
+    std::vector< std::string > replay( const sl::io::append_log& log )
+    {
+        std::vector< std::string > out;
+        log.replay( [&out]( std::span< const std::byte > payload ) {
+            out.emplace_back( reinterpret_cast< const char* >( payload.data() ), payload.size() );
+        } );
+        return out;
+    }
+
+}   // namespace
+
+TEST_CASE( "Append log round trips across reopen", "[io][append-log]" )
+{
+    sl::test::temp_dir dir( "sl-append-log-round-trip" );
+
+    {
+        sl::io::append_log log( dir.path, "journal", { .segment_size = 64 * 1024 } );
+        REQUIRE( log.segment() == 1 );
+
+        for ( int i = 0; i < 100; ++i )
+        {
+            auto r   = record( i );
+            auto pos = log.append( r.data(), r.size() );
+            REQUIRE( pos.offset % 8 == 0 );
+        }
+        log.append( nullptr, 0 );   // Empty records are allowed
+    }
+
+    sl::io::append_log log( dir.path, "journal", { .segment_size = 64 * 1024 } );
+    auto records = replay( log );
+    REQUIRE( records.size() == 101 );
+    for ( int i = 0; i < 100; ++i )
+        REQUIRE( records[i] == record( i ) );
+    REQUIRE( records[100].empty() );
+
+    // Appends continue after the recovered end.
+    log.append( "more", 4 );
+    REQUIRE( replay( log ).back() == "more" );
+    REQUIRE( replay( log ).size() == 102 );
+}
+
+TEST_CASE( "Append log rolls segments at the size cap", "[io][append-log]" )
+{
+    sl::test::temp_dir dir( "sl-append-log-roll" );
+
+    const auto page = sl::io::mapped_view::page_size();
+    sl::io::append_log log( dir.path, "journal", { .segment_size = page } );
+
+    std::string payload( 500, 'p' );
+    for ( int i = 0; i < 50; ++i )
+    {
+        payload[0] = static_cast< char >( i );
+        log.append( payload.data(), payload.size() );
+    }
+
+    auto segments = log.segments();
+    REQUIRE( segments.size() > 1 );
+    REQUIRE( log.segment() == segments.back().first );
+    for ( const auto& [seq, path] : segments )
+        REQUIRE( std::filesystem::file_size( path ) == page );
+
+    auto records = replay( log );
+    REQUIRE( records.size() == 50 );
+    for ( int i = 0; i < 50; ++i )
+        REQUIRE( records[i][0] == static_cast< char >( i ) );
+
+    std::string huge( log.max_record_size() + 1, 'x' );
+    REQUIRE_THROWS_AS( log.append( huge.data(), huge.size() ), sl::io::error );
+}
+
+TEST_CASE( "Append log recovers to the last valid record", "[io][append-log]" )
+{
+    sl::test::temp_dir dir( "sl-append-log-recover" );
+
+    std::vector< sl::io::log_position > positions;
+    {
+        sl::io::append_log log( dir.path, "journal", { .segment_size = 64 * 1024 } );
+        for ( int i = 0; i < 10; ++i )
+        {
+            auto r = record( i );
+            positions.push_back( log.append( r.data(), r.size() ) );
+        }
+    }
+
+    // Simulate a lost write: corrupt the payload of the 8th record.
+    {
+        auto path = sl::io::append_log( dir.path, "journal" ).segments().back().second;
+        sl::io::mapped_file mf( path.c_str(), sl::io::access_mode::read_write );
+        auto mv = mf.map_view( 0, mf.size() );
+        mv.as< char >( positions[7].offset + sl::io::append_log::k_record_header ) ^= 0x40;
+    }
+
+    sl::io::append_log log( dir.path, "journal", { .segment_size = 64 * 1024 } );
+    REQUIRE( log.offset() == positions[7].offset );
+
+    auto records = replay( log );
+    REQUIRE( records.size() == 7 );
+
+    // Records past the damage are gone for good, so new appends never resurrect them.
+    log.append( "after", 5 );
+    records = replay( log );
+    REQUIRE( records.size() == 8 );
+    REQUIRE( records.back() == "after" );
+}
+
+TEST_CASE( "Append log sync policies", "[io][append-log]" )
+{
+    sl::test::temp_dir dir( "sl-append-log-sync" );
+
+    {
+        sl::io::append_log log( dir.path, "always", { .sync = sl::io::log_sync::always } );
+        log.append( "a", 1 );
+        REQUIRE( log.pending() == 0 );
+    }
+
+    {
+        sl::io::append_log log(
+            dir.path, "group", { .sync = sl::io::log_sync::group, .group_bytes = 64 } );
+        log.append( "a", 1 );
+        REQUIRE( log.pending() == 16 );
+        for ( int i = 0; i < 3; ++i )
+            log.append( "a", 1 );
+        REQUIRE( log.pending() == 0 );   // The fourth record reached the group size
+    }
+
+    sl::io::append_log log( dir.path, "none", { .sync = sl::io::log_sync::none } );
+    for ( int i = 0; i < 100; ++i )
+        log.append( "abc", 3 );
+    REQUIRE( log.pending() == 1600 );
+    log.sync();
+    REQUIRE( log.pending() == 0 );
+}
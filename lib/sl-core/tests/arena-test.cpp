@@ -0,0 +1,161 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023-present Robert Anderson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <cstring>
+
+#include <mem/arena.h>
+
+TEST_CASE( "Arena honors alignment", "[memory][arena]" )
+{
+    sl::mem::arena arena( 1024 );
+
+    for ( size_t align : { 1, 2, 8, 16, 64, 256 } )
+    {
+        auto p = arena.allocate( 3, align );
+        REQUIRE( p != nullptr );
+        REQUIRE( reinterpret_cast< uintptr_t >( p ) % align == 0 );
+    }
+}
+
+TEST_CASE( "Arena grows by chunks", "[memory][arena]" )
+{
+    sl::mem::arena arena( 256 );
+    REQUIRE( arena.capacity() == 0 );
+
+    arena.allocate( 200 );
+    REQUIRE( arena.capacity() == 256 );
+
+    arena.allocate( 200 );
+    REQUIRE( arena.capacity() == 512 );
+
+    // Oversized requests get a dedicated chunk
+    auto big = arena.allocate( 4096 );
+    REQUIRE( big != nullptr );
+    REQUIRE( arena.capacity() >= 512 + 4096 );
+}
+
+TEST_CASE( "Arena reset reuses chunks", "[memory][arena]" )
+{
+    sl::mem::arena arena( 256 );
+
+    auto first = arena.allocate( 64 );
+    arena.allocate( 200 );
+    arena.allocate( 200 );
+    auto capacity = arena.capacity();
+
+    arena.reset();
+    REQUIRE( arena.allocate( 64 ) == first );
+
+    arena.allocate( 200 );
+    arena.allocate( 200 );
+    REQUIRE( arena.capacity() == capacity );
+}
+
+TEST_CASE( "Arena rewinds to markers", "[memory][arena]" )
+{
+    sl::mem::arena arena( 256 );
+
+    arena.allocate( 32 );
+    auto m     = arena.mark();
+    auto after = arena.allocate( 32 );
+
+    arena.allocate( 200 );
+    arena.allocate( 200 );
+
+    arena.rewind( m );
+    REQUIRE( arena.allocate( 32 ) == after );
+
+    void* scoped = nullptr;
+    {
+        sl::mem::arena::scope _( arena );
+        scoped = arena.allocate( 16 );
+        arena.allocate( 1000 );
+    }
+
+    REQUIRE( arena.allocate( 16 ) == scoped );
+}
+
+TEST_CASE( "Arena as allocator", "[memory][arena]" )
+{
+    static size_t ctor_called = 0;
+    static size_t dtor_called = 0;
+
+    struct foo
+    {
+        foo( int cookie )
+            : _cookie( cookie )
+        {
+            ctor_called += 1;
+        }
+
+        ~foo() { dtor_called += 1; }
+
+        int cookie() const { return _cookie; }
+
+    private:
+        int _cookie;
+    };
+
+    sl::mem::arena arena;
+    auto allocator = arena.allocator();
+
+    auto f = allocator.alloc_t< foo >( 42 );
+    REQUIRE( f->cookie() == 42 );
+    allocator.free_t( f );
+    REQUIRE( ctor_called == 1 );
+    REQUIRE( dtor_called == 1 );
+
+    {
+        auto sp = allocator.alloc_sp< foo >( 73 );
+        REQUIRE( sp->cookie() == 73 );
+    }
+    REQUIRE( ctor_called == 2 );
+    REQUIRE( dtor_called == 2 );
+}
+
+TEST_CASE( "Arena allocator realloc", "[memory][arena]" )
+{
+    sl::mem::arena arena;
+    auto allocator = arena.allocator();
+
+    // The most recent block grows in place
+    auto p = static_cast< char* >( allocator.alloc( 8 ) );
+    std::memcpy( p, "arena", 6 );
+    auto q = static_cast< char* >( allocator.realloc( p, 64 ) );
+    REQUIRE( q == p );
+
+    // Older blocks are copied
+    auto other = allocator.alloc( 8 );
+    auto r     = static_cast< char* >( allocator.realloc( q, 128 ) );
+    REQUIRE( r != q );
+    REQUIRE( std::strcmp( r, "arena" ) == 0 );
+
+    // Freeing the top block hands the space straight back
+    allocator.free( r );
+    REQUIRE( allocator.alloc( 8 ) == r );
+    (void)other;
+}
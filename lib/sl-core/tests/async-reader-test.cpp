@@ -0,0 +1,168 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023-present Robert Anderson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <catch2/catch.hpp>
+#include <test/temp.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <vector>
+
+#include <io/async-reader.h>
+
+namespace
+{
+
+    struct pattern_file : sl::test::temp_file
+    {
+        pattern_file( const char* name, size_t size )
+            : temp_file { name, ".bin" }
+            , size { size }
+        {
+            std::ofstream out( path, std::ios::binary | std::ios::trunc );
+            for ( size_t i = 0; i < size; ++i )
+                out.put( static_cast< char >( byte_at( i ) ) );
+        }
+
+        static unsigned char byte_at( size_t offset )
+        {
+            return static_cast< unsigned char >( ( offset * 31 ) ^ ( offset >> 8 ) );
+        }
+
+        static bool matches( std::span< const std::byte > bytes, size_t offset )
+        {
+            for ( size_t i = 0; i < bytes.size(); ++i )
+            {
+                if ( bytes[i] != std::byte { byte_at( offset + i ) } )
+                    return false;
+            }
+            return true;
+        }
+
+        size_t size;
+    };
+
+}   // namespace
+
+TEST_CASE( "Async reader reads many ranges", "[io][async-reader]" )
+{
+    const bool use_uring = GENERATE( true, false );
+
+    pattern_file a( "sl-async-reader-a", 300 * 1024 );
+    pattern_file b( "sl-async-reader-b", 5000 );
+    sl::io::file_handle fa( a.path.c_str() );
+    sl::io::file_handle fb( b.path.c_str() );
+    REQUIRE( fa.size() == a.size );
+
+    sl::io::async_reader reader( { .queue_depth = 4, .use_uring = use_uring } );
+    if ( !use_uring )
+        REQUIRE_FALSE( reader.uses_uring() );
+
+    std::vector< std::vector< std::byte > > buffers;
+    std::vector< sl::io::async_reader::request > requests;
+    for ( size_t off = 0; off < a.size; off += 10000 )
+    {
+        buffers.emplace_back( 10000 );
+        requests.push_back( { fa.fd(), off, buffers.back() } );
+    }
+    buffers.emplace_back( 8000 );
+    requests.push_back( { fb.fd(), 0, buffers.back() } );
+
+    auto complete = reader.read_many( requests );
+    REQUIRE( complete == requests.size() - 2 );   // Last chunk of 'a' and all of 'b' are short
+    REQUIRE( reader.in_flight() == 0 );
+
+    for ( auto& r : requests )
+    {
+        auto file_size = r.fd == fa.fd() ? a.size : b.size;
+        auto expected  = std::min( r.buffer.size(), file_size - r.offset );
+        REQUIRE( r.result == static_cast< int64_t >( expected ) );
+        REQUIRE( pattern_file::matches( r.buffer.first( expected ), r.offset ) );
+    }
+}
+
+TEST_CASE( "Async reader completions can queue more reads", "[io][async-reader]" )
+{
+    const bool use_uring = GENERATE( true, false );
+
+    pattern_file file( "sl-async-reader-chain", 64 * 1024 );
+    sl::io::file_handle fh( file.path.c_str() );
+    sl::io::async_reader reader( { .queue_depth = 2, .use_uring = use_uring } );
+
+    std::vector< std::byte > buf( 4096 );
+    size_t offset = 0;
+    size_t reads  = 0;
+
+    std::function< void( int64_t ) > next = [&]( int64_t result ) {
+        REQUIRE( result == 4096 );
+        REQUIRE( pattern_file::matches( buf, offset ) );
+        ++reads;
+
+        offset += 4096;
+        if ( offset < file.size )
+            reader.read_at( fh.fd(), offset, buf, next );
+    };
+
+    reader.read_at( fh.fd(), 0, buf, next );
+    reader.wait();
+    REQUIRE( reads == 16 );
+
+    int64_t error = 0;
+    reader.read_at( -1, 0, buf, [&]( int64_t result ) { error = result; } );
+    while ( reader.in_flight() > 0 )
+        reader.poll();
+    REQUIRE( error == -EBADF );
+}
+
+TEST_CASE( "Async reader uses registered buffers and direct I/O", "[io][async-reader]" )
+{
+    constexpr size_t k_size = 256 * 1024;
+    pattern_file file( "sl-async-reader-direct", k_size );
+
+    // Direct I/O may be refused by the file system (e.g. tmpfs); the read works either way.
+    sl::io::file_handle fh( file.path.c_str(), true );
+    sl::io::async_reader reader;
+
+    auto storage = std::unique_ptr< std::byte, decltype( &std::free ) >(
+        static_cast< std::byte* >(
+            std::aligned_alloc( sl::io::file_handle::k_direct_alignment, k_size ) ),
+        &std::free );
+    std::span< std::byte > buf( storage.get(), k_size );
+
+    std::span< std::byte > regions[] = { buf };
+    auto registered                   = reader.register_buffers( regions );
+    if ( !reader.uses_uring() )
+        REQUIRE_FALSE( registered );
+
+    std::vector< sl::io::async_reader::request > requests;
+    for ( size_t off = 0; off < k_size; off += 64 * 1024 )
+        requests.push_back( { fh.fd(), off, buf.subspan( off, 64 * 1024 ) } );
+
+    REQUIRE( reader.read_many( requests ) == requests.size() );
+    REQUIRE( pattern_file::matches( buf, 0 ) );
+}
@@ -56,3 +56,57 @@ TEST_CASE( "Parse JSON config", "[config][json]" )
     REQUIRE( false == cfg.get< bool >( "/Image/Animated" ) );
     REQUIRE( 12.723374634 == cfg.get< double >( "/Image/Distance" ) );
 }
+
+TEST_CASE( "Streaming JSON config matches flatten()", "[config][json]" )
+{
+    auto text = R"(
+    {
+        "a/b": { "c~d": 1, "": "empty key" },
+        "list": [ [ 1, 2 ], [], { }, { "x": [ true, null ] } ],
+        "empty": { },
+        "num": -1.5e3,
+        "big": 18446744073709551615,
+        "str": "line\nbreak \"quoted\" é"
+    }
+    )";
+
+    const auto flat = nlohmann::json::parse( text ).flatten();
+    const auto snap = sl::config::compile_json( text );
+    const auto cfg  = sl::config::json_from_string( text );
+
+    REQUIRE( snap.size() == flat.size() );
+    for ( const auto& [key, value] : flat.items() )
+    {
+        INFO( key );
+        REQUIRE( snap.contains( key ) );
+        switch ( value.type() )
+        {
+        case nlohmann::json::value_t::string:
+            REQUIRE( snap.get< std::string >( key ) == value.get< std::string >() );
+            REQUIRE( cfg.get< std::string >( key ) == value.get< std::string >() );
+            break;
+        case nlohmann::json::value_t::number_float:
+            REQUIRE( snap.get< double >( key ) == value.get< double >() );
+            REQUIRE( cfg.get< double >( key ) == value.get< double >() );
+            break;
+        case nlohmann::json::value_t::null:
+            REQUIRE( snap.type( key ) == sl::config::value_type::null );
+            break;
+        default:
+            REQUIRE( cfg.get< nlohmann::json >( key ) == value );
+            break;
+        }
+    }
+
+    REQUIRE( snap.get< int >( "/a~1b/c~0d" ) == 1 );
+    REQUIRE( snap.get< uint64_t >( "/big" ) == UINT64_MAX );
+    REQUIRE( snap.get< bool >( "/list/3/x/0" ) );
+    REQUIRE( snap.type( "/list/1" ) == sl::config::value_type::null );
+}
+
+TEST_CASE( "Malformed JSON config throws a parse error", "[config][json]" )
+{
+    REQUIRE_THROWS_AS( sl::config::json_from_string( R"({"a": [1, 2)" ),
+                       nlohmann::json::parse_error );
+    REQUIRE_THROWS_AS( sl::config::compile_json( R"({"a" 1})" ), nlohmann::json::parse_error );
+}
@@ -0,0 +1,66 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023-present Robert Anderson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <utils/crc32c.h>
+
+TEST_CASE( "CRC32C known answers", "[utils][crc32c]" )
+{
+    const std::string check = "123456789";
+    REQUIRE( sl::utils::crc32c( check.data(), check.size() ) == 0xE3069283u );
+    REQUIRE( sl::utils::crc32c( nullptr, 0 ) == 0u );
+
+    std::vector< unsigned char > zeros( 32, 0x00 );
+    std::vector< unsigned char > ones( 32, 0xFF );
+    REQUIRE( sl::utils::crc32c( zeros.data(), zeros.size() ) == 0x8A9136AAu );
+    REQUIRE( sl::utils::crc32c( ones.data(), ones.size() ) == 0x62A8AB43u );
+}
+
+TEST_CASE( "CRC32C continues across calls", "[utils][crc32c]" )
+{
+    std::string data;
+    for ( int i = 0; i < 1000; ++i )
+        data.push_back( static_cast< char >( i * 7 ) );
+
+    const auto whole = sl::utils::crc32c( data.data(), data.size() );
+    for ( size_t split : { 0, 1, 7, 8, 9, 500, 999, 1000 } )
+    {
+        auto head = sl::utils::crc32c( data.data(), split );
+        REQUIRE( sl::utils::crc32c( data.data() + split, data.size() - split, head ) == whole );
+    }
+
+    // Hardware and table implementations must agree, including unaligned tails.
+    for ( size_t len = 0; len < 40; ++len )
+    {
+        auto p = reinterpret_cast< const unsigned char* >( data.data() ) + 3;
+        REQUIRE( ~sl::utils::detail::crc32c_scalar( ~0u, p, len )
+                 == sl::utils::crc32c( p, len ) );
+    }
+}
@@ -0,0 +1,166 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023-present Robert Anderson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <catch2/catch.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <logging/limit.h>
+
+namespace
+{
+
+    using namespace std::chrono_literals;
+
+    struct capture_sink : sl::logging::sink
+    {
+        void write( std::span< const std::string_view > batch ) override
+        {
+            for ( auto line : batch )
+                lines.emplace_back( line );
+        }
+
+        std::vector< std::string > lines;
+    };
+
+    constexpr uint64_t k_ms = 1'000'000;
+
+}   // namespace
+
+TEST_CASE( "Rate limiter allows a burst, then the rate", "[logging][limit]" )
+{
+    sl::logging::rate_limiter limiter { 10, 3 };   // One per 100ms, bursts of 3
+    uint64_t suppressed = 0;
+
+    const uint64_t t0 = 1000 * k_ms;
+    REQUIRE( limiter.try_acquire( suppressed, t0 ) );
+    REQUIRE( limiter.try_acquire( suppressed, t0 ) );
+    REQUIRE( limiter.try_acquire( suppressed, t0 ) );
+    REQUIRE( suppressed == 0 );
+
+    REQUIRE_FALSE( limiter.try_acquire( suppressed, t0 ) );
+    REQUIRE_FALSE( limiter.try_acquire( suppressed, t0 + 50 * k_ms ) );
+
+    // One token back after an interval; the rejections are reported with it.
+    REQUIRE( limiter.try_acquire( suppressed, t0 + 100 * k_ms ) );
+    REQUIRE( suppressed == 2 );
+    REQUIRE_FALSE( limiter.try_acquire( suppressed, t0 + 100 * k_ms ) );
+
+    // A long quiet period refills the whole burst, but no more.
+    const uint64_t t1 = t0 + 10'000 * k_ms;
+    REQUIRE( limiter.try_acquire( suppressed, t1 ) );
+    REQUIRE( suppressed == 1 );
+    REQUIRE( limiter.try_acquire( suppressed, t1 ) );
+    REQUIRE( limiter.try_acquire( suppressed, t1 ) );
+    REQUIRE_FALSE( limiter.try_acquire( suppressed, t1 ) );
+}
+
+TEST_CASE( "Rate limiter is exact under contention", "[logging][limit]" )
+{
+    sl::logging::rate_limiter limiter { 1, 100 };
+    std::atomic< uint64_t > passed { 0 };
+    std::atomic< uint64_t > reported { 0 };
+
+    {
+        std::vector< std::jthread > threads;
+        for ( int t = 0; t < 4; ++t )
+        {
+            threads.emplace_back( [&] {
+                for ( int i = 0; i < 10000; ++i )
+                {
+                    uint64_t suppressed = 0;
+                    if ( limiter.try_acquire( suppressed, 5 * k_ms ) )
+                    {
+                        ++passed;
+                        reported += suppressed;
+                    }
+                }
+            } );
+        }
+    }
+
+    REQUIRE( passed == 100 );
+
+    // The remaining rejections are handed to the next caller let through.
+    uint64_t suppressed = 0;
+    REQUIRE( limiter.try_acquire( suppressed, 5000 * k_ms ) );
+    REQUIRE( reported + suppressed == 40000 - 100 );
+}
+
+TEST_CASE( "Sampler lets through one in N", "[logging][limit]" )
+{
+    sl::logging::sampler sampler { 4 };
+
+    int passed = 0;
+    for ( int i = 0; i < 100; ++i )
+        passed += sampler.sample();
+    REQUIRE( passed == 25 );
+}
+
+TEST_CASE( "Limited and sampled macros", "[logging][limit]" )
+{
+    using sl::logging::log_level;
+
+    capture_sink sink;
+    sl::logging::logger logger( sink );
+
+    auto limited = [&]( int i ) {
+        SL_LOG_LIMITED_TO( logger, log_level::error, 20, 5, "storm %d", i );
+    };
+
+    for ( int i = 0; i < 100; ++i )
+        limited( i );
+    REQUIRE( sink.lines.size() == 5 );
+    REQUIRE( sink.lines[4] == "[ERROR] storm 4\n" );
+
+    std::this_thread::sleep_for( 80ms );
+    limited( 100 );
+    REQUIRE( sink.lines.size() == 7 );
+    REQUIRE( sink.lines[5] == "[ERROR] (suppressed 95 message(s) from this call site)\n" );
+    REQUIRE( sink.lines[6] == "[ERROR] storm 100\n" );
+
+    // Every expansion has its own state.
+    sink.lines.clear();
+    for ( int i = 0; i < 10; ++i )
+    {
+        SL_LOG_SAMPLED_TO( logger, log_level::info, 5, "a %d", i );
+        SL_LOG_SAMPLED_TO( logger, log_level::info, 10, "b %d", i );
+    }
+    using lines = std::vector< std::string >;
+    REQUIRE( sink.lines == lines { "[INFO] a 0\n", "[INFO] b 0\n", "[INFO] a 5\n" } );
+
+    // Disabled levels never consume tokens.
+    sink.lines.clear();
+    auto quiet = [&]( int i ) { SL_LOG_LIMITED_TO( logger, log_level::trace, 1, 1, "t %d", i ); };
+    logger.set_level( log_level::info );
+    quiet( 0 );
+    logger.set_level( log_level::trace );
+    quiet( 1 );
+    REQUIRE( sink.lines == lines { "[TRACE] t 1\n" } );
+}
@@ -0,0 +1,98 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023-present Robert Anderson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+
+#include <catch2/catch.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <config/json.h>
+#include <config/live.h>
+
+TEST_CASE( "Live config publishes new snapshots", "[config][live]" )
+{
+    sl::config::live live { sl::config::compile_json( R"({"net":{"port":8080}})" ) };
+    REQUIRE( live.generation() == 1 );
+
+    auto held = live.current();
+    live.publish( sl::config::compile_json( R"({"net":{"port":9090}})" ) );
+
+    REQUIRE( live.generation() == 2 );
+    REQUIRE( live.current()->get< int >( "/net/port" ) == 9090 );
+
+    // Whoever still holds the old snapshot keeps reading it
+    REQUIRE( held->get< int >( "/net/port" ) == 8080 );
+}
+
+TEST_CASE( "Live config readers follow publishes", "[config][live]" )
+{
+    sl::config::live live { sl::config::compile_json( R"({"n":1})" ) };
+    decltype( live )::reader reader { live };
+
+    const auto* first = &reader.get();
+    REQUIRE( first->get< int >( "/n" ) == 1 );
+    REQUIRE( &reader.get() == first );   // No publish, same snapshot
+
+    live.publish( sl::config::compile_json( R"({"n":2})" ) );
+    REQUIRE( reader.get().get< int >( "/n" ) == 2 );
+}
+
+TEST_CASE( "Live config reads while publishing", "[config][live]" )
+{
+    sl::config::live live { sl::config::compile_json( R"({"a":0,"b":0})" ) };
+
+    std::atomic< bool > done { false };
+    std::atomic< int > torn { 0 };
+
+    std::vector< std::jthread > readers;
+    for ( int t = 0; t < 4; ++t )
+    {
+        readers.emplace_back( [&] {
+            decltype( live )::reader reader { live };
+            while ( !done.load() )
+            {
+                // Both values are published together, so a reader never sees them differ
+                const auto& cfg = reader.get();
+                if ( cfg.get< int >( "/a" ) != cfg.get< int >( "/b" ) )
+                    torn++;
+            }
+        } );
+    }
+
+    for ( int i = 1; i <= 200; ++i )
+    {
+        const auto n = std::to_string( i );
+        live.publish( sl::config::compile_json( R"({"a":)" + n + R"(,"b":)" + n + "}" ) );
+    }
+
+    done = true;
+    readers.clear();
+
+    REQUIRE( torn == 0 );
+    REQUIRE( live.generation() == 201 );
+    REQUIRE( live.current()->get< int >( "/a" ) == 200 );
+}
@@ -0,0 +1,124 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023-present Robert Anderson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <catch2/catch.hpp>
+#include <test/temp.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <vector>
+
+#include <io/load.h>
+
+namespace
+{
+
+    struct word_file : sl::test::temp_file
+    {
+        word_file( const char* name, size_t words, size_t extra_bytes = 0 )
+            : temp_file { name, ".bin" }
+        {
+            std::ofstream out( path, std::ios::binary | std::ios::trunc );
+            for ( uint32_t i = 0; i < words; ++i )
+                out.write( reinterpret_cast< const char* >( &i ), sizeof( i ) );
+            for ( size_t i = 0; i < extra_bytes; ++i )
+                out.put( 'x' );
+        }
+    };
+
+    bool sequential( std::span< const uint32_t > words )
+    {
+        for ( uint32_t i = 0; i < words.size(); ++i )
+        {
+            if ( words[i] != i )
+                return false;
+        }
+        return true;
+    }
+
+}   // namespace
+
+TEST_CASE( "Load buffer matches load_file", "[io][load]" )
+{
+    word_file file( "sl-load-buffer", 300 * 1024 );
+
+    auto strategy = GENERATE( sl::io::load_strategy::read, sl::io::load_strategy::map );
+    auto words    = sl::io::load_buffer< uint32_t >(
+        file.path, { .strategy = strategy, .chunk_size = 64 * 1024, .threads = 3 } );
+
+    REQUIRE( words.mapped() == ( strategy == sl::io::load_strategy::map ) );
+    REQUIRE( words.size() == 300 * 1024 );
+    REQUIRE( sequential( words ) );
+    REQUIRE( reinterpret_cast< uintptr_t >( words.data() ) % alignof( uint32_t ) == 0 );
+
+    auto reference = sl::io::load_file< uint32_t >( file.path );
+    REQUIRE( std::equal( words.begin(), words.end(), reference.begin(), reference.end() ) );
+}
+
+TEST_CASE( "Load buffer picks a strategy by size", "[io][load]" )
+{
+    word_file file( "sl-load-buffer-auto", 4096 );
+
+    auto small = sl::io::load_buffer< uint32_t >( file.path );
+    REQUIRE_FALSE( small.mapped() );
+    REQUIRE( sequential( small ) );
+
+    auto large = sl::io::load_buffer< uint32_t >( file.path, { .map_threshold = 4096 } );
+    REQUIRE( large.mapped() );
+    REQUIRE( sequential( large ) );
+
+    // Mapped buffers are private: writes do not reach the file.
+    large[0] = 42;
+    REQUIRE( sl::io::load_buffer< uint32_t >( file.path )[0] == 0 );
+}
+
+TEST_CASE( "Load buffer validates up front", "[io][load]" )
+{
+    word_file odd( "sl-load-buffer-odd", 10, 3 );
+    REQUIRE_THROWS_AS( sl::io::load_buffer< uint32_t >( odd.path ), sl::io::error );
+    REQUIRE( sl::io::load_buffer< char >( odd.path ).size() == 43 );
+
+    word_file empty( "sl-load-buffer-empty", 0 );
+    auto none = sl::io::load_buffer< uint64_t >( empty.path );
+    REQUIRE( none.empty() );
+    REQUIRE( none.begin() == none.end() );
+
+    REQUIRE_THROWS_AS( sl::io::load_buffer< char >( "/does/not/exist" ), sl::io::error );
+}
+
+TEST_CASE( "Load buffer moves ownership", "[io][load]" )
+{
+    word_file file( "sl-load-buffer-move", 1024 );
+
+    auto a    = sl::io::load_buffer< uint32_t >( file.path );
+    auto data = a.data();
+
+    sl::io::file_buffer< uint32_t > b( std::move( a ) );
+    REQUIRE( a.empty() );
+    REQUIRE( b.data() == data );
+    REQUIRE( sequential( b ) );
+}
@@ -0,0 +1,453 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023-present Robert Anderson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <catch2/catch.hpp>
+#include <test/temp.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <span>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <io/load.h>
+#include <logging/binary.h>
+#include <logging/logger.h>
+
+namespace
+{
+
+    struct capture_sink : sl::logging::sink
+    {
+        void write( std::span< const std::string_view > batch ) override
+        {
+            ++writes;
+            for ( auto line : batch )
+                lines.emplace_back( line );
+        }
+
+        void flush() override { ++flushes; }
+
+        std::vector< std::string > lines;
+        size_t writes { 0 };
+        size_t flushes { 0 };
+    };
+
+    /**
+     * Holds the drainer inside 'write' until released, so the ring can be filled.
+     */
+    struct gated_sink : capture_sink
+    {
+        void write( std::span< const std::string_view > batch ) override
+        {
+            while ( !open )
+                std::this_thread::yield();
+            capture_sink::write( batch );
+        }
+
+        std::atomic< bool > open { false };
+    };
+
+    /**
+     * Binary sink: keeps the raw queue entries (header + payload) instead of rendered lines.
+     */
+    struct raw_sink : capture_sink
+    {
+        bool binary() const override { return true; }
+    };
+
+    template< typename... Args >
+    std::string deferred( const char* format, Args... args )
+    {
+        std::array< std::byte, 512 > bytes;
+        auto size = sl::logging::encode_args( bytes.data(), bytes.size(), args... );
+
+        std::array< char, 512 > out;
+        auto len = sl::logging::format_args(
+            out.data(), out.size(), format, std::span( bytes.data(), size ) );
+        return std::string( out.data(), len );
+    }
+
+    template< typename... Args >
+    std::string immediate( const char* format, Args... args )
+    {
+        std::array< char, 512 > out;
+        auto len = std::snprintf( out.data(), out.size(), format, args... );
+        return std::string( out.data(), static_cast< size_t >( len ) );
+    }
+
+}   // namespace
+
+TEST_CASE( "Synchronous logger writes prefixed lines", "[logging]" )
+{
+    sl::test::temp_file tmp( "sl-logger-sync", ".log" );
+    const auto& path = tmp.path;
+
+    {
+        sl::logging::logger logger( path.c_str() );
+        logger.info( "hello %d", 42 );
+        logger.warn( "plain" );
+    }
+
+    std::ifstream in( path );
+    std::stringstream ss;
+    ss << in.rdbuf();
+    REQUIRE( ss.str() == "[INFO] hello 42\n[WARNING] plain\n" );
+}
+
+TEST_CASE( "Async logger delivers every line from many threads", "[logging][async]" )
+{
+    capture_sink sink;
+    {
+        sl::logging::async_backend backend( sink, { .capacity = 64 } );
+        sl::logging::logger logger( backend );
+
+        std::vector< std::jthread > threads;
+        for ( int t = 0; t < 4; ++t )
+        {
+            threads.emplace_back( [&logger, t] {
+                for ( int i = 0; i < 2000; ++i )
+                    logger.info( "thread %d line %d", t, i );
+            } );
+        }
+        threads.clear();
+
+        logger.flush();
+        REQUIRE( sink.lines.size() == 8000 );
+        REQUIRE( sink.flushes >= 1 );
+        REQUIRE( backend.dropped() == 0 );
+    }
+
+    std::set< std::string > unique( sink.lines.begin(), sink.lines.end() );
+    REQUIRE( unique.size() == 8000 );
+    REQUIRE( unique.count( "[INFO] thread 3 line 1999\n" ) == 1 );
+
+    // Per-thread order is preserved.
+    int last = -1;
+    for ( const auto& line : sink.lines )
+    {
+        if ( line.starts_with( "[INFO] thread 2 " ) )
+        {
+            auto n = std::stoi( line.substr( line.rfind( ' ' ) ) );
+            REQUIRE( n == last + 1 );
+            last = n;
+        }
+    }
+}
+
+TEST_CASE( "Async logger drop policies", "[logging][async]" )
+{
+    auto policy
+        = GENERATE( sl::logging::overflow_policy::drop, sl::logging::overflow_policy::report );
+
+    gated_sink sink;
+    {
+        sl::logging::async_backend backend( sink, { .capacity = 8, .overflow = policy } );
+        REQUIRE( backend.capacity() == 8 );
+
+        // The drainer may hold one batch while stuck in the gate, so push well past that.
+        size_t accepted = 0;
+        for ( int i = 0; i < 100; ++i )
+            accepted += backend.push( "[INFO] line\n" );
+
+        REQUIRE( accepted < 100 );
+        REQUIRE( backend.dropped() == 100 - accepted );
+
+        sink.open = true;
+        backend.flush();
+
+        auto reports = std::count_if( sink.lines.begin(), sink.lines.end(), []( auto& l ) {
+            return l.find( "dropped" ) != std::string::npos;
+        } );
+        REQUIRE( sink.lines.size() - reports == accepted );
+        REQUIRE( ( reports > 0 ) == ( policy == sl::logging::overflow_policy::report ) );
+    }
+}
+
+TEST_CASE( "Async logger truncates long lines", "[logging][async]" )
+{
+    capture_sink sink;
+    {
+        sl::logging::async_backend backend( sink );
+        sl::logging::logger logger( backend );
+
+        std::string long_msg( 4 * SL_MAX_LOG_LINE, 'x' );
+        logger.error( long_msg.c_str() );
+        logger.flush();
+    }
+
+    REQUIRE( sink.lines.size() == 1 );
+    REQUIRE( sink.lines[0].size() <= sl::logging::async_backend::k_max_line );
+    REQUIRE( sink.lines[0].starts_with( "[ERROR] xxx" ) );
+    REQUIRE( sink.lines[0].back() == '\n' );
+}
+
+TEST_CASE( "Default logger is shared safely", "[logging]" )
+{
+    std::atomic< sl::logging::logger* > seen[8] {};
+    {
+        std::vector< std::jthread > threads;
+        for ( auto& s : seen )
+            threads.emplace_back( [&s] { s = &sl::logging::default_logger(); } );
+    }
+
+    for ( auto& s : seen )
+        REQUIRE( s.load() == &sl::logging::default_logger() );
+}
+
+TEST_CASE( "Deferred formatting matches snprintf", "[logging][deferred]" )
+{
+    int value       = -42;
+    const char* str = "text";
+
+    REQUIRE( deferred( "no args" ) == "no args" );
+    REQUIRE( deferred( "100%% %d", 7 ) == immediate( "100%% %d", 7 ) );
+    REQUIRE( deferred( "%d|%5i|%-5d|%+d", 1, 2, 3, 4 )
+             == immediate( "%d|%5i|%-5d|%+d", 1, 2, 3, 4 ) );
+    REQUIRE( deferred( "%u %x %X %o %#x", 1u, 255u, 255u, 8u, 16u )
+             == immediate( "%u %x %X %o %#x", 1u, 255u, 255u, 8u, 16u ) );
+    REQUIRE( deferred( "%zu %ld %lld %llu", size_t( 1 ) << 40, -5L, -6LL, ~0ULL )
+             == immediate( "%zu %ld %lld %llu", size_t( 1 ) << 40, -5L, -6LL, ~0ULL ) );
+    REQUIRE( deferred( "%hhd %hu", 'a', uint16_t( 65535 ) )
+             == immediate( "%hhd %hu", 'a', uint16_t( 65535 ) ) );
+    REQUIRE( deferred( "%f %.3e %g %8.2f %Lf", 3.5, 1234.5, 0.1f, 2.25, 1.5L )
+             == immediate( "%f %.3e %g %8.2f %Lf", 3.5, 1234.5, 0.1f, 2.25, 1.5L ) );
+    REQUIRE( deferred( "%c[%s][%10s][%-6.2s]", 'x', str, str, str )
+             == immediate( "%c[%s][%10s][%-6.2s]", 'x', str, str, str ) );
+    REQUIRE( deferred( "[%*d][%-*d][%.*s]", 6, value, 6, value, 2, str )
+             == immediate( "[%*d][%-*d][%.*s]", 6, value, 6, value, 2, str ) );
+    REQUIRE( deferred( "%p", static_cast< void* >( &value ) )
+             == immediate( "%p", static_cast< void* >( &value ) ) );
+    REQUIRE( deferred( "%s", static_cast< const char* >( nullptr ) ) == "(null)" );
+
+    // Mismatched and missing arguments are shown rather than misread.
+    REQUIRE( deferred( "%d and %s", str, 5 ) == "(?) and (?)" );
+    REQUIRE( deferred( "%d %d", 1 ) == "1 %d" );
+    REQUIRE( deferred( "[%*d] [%.*f]", str, 1 ) == "[%*d] [%.*f]" );
+    REQUIRE( deferred( "trailing %" ) == "trailing %" );
+
+    // Strings are copied, so later changes to the source do not show up.
+    char buffer[] = "before";
+    std::array< std::byte, 64 > bytes;
+    auto size = sl::logging::encode_args( bytes.data(), bytes.size(), buffer );
+    std::strcpy( buffer, "after!" );
+
+    std::array< char, 64 > out;
+    auto len = sl::logging::format_args(
+        out.data(), out.size(), "%s", std::span( bytes.data(), size ) );
+    REQUIRE( std::string_view( out.data(), len ) == "before" );
+}
+
+TEST_CASE( "Deferred async logger renders on the drainer", "[logging][deferred]" )
+{
+    capture_sink sink;
+    {
+        sl::logging::async_backend backend( sink, { .deferred = true } );
+        sl::logging::logger logger( backend );
+
+        std::string name = "dynamic";
+        logger.info( "value %d of %s", 12, name.c_str() );
+        name = "changed";
+        logger.warn( "plain line" );
+        logger.error( "%.2f%%", 99.5 );
+
+        std::string long_arg( 4 * SL_MAX_LOG_LINE, 'y' );
+        logger.trace( "long %s", long_arg.c_str() );
+        logger.flush();
+    }
+
+    REQUIRE( sink.lines.size() == 4 );
+    REQUIRE( sink.lines[0] == "[INFO] value 12 of dynamic\n" );
+    REQUIRE( sink.lines[1] == "[WARNING] plain line\n" );
+    REQUIRE( sink.lines[2] == "[ERROR] 99.50%\n" );
+    REQUIRE( sink.lines[3].starts_with( "[TRACE] long yyy" ) );
+    REQUIRE( sink.lines[3].size() <= sl::logging::async_backend::k_max_line );
+    REQUIRE( sink.lines[3].back() == '\n' );
+}
+
+TEST_CASE( "SL_* macros go through the default backend", "[logging][async]" )
+{
+    capture_sink sink;
+    {
+        sl::logging::async_backend backend( sink );
+        sl::logging::set_default_backend( backend );
+
+        SL_INFO( "x %d", 7 );
+        SL_WARN( "plain" );
+        sl::logging::default_logger().flush();
+
+        sl::logging::clear_default_backend();
+    }
+
+    using lines = std::vector< std::string >;
+    REQUIRE( sink.lines == lines { "[INFO] x 7\n", "[WARNING] plain\n" } );
+}
+
+TEST_CASE( "SL_* macros defer through the default backend", "[logging][deferred]" )
+{
+    raw_sink sink;
+    {
+        sl::logging::async_backend backend( sink, { .deferred = true } );
+        sl::logging::set_default_backend( backend );
+
+        int n = 7;
+        SL_INFO( "x %d", n );
+        sl::logging::default_logger().flush();
+
+        sl::logging::clear_default_backend();
+    }
+
+    REQUIRE( sink.lines.size() == 1 );
+
+    // The ring held the format address and the raw argument bytes, not a rendered line.
+    const auto& entry = sink.lines[0];
+    sl::logging::entry_header header;
+    REQUIRE( entry.size() >= sizeof( header ) );
+    std::memcpy( &header, entry.data(), sizeof( header ) );
+
+    auto format = reinterpret_cast< const char* >( static_cast< uintptr_t >( header.format ) );
+    REQUIRE( header.kind == sl::logging::entry_kind::record );
+    REQUIRE( header.level == sl::logging::log_level::info );
+    REQUIRE( std::string_view( format ) == "x %d" );
+    REQUIRE( header.size == entry.size() - sizeof( header ) );
+
+    std::array< char, 64 > out;
+    auto args = std::span( reinterpret_cast< const std::byte* >( entry.data() ) + sizeof( header ),
+                           header.size );
+    auto len  = sl::logging::format_args( out.data(), out.size(), format, args );
+    REQUIRE( std::string_view( out.data(), len ) == "x 7" );
+}
+
+TEST_CASE( "Binary log round trip", "[logging][deferred]" )
+{
+    sl::test::temp_file tmp( "sl-logger-binary", ".log" );
+    const auto& path = tmp.path;
+
+    // Two runs append to the same file, each (re)defining the formats it uses.
+    for ( int run = 0; run < 2; ++run )
+    {
+        sl::logging::binary_sink sink( path.c_str() );
+        sl::logging::async_backend backend( sink, { .deferred = true } );
+        sl::logging::logger logger( backend );
+
+        for ( int i = 0; i < 3; ++i )
+            logger.info( "run %d item %d %s", run, i, "ok" );
+        logger.warn( "no arguments" );
+    }
+
+    auto data = sl::io::load_buffer< char >( path.c_str() );
+
+    std::vector< std::string > lines;
+    auto collect = [&lines]( std::string_view line ) { lines.emplace_back( line ); };
+    REQUIRE( sl::logging::decode_binary_log( data, collect ) );
+
+    REQUIRE( lines.size() == 8 );
+    REQUIRE( lines[0] == "[INFO] run 0 item 0 ok\n" );
+    REQUIRE( lines[3] == "[WARNING] no arguments\n" );
+    REQUIRE( lines[6] == "[INFO] run 1 item 2 ok\n" );
+
+    // A torn tail is reported, after delivering what came before it.
+    lines.clear();
+    std::span< const char > torn( data.data(), data.size() - 3 );
+    REQUIRE_FALSE( sl::logging::decode_binary_log( torn, collect ) );
+    REQUIRE( lines.size() == 7 );
+}
+
+TEST_CASE( "Binary log decode with a string for a star width", "[logging][deferred]" )
+{
+    sl::test::temp_file tmp( "sl-logger-star", ".log" );
+    const auto& path = tmp.path;
+    {
+        sl::logging::binary_sink sink( path.c_str() );
+        sl::logging::async_backend backend( sink, { .deferred = true } );
+        sl::logging::logger logger( backend );
+
+        logger.info( "width [%*d]", "x", 1 );
+        logger.info( "after %d", 2 );
+    }
+
+    auto data = sl::io::load_buffer< char >( path.c_str() );
+
+    std::vector< std::string > lines;
+    auto collect = [&lines]( std::string_view line ) { lines.emplace_back( line ); };
+    REQUIRE( sl::logging::decode_binary_log( data, collect ) );
+
+    // The width is not a number, so the conversion is shown as written.
+    using expected = std::vector< std::string >;
+    REQUIRE( lines == expected { "[INFO] width [%*d]\n", "[INFO] after 2\n" } );
+}
+
+TEST_CASE( "Runtime level threshold", "[logging][level]" )
+{
+    using sl::logging::log_level;
+
+    capture_sink sink;
+    {
+        sl::logging::async_backend backend( sink );
+        sl::logging::logger logger( backend );
+        REQUIRE( logger.level() == sl::logging::k_min_level );
+
+        logger.set_level( log_level::warning );
+        REQUIRE( logger.enabled( log_level::fatal ) );
+        REQUIRE( logger.enabled( log_level::warning ) );
+        REQUIRE_FALSE( logger.enabled( log_level::info ) );
+
+        logger.info( "hidden %d", 1 );
+        logger.trace( "hidden" );
+        logger.warn( "shown %d", 2 );
+        logger.error( "shown" );
+        logger.flush();
+    }
+
+    using lines = std::vector< std::string >;
+    REQUIRE( sink.lines == lines { "[WARNING] shown 2\n", "[ERROR] shown\n" } );
+}
+
+TEST_CASE( "Disabled log statements skip argument evaluation", "[logging][level]" )
+{
+    int calls  = 0;
+    auto count = [&calls] { return ++calls; };
+
+    SL_LOG_DISCARD( "never %d", count() );
+    REQUIRE( calls == 0 );
+
+    auto& logger = sl::logging::default_logger();
+    auto saved   = logger.level();
+    logger.set_level( sl::logging::log_level::fatal );
+
+    SL_INFO( "skipped %d", count() );
+    SL_TRACE( "skipped %d", count() );
+    REQUIRE( calls == 0 );
+
+    logger.set_level( saved );
+}
@@ -0,0 +1,166 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023-present Robert Anderson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <catch2/catch.hpp>
+#include <test/temp.h>
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <string>
+
+#include <io/mapped-file.h>
+
+TEST_CASE( "Mapped file write round trip", "[io][mapped-file]" )
+{
+    sl::test::temp_file tmp( "sl-mapped-file-round-trip", ".bin" );
+
+    {
+        sl::io::mapped_file mf( tmp.path.c_str(), sl::io::access_mode::create );
+        REQUIRE( mf.writable() );
+        REQUIRE( mf.size() == 0 );
+
+        mf.preallocate( 64 * 1024 );
+        REQUIRE( mf.size() == 64 * 1024 );
+
+        auto mv    = mf.map_view( 0, mf.size() );
+        auto items = mv.as_items< uint32_t >();
+        REQUIRE( items.size() == 16 * 1024 );
+        for ( size_t i = 0; i < items.size(); ++i )
+            items[i] = static_cast< uint32_t >( i * 3 );
+
+        mv.sync( sl::io::sync_mode::async, 4096, 4096 );
+        mv.sync();
+    }
+
+    REQUIRE( std::filesystem::file_size( tmp.path ) == 64 * 1024 );
+
+    sl::io::mapped_file mf( tmp.path.c_str() );
+    REQUIRE_FALSE( mf.writable() );
+
+    auto mv    = mf.map_view( 0, mf.size() );
+    auto items = mv.as_items< const uint32_t >();
+    for ( size_t i = 0; i < items.size(); ++i )
+        REQUIRE( items[i] == i * 3 );
+}
+
+TEST_CASE( "Mapped file grows with view remap", "[io][mapped-file]" )
+{
+    sl::test::temp_file tmp( "sl-mapped-file-grow", ".bin" );
+
+    sl::io::mapped_file mf( tmp.path.c_str(), sl::io::access_mode::create );
+    mf.resize( 4096 );
+
+    auto mv = mf.map_view( 0, mf.size() );
+    std::memcpy( mv.data(), "header", 6 );
+
+    mf.resize( 1024 * 1024 );
+    mv.remap( mf.size() );
+    REQUIRE( mv.size() == 1024 * 1024 );
+    REQUIRE( std::memcmp( mv.data(), "header", 6 ) == 0 );
+
+    mv.as< uint64_t >( 1024 * 1024 - sizeof( uint64_t ) ) = 0x0123456789ABCDEFull;
+    mv.sync();
+    mf.sync();
+
+    sl::io::mapped_file reader( tmp.path.c_str() );
+    REQUIRE( reader.size() == 1024 * 1024 );
+    auto rv = reader.map_view( 0, reader.size() );
+    REQUIRE( rv.as< uint64_t >( 1024 * 1024 - sizeof( uint64_t ) ) == 0x0123456789ABCDEFull );
+}
+
+TEST_CASE( "Mapped file opened read-write keeps existing data", "[io][mapped-file]" )
+{
+    sl::test::temp_file tmp( "sl-mapped-file-rw", ".bin" );
+
+    {
+        sl::io::mapped_file mf( tmp.path.c_str(), sl::io::access_mode::create );
+        mf.resize( 4096 );
+        auto mv = mf.map_view( 0, mf.size() );
+        mv.as< uint32_t >( 0 ) = 42;
+    }
+
+    sl::io::mapped_file mf( tmp.path.c_str(), sl::io::access_mode::read_write );
+    REQUIRE( mf.size() == 4096 );
+    auto mv = mf.map_view( 0, mf.size() );
+    REQUIRE( mv.writable() );
+    REQUIRE( mv.as< uint32_t >( 0 ) == 42 );
+    mv.as< uint32_t >( 0 ) += 1;
+    mv.sync();
+
+    sl::io::mapped_file reader( tmp.path.c_str() );
+    REQUIRE( reader.map_view( 0, 4096 ).as< uint32_t >( 0 ) == 43 );
+}
+
+TEST_CASE( "Mapped file rejects invalid writes", "[io][mapped-file]" )
+{
+    sl::test::temp_file tmp( "sl-mapped-file-invalid", ".bin" );
+
+    REQUIRE_THROWS_AS( sl::io::mapped_file( tmp.path.c_str(), sl::io::access_mode::read_write ),
+                       sl::io::error );
+
+    {
+        sl::io::mapped_file mf( tmp.path.c_str(), sl::io::access_mode::create );
+        mf.resize( 4096 );
+        REQUIRE_THROWS_AS( mf.map_view( 0, 8192 ), sl::io::error );
+    }
+
+    sl::io::mapped_file mf( tmp.path.c_str() );
+    REQUIRE_THROWS_AS( mf.resize( 8192 ), sl::io::error );
+    REQUIRE_THROWS_AS( mf.preallocate( 8192 ), sl::io::error );
+    REQUIRE_FALSE( mf.map_view( 0, 4096 ).writable() );
+}
+
+TEST_CASE( "Mapped view residency controls", "[io][mapped-file]" )
+{
+    sl::test::temp_file tmp( "sl-mapped-file-residency", ".bin" );
+
+    const size_t pages = 64;
+    const size_t page  = sl::io::mapped_view::page_size();
+
+    sl::io::mapped_file mf( tmp.path.c_str(), sl::io::access_mode::create );
+    mf.resize( pages * page );
+
+    auto mv = mf.map_view( 0, mf.size() );
+    std::memset( mv.data(), 0x5A, mv.size() );
+    mv.sync();
+
+    mv.populate();
+    REQUIRE( mv.resident_pages() == pages );
+    REQUIRE( mv.resident_pages( page * 4, page * 2 ) == 2 );
+    REQUIRE( mv.resident_pages( page * 4 + 1, page ) == 2 );   // Widened to page boundaries
+
+    mv.prefetch( page * 8, page * 8 );
+    mv.lock( 0, page );
+    mv.unlock( 0, page );
+
+    // Released pages fault back in from the file with their contents intact.
+    mv.release( 0, page * 16 );
+    mv.release( page * 16, page * 16, sl::io::release_mode::cold );
+    REQUIRE( mv.as< unsigned char >( 0 ) == 0x5A );
+    REQUIRE( mv.as< unsigned char >( page * 20 ) == 0x5A );
+
+    REQUIRE_THROWS_AS( mv.prefetch( mv.size() + 1 ), sl::io::error );
+}
@@ -0,0 +1,131 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023-present Robert Anderson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <catch2/catch.hpp>
+#include <test/temp.h>
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+
+#include <io/mapped-stream.h>
+
+namespace
+{
+
+    struct record
+    {
+        uint32_t id;
+        uint32_t values[6];
+    };
+
+    static_assert( sizeof( record ) == 28 );   // Never divides a page evenly
+
+    struct record_file : sl::test::temp_file
+    {
+        record_file( const char* name, size_t count )
+            : temp_file { name, ".bin" }
+        {
+            sl::io::mapped_file mf( path.c_str(), sl::io::access_mode::create );
+            mf.resize( count * sizeof( record ) );
+
+            auto mv    = mf.map_view( 0, mf.size() );
+            auto bytes = static_cast< unsigned char* >( mv.data() );
+            for ( size_t i = 0; i < count; ++i )
+            {
+                record r { uint32_t( i ), { uint32_t( i ), 1, 2, 3, 4, uint32_t( ~i ) } };
+                std::memcpy( bytes + i * sizeof( record ), &r, sizeof( r ) );
+            }
+        }
+    };
+
+}   // namespace
+
+TEST_CASE( "Mapped stream reads records straddling windows", "[io][mapped-stream]" )
+{
+    record_file file( "sl-mapped-stream-records", 5000 );
+
+    const auto page = sl::io::mapped_view::page_size();
+    sl::io::mapped_stream stream( file.path.c_str(), page );
+    REQUIRE( stream.window_size() == page );
+    REQUIRE( stream.size() == 5000 * sizeof( record ) );
+
+    for ( uint32_t i = 0; i < 5000; ++i )
+    {
+        auto r = stream.read_as< record >();
+        REQUIRE( r.id == i );
+        REQUIRE( r.values[0] == i );
+        REQUIRE( r.values[5] == ~i );
+
+        // Never more than one window (plus the page a straddling record starts in).
+        REQUIRE( stream.mapped_bytes() <= 2 * page );
+    }
+
+    REQUIRE( stream.eof() );
+    REQUIRE( stream.next().empty() );
+    REQUIRE_THROWS_AS( stream.read( 1 ), sl::io::error );
+}
+
+TEST_CASE( "Mapped stream maps records larger than the window", "[io][mapped-stream]" )
+{
+    record_file file( "sl-mapped-stream-large", 1000 );
+
+    const auto page = sl::io::mapped_view::page_size();
+    sl::io::mapped_stream stream( file.path.c_str(), page );
+
+    stream.skip( 100 * sizeof( record ) );
+    auto bytes = stream.read( 500 * sizeof( record ) );
+    REQUIRE( bytes.size() == 500 * sizeof( record ) );
+
+    record first, last;
+    std::memcpy( &first, bytes.data(), sizeof( record ) );
+    std::memcpy( &last, bytes.data() + 499 * sizeof( record ), sizeof( record ) );
+    REQUIRE( first.id == 100 );
+    REQUIRE( last.id == 599 );
+
+    auto peeked = stream.peek( sizeof( record ) );
+    REQUIRE( stream.position() == 600 * sizeof( record ) );
+    REQUIRE( peeked.size() == sizeof( record ) );
+}
+
+TEST_CASE( "Mapped stream scans in window sized chunks", "[io][mapped-stream]" )
+{
+    record_file file( "sl-mapped-stream-chunks", 3000 );
+
+    const auto page = sl::io::mapped_view::page_size();
+    sl::io::mapped_stream stream( file.path.c_str(), 4 * page );
+
+    size_t total  = 0;
+    size_t chunks = 0;
+    for ( auto chunk = stream.next(); !chunk.empty(); chunk = stream.next() )
+    {
+        REQUIRE( chunk.size() <= 4 * page );
+        total += chunk.size();
+        ++chunks;
+    }
+
+    REQUIRE( total == stream.size() );
+    REQUIRE( chunks == ( stream.size() + 4 * page - 1 ) / ( 4 * page ) );
+}
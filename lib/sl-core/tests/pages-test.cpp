@@ -0,0 +1,132 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023-present Robert Anderson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <cstring>
+
+#include <mem/arena.h>
+#include <mem/pages.h>
+
+namespace
+{
+    bool page_aligned( const void* p )
+    {
+        return reinterpret_cast< uintptr_t >( p ) % sl::mem::page_region::base_page_size() == 0;
+    }
+}   // namespace
+
+TEST_CASE( "Page region maps base pages", "[memory][pages]" )
+{
+    sl::mem::page_region region( 10000, { .huge_pages = false } );
+    REQUIRE( region );
+    REQUIRE( region.kind() == sl::mem::page_kind::normal );
+    REQUIRE( region.size() >= 10000 );
+    REQUIRE( region.size() % sl::mem::page_region::base_page_size() == 0 );
+    REQUIRE( page_aligned( region.data() ) );
+
+    auto bytes = static_cast< unsigned char* >( region.data() );
+    std::memset( bytes, 0xAB, region.size() );
+    REQUIRE( bytes[0] == 0xAB );
+    REQUIRE( bytes[region.size() - 1] == 0xAB );
+}
+
+TEST_CASE( "Page region falls back when huge pages are unavailable", "[memory][pages]" )
+{
+    // Whichever kind of mapping the host allows, the region must be usable and aligned
+    // to a huge page boundary unless it fell all the way back to base pages.
+    sl::mem::page_region region( 3 * 1024 * 1024 );
+    REQUIRE( region );
+    REQUIRE( region.size() >= 3 * 1024 * 1024 );
+
+    if ( region.kind() != sl::mem::page_kind::normal )
+    {
+        REQUIRE( reinterpret_cast< uintptr_t >( region.data() )
+                     % sl::mem::page_region::k_huge_page_size
+                 == 0 );
+    }
+
+    auto bytes = static_cast< unsigned char* >( region.data() );
+    bytes[0]                  = 1;
+    bytes[region.size() - 1] = 2;
+    REQUIRE( bytes[0] + bytes[region.size() - 1] == 3 );
+}
+
+TEST_CASE( "Page region moves ownership", "[memory][pages]" )
+{
+    sl::mem::page_region a( 4096, { .huge_pages = false } );
+    auto data = a.data();
+
+    sl::mem::page_region b( std::move( a ) );
+    REQUIRE_FALSE( a );
+    REQUIRE( b.data() == data );
+}
+
+TEST_CASE( "Page region NUMA binding is best effort", "[memory][pages]" )
+{
+    // Node 0 exists on every Linux host, but mbind may still be refused (containers,
+    // kernels without NUMA); either way the mapping stays valid.
+    sl::mem::page_region region( 8192, { .huge_pages = false, .numa_node = 0 } );
+    REQUIRE( region );
+    std::memset( region.data(), 0, region.size() );
+
+    sl::mem::page_region bogus( 8192, { .huge_pages = false, .numa_node = 100000 } );
+    REQUIRE( bogus );
+    REQUIRE_FALSE( bogus.numa_bound() );
+}
+
+TEST_CASE( "Page policy allocates, grows and frees", "[memory][pages]" )
+{
+    sl::mem::basic_allocator< sl::mem::page_policy > alloc(
+        sl::mem::page_policy { { .huge_pages = false } } );
+
+    auto p = static_cast< unsigned char* >( alloc.alloc( 100 ) );
+    REQUIRE( p != nullptr );
+    REQUIRE( reinterpret_cast< uintptr_t >( p ) % alignof( std::max_align_t ) == 0 );
+    for ( int i = 0; i < 100; ++i )
+        p[i] = static_cast< unsigned char >( i );
+
+    p = static_cast< unsigned char* >( alloc.realloc( p, 1024 * 1024 ) );
+    REQUIRE( p != nullptr );
+    for ( int i = 0; i < 100; ++i )
+        REQUIRE( p[i] == static_cast< unsigned char >( i ) );
+    p[1024 * 1024 - 1] = 7;
+
+    alloc.free( p );
+}
+
+TEST_CASE( "Arena can draw chunks from pages", "[memory][pages][arena]" )
+{
+    sl::mem::arena arena( 1024 * 1024, sl::mem::allocator( sl::mem::page_policy {} ) );
+
+    auto p = static_cast< char* >( arena.allocate( 512 * 1024 ) );
+    REQUIRE( p != nullptr );
+    std::memset( p, 1, 512 * 1024 );
+
+    auto q = static_cast< char* >( arena.allocate( 900 * 1024 ) );
+    REQUIRE( q != nullptr );
+    REQUIRE( arena.capacity() == 2 * 1024 * 1024 );
+}
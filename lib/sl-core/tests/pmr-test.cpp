@@ -0,0 +1,88 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023-present Robert Anderson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+#include <mem/arena.h>
+#include <mem/pmr.h>
+#include <mem/slab.h>
+
+TEST_CASE( "pmr containers over an arena", "[memory][pmr]" )
+{
+    sl::mem::arena arena;
+    sl::mem::resource_adapter resource { arena.allocator() };
+
+    {
+        std::pmr::vector< std::pmr::string > names { &resource };
+        for ( int i = 0; i < 100; ++i )
+            names.emplace_back( "long enough to skip the small buffer " + std::to_string( i ) );
+
+        REQUIRE( names.size() == 100 );
+        REQUIRE( names[42].ends_with( "42" ) );
+        REQUIRE( names[42].get_allocator().resource() == &resource );
+    }
+
+    REQUIRE( arena.capacity() > 0 );
+}
+
+TEST_CASE( "pmr over-aligned requests", "[memory][pmr]" )
+{
+    sl::mem::resource_adapter resource { sl::mem::slab::allocator() };
+
+    for ( size_t align : { 8, 16, 64, 256, 4096 } )
+    {
+        auto p = resource.allocate( 100, align );
+        REQUIRE( reinterpret_cast< uintptr_t >( p ) % align == 0 );
+        resource.deallocate( p, 100, align );
+    }
+
+    REQUIRE( resource.is_equal( resource ) );
+    REQUIRE_FALSE( resource.is_equal( *std::pmr::new_delete_resource() ) );
+}
+
+TEST_CASE( "Allocator over a pmr resource", "[memory][pmr]" )
+{
+    std::array< std::byte, 4096 > buffer;
+    std::pmr::monotonic_buffer_resource upstream { buffer.data(), buffer.size() };
+
+    auto allocator = sl::mem::resource_allocator( &upstream );
+
+    auto p = allocator.alloc_t< int >( 42 );
+    REQUIRE( *p == 42 );
+    REQUIRE( reinterpret_cast< std::byte* >( p ) >= buffer.data() );
+    REQUIRE( reinterpret_cast< std::byte* >( p ) < buffer.data() + buffer.size() );
+
+    auto q = static_cast< int* >( allocator.realloc( p, 64 * sizeof( int ) ) );
+    REQUIRE( *q == 42 );
+    allocator.free( q );
+
+    auto sp = allocator.alloc_sp< std::string >( "pmr" );
+    REQUIRE( *sp == "pmr" );
+}
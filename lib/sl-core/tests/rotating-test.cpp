@@ -0,0 +1,210 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023-present Robert Anderson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <catch2/catch.hpp>
+#include <test/temp.h>
+
+#include <sys/stat.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <logging/logger.h>
+#include <logging/rotating.h>
+
+namespace
+{
+
+    namespace fs = std::filesystem;
+    using namespace std::chrono_literals;
+
+    std::string read_file( const fs::path& path )
+    {
+        std::ifstream in( path, std::ios::binary );
+        std::stringstream ss;
+        ss << in.rdbuf();
+        return ss.str();
+    }
+
+    size_t count_files( const fs::path& dir )
+    {
+        return static_cast< size_t >(
+            std::distance( fs::directory_iterator( dir ), fs::directory_iterator() ) );
+    }
+
+    std::string line( int i )
+    {
+        char buf[32];
+        std::snprintf( buf, sizeof( buf ), "line %06d ...........\n", i );   // 24 bytes
+        return buf;
+    }
+
+}   // namespace
+
+TEST_CASE( "Rotating sink buffers until flushed", "[logging][rotating]" )
+{
+    sl::test::temp_dir dir( "sl-rotating-test" );
+    auto path = dir.path / "app.log";
+
+    sl::logging::rotating_file_sink sink( path, { .flush_interval = 1h, .compressor = {} } );
+    sl::logging::logger logger( sink );
+
+    logger.info( "first" );
+    logger.warn( "second %d", 2 );
+    REQUIRE( fs::file_size( path ) == 0 );
+
+    logger.flush();
+    REQUIRE( read_file( path ) == "[INFO] first\n[WARNING] second 2\n" );
+}
+
+TEST_CASE( "Rotating sink flushes in the background", "[logging][rotating]" )
+{
+    sl::test::temp_dir dir( "sl-rotating-test" );
+    auto path = dir.path / "app.log";
+
+    sl::logging::rotating_file_sink sink( path, { .flush_interval = 20ms, .compressor = {} } );
+    sl::logging::logger logger( sink );
+    logger.info( "eventually" );
+
+    for ( int i = 0; i < 200 && fs::file_size( path ) == 0; ++i )
+        std::this_thread::sleep_for( 5ms );
+    REQUIRE( read_file( path ) == "[INFO] eventually\n" );
+}
+
+TEST_CASE( "Rotating sink rotates by size and keeps every line", "[logging][rotating]" )
+{
+    sl::test::temp_dir dir( "sl-rotating-test" );
+    auto path = dir.path / "app.log";
+
+    {
+        sl::logging::rotating_file_sink sink(
+            path, { .max_size = 240, .max_files = 100, .buffer_size = 64, .compressor = {} } );
+
+        // Preallocation reserves blocks without changing the visible size.
+        REQUIRE( fs::file_size( path ) == 0 );
+
+        for ( int i = 0; i < 100; ++i )
+        {
+            auto l = line( i );
+            std::string_view view( l );
+            sink.write( std::span( &view, 1 ) );
+        }
+        REQUIRE( sink.next_rotation() == 10 );
+    }
+
+    // 10 lines per file: app.log.1 .. app.log.9, then the current file.
+    std::string all;
+    for ( int n = 1; n <= 9; ++n )
+    {
+        auto rotated = dir.path / ( "app.log." + std::to_string( n ) );
+        REQUIRE( fs::file_size( rotated ) == 240 );
+        all += read_file( rotated );
+    }
+    all += read_file( path );
+
+    std::string expected;
+    for ( int i = 0; i < 100; ++i )
+        expected += line( i );
+    REQUIRE( all == expected );
+}
+
+TEST_CASE( "Rotating sink prunes and compresses rotated files", "[logging][rotating]" )
+{
+    sl::test::temp_dir dir( "sl-rotating-test" );
+    auto path = dir.path / "app.log";
+
+    std::atomic< int > compressed { 0 };
+    auto compressor = [&compressed]( const fs::path& file ) {
+        auto out = file;
+        out += ".z";
+        fs::rename( file, out );
+        ++compressed;
+        return true;
+    };
+
+    sl::logging::rotating_file_sink sink( path, { .max_files = 3, .compressor = compressor } );
+    for ( int i = 0; i < 6; ++i )
+    {
+        auto l = line( i );
+        std::string_view view( l );
+        sink.write( std::span( &view, 1 ) );
+        sink.rotate_now();
+    }
+    sink.wait_idle();
+
+    REQUIRE( compressed == 6 );
+    REQUIRE( count_files( dir.path ) == 4 );   // app.log + the newest three
+    REQUIRE( fs::exists( dir.path / "app.log.6.z" ) );
+    REQUIRE( fs::exists( dir.path / "app.log.4.z" ) );
+    REQUIRE_FALSE( fs::exists( dir.path / "app.log.3.z" ) );
+    REQUIRE( read_file( dir.path / "app.log.6.z" ) == line( 5 ) );
+
+    // A new sink on the same path continues the numbering.
+    sl::logging::rotating_file_sink reopened( path, { .compressor = {} } );
+    REQUIRE( reopened.next_rotation() == 7 );
+}
+
+TEST_CASE( "Rotating sink rotates by age", "[logging][rotating]" )
+{
+    sl::test::temp_dir dir( "sl-rotating-test" );
+    auto path = dir.path / "app.log";
+
+    sl::logging::rotating_file_sink sink( path, { .max_age = 30ms, .compressor = {} } );
+    sl::logging::logger logger( sink );
+
+    logger.info( "old" );
+    std::this_thread::sleep_for( 50ms );
+    logger.info( "new" );
+    logger.flush();
+
+    REQUIRE( read_file( dir.path / "app.log.1" ) == "[INFO] old\n" );
+    REQUIRE( read_file( path ) == "[INFO] new\n" );
+}
+
+TEST_CASE( "Rotating sink gzip compressor", "[logging][rotating]" )
+{
+    // Only meaningful where gzip is installed.
+    if ( std::system( "command -v gzip > /dev/null 2>&1" ) != 0 )
+        return;
+
+    sl::test::temp_dir dir( "sl-rotating-test" );
+    auto path = dir.path / "app.log";
+
+    sl::logging::rotating_file_sink sink( path );
+    sl::logging::logger logger( sink );
+    logger.info( "compress me" );
+    sink.rotate_now();
+    sink.wait_idle();
+
+    REQUIRE( fs::exists( dir.path / "app.log.1.gz" ) );
+    REQUIRE_FALSE( fs::exists( dir.path / "app.log.1" ) );
+}
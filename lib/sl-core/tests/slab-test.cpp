@@ -0,0 +1,196 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023-present Robert Anderson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include <mem/slab.h>
+
+TEST_CASE( "Slab size classes", "[memory][slab]" )
+{
+    using sl::mem::slab;
+
+    REQUIRE( slab::class_size( slab::class_index( 0 ) ) == 16 );
+    REQUIRE( slab::class_size( slab::class_index( 1 ) ) == 16 );
+    REQUIRE( slab::class_size( slab::class_index( 17 ) ) == 32 );
+    REQUIRE( slab::class_size( slab::class_index( 128 ) ) == 128 );
+    REQUIRE( slab::class_size( slab::class_index( 129 ) ) == 160 );
+    REQUIRE( slab::class_size( slab::class_index( 257 ) ) == 320 );
+    REQUIRE( slab::class_size( slab::class_index( 2047 ) ) == 2048 );
+
+    for ( size_t size = 1; size <= slab::k_max_class_size; ++size )
+    {
+        auto index = slab::class_index( size );
+        REQUIRE( index < slab::k_class_count );
+        REQUIRE( slab::class_size( index ) >= size );
+        if ( index > 0 )
+            REQUIRE( slab::class_size( index - 1 ) < size );
+    }
+}
+
+TEST_CASE( "Slab alloc / free recycles", "[memory][slab]" )
+{
+    auto& s = sl::mem::slab::instance();
+
+    auto p = s.alloc( 40 );
+    REQUIRE( p != nullptr );
+    REQUIRE( reinterpret_cast< uintptr_t >( p ) % alignof( std::max_align_t ) == 0 );
+
+    s.free( p );
+    REQUIRE( s.alloc( 33 ) == p );   // Same class, straight back out of the magazine
+    s.free( p );
+
+    std::set< void* > seen;
+    std::vector< void* > ptrs;
+    for ( int i = 0; i < 1000; ++i )
+    {
+        auto q = s.alloc( 64 );
+        std::memset( q, i & 0xff, 64 );
+        REQUIRE( seen.insert( q ).second );
+        ptrs.push_back( q );
+    }
+
+    for ( auto q : ptrs )
+        s.free( q );
+}
+
+TEST_CASE( "Slab large and realloc", "[memory][slab]" )
+{
+    auto& s = sl::mem::slab::instance();
+
+    auto big = static_cast< char* >( s.alloc( 10000 ) );
+    REQUIRE( big != nullptr );
+    std::memset( big, 'x', 10000 );
+    s.free( big );
+
+    auto p = static_cast< char* >( s.alloc( 20 ) );
+    std::memcpy( p, "slab", 5 );
+
+    // Still fits in the 32 byte class
+    REQUIRE( s.realloc( p, 30 ) == p );
+
+    auto q = static_cast< char* >( s.realloc( p, 5000 ) );
+    REQUIRE( q != p );
+    REQUIRE( std::strcmp( q, "slab" ) == 0 );
+    s.free( q );
+}
+
+TEST_CASE( "Slab as allocator", "[memory][slab]" )
+{
+    static size_t dtor_called = 0;
+
+    struct foo
+    {
+        foo( int cookie )
+            : cookie( cookie )
+        {}
+
+        ~foo() { dtor_called += 1; }
+
+        int cookie;
+    };
+
+    auto allocator = sl::mem::slab::allocator();
+
+    auto f = allocator.alloc_t< foo >( 42 );
+    REQUIRE( f->cookie == 42 );
+    allocator.free_t( f );
+    REQUIRE( dtor_called == 1 );
+
+    auto f2 = sl::mem::object_pool< foo >::make( 7 );
+    REQUIRE( f2 == f );
+    REQUIRE( f2->cookie == 7 );
+    sl::mem::object_pool< foo >::destroy( f2 );
+    REQUIRE( dtor_called == 2 );
+}
+
+TEST_CASE( "Slab cross-thread churn", "[memory][slab]" )
+{
+    constexpr int k_threads = 4;
+    constexpr int k_rounds  = 2000;
+
+    // Objects allocated on one thread are freed on another to exercise the depot.
+    std::vector< std::vector< void* > > handoff( k_threads );
+    for ( int t = 0; t < k_threads; ++t )
+        for ( int i = 0; i < k_rounds; ++i )
+            handoff[t].push_back( sl::mem::slab::instance().alloc( 24 + t * 100 ) );
+
+    std::vector< std::thread > threads;
+    for ( int t = 0; t < k_threads; ++t )
+    {
+        threads.emplace_back( [&handoff, t]() {
+            auto& s = sl::mem::slab::instance();
+            for ( auto p : handoff[t] )
+                s.free( p );
+
+            for ( int i = 0; i < k_rounds; ++i )
+                s.free( s.alloc( 8 + ( i % 512 ) ) );
+        } );
+    }
+
+    for ( auto& t : threads )
+        t.join();
+
+    SUCCEED();
+}
+
+namespace
+{
+    // Constructed before the thread's slab cache, so it is destroyed after it.
+    struct late_owner
+    {
+        void* p { nullptr };
+        void** out { nullptr };
+
+        ~late_owner()
+        {
+            auto& s = sl::mem::slab::instance();
+            s.free( p );
+
+            *out = s.alloc( 48 );
+            if ( *out )
+                std::memset( *out, 0x5a, 48 );
+            s.free( *out );
+        }
+    };
+}   // namespace
+
+TEST_CASE( "Slab frees after thread cache teardown", "[memory][slab]" )
+{
+    void* late = nullptr;
+
+    std::thread t( [&late]() {
+        thread_local late_owner owner;
+        owner.out = &late;
+        owner.p   = sl::mem::slab::instance().alloc( 40 );
+    } );
+    t.join();
+
+    REQUIRE( late != nullptr );
+}
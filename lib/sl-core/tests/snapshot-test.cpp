@@ -0,0 +1,149 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023-present Robert Anderson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <config/json.h>
+#include <config/snapshot.h>
+
+namespace
+{
+
+    constexpr auto k_image = R"(
+    {
+        "Image": {
+            "Width":  800,
+            "Height": 600,
+            "Title":  "View from 15th Floor",
+            "Thumbnail": {
+                "Url":    "http://www.example.com/image/481989943",
+                "Height": 125,
+                "Width":  100
+            },
+            "Animated" : false,
+            "IDs": [116, 943, 234, -38793],
+            "DeletionDate": null,
+            "Distance": 12.723374634
+        }
+    }
+    )";
+
+}   // namespace
+
+TEST_CASE( "Compiled JSON config matches the flattened keys", "[config][snapshot]" )
+{
+    auto cfg = sl::config::compile_json( k_image );
+
+    REQUIRE( cfg.size() == 13 );
+    REQUIRE( 800 == cfg.get< uint64_t >( "/Image/Width" ) );
+    REQUIRE( 600 == cfg.get< int >( "/Image/Height" ) );
+    REQUIRE( cfg.get< std::string >( "/Image/Thumbnail/Url" ).starts_with( "http://" ) );
+    REQUIRE( cfg.get< std::string_view >( "/Image/Title" ) == "View from 15th Floor" );
+    REQUIRE( 943 == cfg.get< int64_t >( "/Image/IDs/1" ) );
+    REQUIRE( -38793 == cfg.get< int64_t >( "/Image/IDs/3" ) );
+    REQUIRE( false == cfg.get< bool >( "/Image/Animated" ) );
+    REQUIRE( 12.723374634 == cfg.get< double >( "/Image/Distance" ) );
+    REQUIRE( 800.0 == cfg.get< double >( "/Image/Width" ) );
+    REQUIRE( cfg.type( "/Image/DeletionDate" ) == sl::config::value_type::null );
+
+    REQUIRE_FALSE( cfg.contains( "/Image" ) );
+    REQUIRE_FALSE( cfg.contains( "/Image/IDs/4" ) );
+    REQUIRE_THROWS_AS( cfg.get< int >( "/Image/Missing" ), std::runtime_error );
+    REQUIRE_THROWS_AS( cfg.get< int >( "/Image/Title" ), std::runtime_error );
+    REQUIRE_THROWS_AS( cfg.get< uint32_t >( "/Image/IDs/3" ), std::runtime_error );
+    REQUIRE_THROWS_AS( cfg.get< int8_t >( "/Image/Width" ), std::runtime_error );
+}
+
+TEST_CASE( "Bound keys are resolved once", "[config][snapshot]" )
+{
+    auto cfg = sl::config::compile_json( k_image );
+
+    sl::config::key< int > width          = cfg.bind( "/Image/Width" );
+    sl::config::key< bool > animated      = cfg.bind( "/Image/Animated" );
+    sl::config::key< std::string > title  = cfg.bind( "/Image/Title" );
+    sl::config::key< std::string_view > u = cfg.bind( "/Image/Thumbnail/Url" );
+    sl::config::key< float > distance     = cfg.bind( "/Image/Distance" );
+
+    // Keys keep working after the snapshot moves
+    auto moved = std::move( cfg );
+
+    REQUIRE( width.get() == 800 );
+    REQUIRE( *animated == false );
+    REQUIRE( title.get() == "View from 15th Floor" );
+    REQUIRE( u.get().ends_with( "481989943" ) );
+    REQUIRE( distance.get() == Approx( 12.723374634 ) );
+
+    // Only the copying string read can throw
+    STATIC_REQUIRE( noexcept( width.get() ) );
+    STATIC_REQUIRE( noexcept( *u ) );
+    STATIC_REQUIRE_FALSE( noexcept( title.get() ) );
+    STATIC_REQUIRE_FALSE( noexcept( *title ) );
+
+    REQUIRE( moved.get< int >( "/Image/Thumbnail/Width" ) == 100 );
+
+    REQUIRE_THROWS_AS( moved.bind( "/net/port" ), std::runtime_error );
+    REQUIRE_THROWS_AS( sl::config::key< int > { moved.bind( "/Image/Title" ) },
+                       std::runtime_error );
+}
+
+TEST_CASE( "Snapshot builder finds every key it was given", "[config][snapshot]" )
+{
+    constexpr int k_count = 20'000;
+
+    sl::config::snapshot_builder builder;
+    for ( int i = 0; i < k_count; ++i )
+        builder.add_int( "/service/" + std::to_string( i ) + "/port", i );
+    builder.add_string( "/name", "first" );
+    builder.add_string( "/name", "second" );   // Last one wins
+
+    const auto cfg = std::move( builder ).build();
+    REQUIRE( cfg.size() == k_count + 1 );
+    REQUIRE( cfg.get< std::string_view >( "/name" ) == "second" );
+
+    for ( int i = 0; i < k_count; ++i )
+    {
+        const auto key = "/service/" + std::to_string( i ) + "/port";
+        REQUIRE( cfg.get< int >( key ) == i );
+        REQUIRE_FALSE( cfg.contains( key + "s" ) );
+    }
+
+    size_t visited = 0;
+    cfg.for_each( [&]( std::string_view, sl::config::value_type ) { ++visited; } );
+    REQUIRE( visited == cfg.size() );
+}
+
+TEST_CASE( "Empty snapshot", "[config][snapshot]" )
+{
+    const auto empty = sl::config::snapshot_builder {}.build();
+    REQUIRE( empty.size() == 0 );
+    REQUIRE_FALSE( empty.contains( "" ) );
+    REQUIRE_FALSE( sl::config::snapshot {}.contains( "/a" ) );
+}
@@ -0,0 +1,194 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023-present Robert Anderson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <catch2/catch.hpp>
+#include <test/temp.h>
+
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <io/mapped-file.h>
+#include <io/split.h>
+
+namespace
+{
+
+    template< typename Range >
+    std::vector< std::string > collect( Range&& range )
+    {
+        std::vector< std::string > out;
+        for ( auto record : range )
+            out.emplace_back( record );
+        return out;
+    }
+
+    using strings = std::vector< std::string >;
+
+}   // namespace
+
+TEST_CASE( "Split lines", "[io][split]" )
+{
+    REQUIRE( collect( sl::io::split_lines( "" ) ).empty() );
+    REQUIRE( collect( sl::io::split_lines( "a" ) ) == strings { "a" } );
+    REQUIRE( collect( sl::io::split_lines( "a\nb\n" ) ) == strings { "a", "b" } );
+    REQUIRE( collect( sl::io::split_lines( "a\n\nb" ) ) == strings { "a", "", "b" } );
+    REQUIRE( collect( sl::io::split_lines( "\n" ) ) == strings { "" } );
+}
+
+TEST_CASE( "Split fields", "[io][split]" )
+{
+    REQUIRE( collect( sl::io::split_fields( "a,b,c" ) ) == strings { "a", "b", "c" } );
+    REQUIRE( collect( sl::io::split_fields( "a,,c," ) ) == strings { "a", "", "c", "" } );
+    REQUIRE( collect( sl::io::split_fields( "x\ty", '\t' ) ) == strings { "x", "y" } );
+    REQUIRE( collect( sl::io::split_fields( "" ) ) == strings { "" } );
+    REQUIRE( collect( sl::io::split_fields( "," ) ) == strings { "", "" } );
+}
+
+TEST_CASE( "Vectorized scan matches scalar scan", "[io][split]" )
+{
+    std::mt19937 rng( 1234 );
+    std::string data( 4099, 'x' );
+    for ( auto& ch : data )
+        ch = static_cast< char >( 'a' + rng() % 26 );
+
+    // Delimiters at every offset around vector widths, from both sides of the buffer.
+    for ( size_t pos : { 0, 1, 15, 16, 17, 31, 32, 33, 63, 64, 100, 4095, 4098 } )
+    {
+        auto copy = data;
+        copy[pos] = ',';
+        auto end  = copy.data() + copy.size();
+
+        REQUIRE( sl::io::find_byte( copy.data(), end, ',' ) == copy.data() + pos );
+        REQUIRE( sl::io::find_any( copy.data(), end, ';', ',' ) == copy.data() + pos );
+        REQUIRE( sl::io::find_byte( copy.data() + pos + 1, end, ',' ) == end );
+
+        // Every implementation the CPU can run, not only the one picked at runtime.
+        std::vector< sl::io::detail::find_any_fn > impls { &sl::io::detail::find_any_scalar };
+#if defined( SL_IO_SPLIT_SSE2 )
+        impls.push_back( &sl::io::detail::find_any_sse2 );
+#endif
+#if defined( SL_IO_SPLIT_AVX2 )
+        if ( __builtin_cpu_supports( "avx2" ) )
+            impls.push_back( &sl::io::detail::find_any_avx2 );
+#endif
+#if defined( SL_IO_SPLIT_NEON )
+        impls.push_back( &sl::io::detail::find_any_neon );
+#endif
+        for ( auto impl : impls )
+            REQUIRE( impl( copy.data(), end, '\n', ',' ) == copy.data() + pos );
+    }
+
+    // High-bit bytes must not be confused with delimiters.
+    std::string high( 100, static_cast< char >( 0x8A ) );
+    REQUIRE( sl::io::find_byte( high.data(), high.data() + high.size(), '\n' )
+             == high.data() + high.size() );
+}
+
+TEST_CASE( "Partition aligns chunks to records", "[io][split]" )
+{
+    std::string data;
+    for ( int i = 0; i < 1000; ++i )
+        data += "record-" + std::to_string( i ) + "\n";
+
+    for ( size_t parts : { 1, 2, 3, 7, 64 } )
+    {
+        auto chunks = sl::io::partition( data, parts );
+        REQUIRE( chunks.size() <= parts );
+
+        std::string joined;
+        for ( auto c : chunks )
+        {
+            REQUIRE( c.back() == '\n' );
+            joined += c;
+        }
+        REQUIRE( joined == data );
+    }
+
+    REQUIRE( sl::io::partition( "", 4 ).empty() );
+    REQUIRE( sl::io::partition( "no-delimiter", 4 ).size() == 1 );
+}
+
+TEST_CASE( "Split a mapped file in parallel", "[io][split]" )
+{
+    sl::test::temp_file tmp( "sl-split", ".csv" );
+    const auto& path = tmp.path;
+    {
+        std::ofstream out( path, std::ios::binary | std::ios::trunc );
+        for ( int i = 0; i < 20000; ++i )
+            out << i << ",name-" << i << "," << i * 2 << "\n";
+    }
+
+    sl::io::mapped_file mf( path.c_str(), sl::io::cache_hint::sequential );
+    auto mv = mf.map_view( 0, mf.size() );
+
+    size_t serial = 0;
+    for ( auto line : sl::io::split_lines( mv.as_bytes() ) )
+    {
+        auto fields = collect( sl::io::split_fields( line ) );
+        REQUIRE( fields.size() == 3 );
+        REQUIRE( std::stoi( fields[2] ) == std::stoi( fields[0] ) * 2 );
+        ++serial;
+    }
+    REQUIRE( serial == 20000 );
+
+    std::atomic< size_t > records { 0 };
+    std::atomic< long long > total { 0 };
+    sl::io::parallel_for_each_record(
+        sl::io::as_chars( mv.as_bytes() ), 4, [&]( size_t, std::string_view line ) {
+            ++records;
+            total += std::stoll( std::string( line.substr( 0, line.find( ',' ) ) ) );
+        } );
+
+    REQUIRE( records == 20000 );
+    REQUIRE( total == 20000LL * 19999 / 2 );
+}
+
+TEST_CASE( "Parallel split rethrows callback failures", "[io][split]" )
+{
+    std::string data;
+    for ( int i = 0; i < 10000; ++i )
+        data += std::to_string( i ) + "\n";
+
+    std::atomic< size_t > visited { 0 };
+    auto run = [&]() {
+        sl::io::parallel_for_each_record( data, 4, [&]( size_t, std::string_view line ) {
+            ++visited;
+            if ( line == "5000" )
+                throw std::runtime_error( "bad record" );
+        } );
+    };
+
+    REQUIRE_THROWS_WITH( run(), "bad record" );
+
+    // Still usable afterwards
+    visited = 0;
+    sl::io::parallel_for_each_record( data, 4, [&]( size_t, std::string_view ) { ++visited; } );
+    REQUIRE( visited == 10000 );
+}
@@ -0,0 +1,115 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023-present Robert Anderson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <catch2/catch.hpp>
+
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <string_view>
+
+#include <logging/logger.h>
+#include <logging/structured.h>
+
+// Built as its own test executable (see CMakeLists.txt): the global operator new / delete
+// replaced below count every allocation, which must not leak into the other sl-core tests.
+
+namespace
+{
+
+    // Counts allocations made by the current thread (see the replaced operator new below).
+    thread_local size_t t_allocations = 0;
+
+    /**
+     * Sink that only counts, so it allocates nothing itself.
+     */
+    struct counting_sink : sl::logging::sink
+    {
+        void write( std::span< const std::string_view > lines ) override
+        {
+            for ( auto line : lines )
+            {
+                ++count;
+                last.assign( line );   // 'last' has capacity reserved up front
+            }
+        }
+
+        size_t count { 0 };
+        std::string last = std::string( 1024, '\0' );
+    };
+
+}   // namespace
+
+void* operator new( size_t size )
+{
+    ++t_allocations;
+    if ( auto p = std::malloc( size ? size : 1 ) )
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete( void* p ) noexcept
+{
+    std::free( p );
+}
+
+void operator delete( void* p, size_t ) noexcept
+{
+    std::free( p );
+}
+
+TEST_CASE( "Structured logging does not allocate per record", "[logging][structured]" )
+{
+    using sl::logging::kv;
+
+    std::string peer = "192.168.1.20:55012";
+
+    SECTION( "Synchronous sink" )
+    {
+        counting_sink sink;
+        sl::logging::logger logger( sink );
+
+        auto before = t_allocations;
+        for ( int i = 0; i < 1000; ++i )
+            logger.info( "request", kv( "id", i ), kv( "peer", peer ), kv( "lat_us", 1.5 * i ) );
+        REQUIRE( t_allocations == before );
+        REQUIRE( sink.count == 1000 );
+    }
+
+    SECTION( "Async backend (producer side)" )
+    {
+        counting_sink sink;
+        sl::logging::async_backend backend( sink );
+        sl::logging::logger logger( backend );
+
+        auto before = t_allocations;
+        for ( int i = 0; i < 1000; ++i )
+            logger.info( "request", kv( "id", i ), kv( "peer", peer ), kv( "lat_us", 1.5 * i ) );
+        REQUIRE( t_allocations == before );
+
+        logger.flush();
+        REQUIRE( sink.count == 1000 );
+    }
+}
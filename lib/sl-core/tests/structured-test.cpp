@@ -0,0 +1,171 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023-present Robert Anderson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <catch2/catch.hpp>
+
+#include <cmath>
+#include <limits>
+#include <string>
+#include <string_view>
+
+#include <nlohmann/json.hpp>
+
+#include <logging/logger.h>
+#include <logging/structured.h>
+
+namespace
+{
+
+    /**
+     * Sink that only counts and keeps the last line.
+     */
+    struct counting_sink : sl::logging::sink
+    {
+        void write( std::span< const std::string_view > lines ) override
+        {
+            for ( auto line : lines )
+            {
+                ++count;
+                last.assign( line );   // 'last' has capacity reserved up front
+            }
+        }
+
+        size_t count { 0 };
+        std::string last = std::string( 1024, '\0' );
+    };
+
+    enum class color
+    {
+        red   = 1,
+        green = 2,
+    };
+
+    template< typename... Fields >
+    std::string encode( size_t cap, std::string_view msg, Fields... fields )
+    {
+        std::string out( cap, '\0' );
+        auto len = sl::logging::encode_json_line(
+            out.data(), out.size(), sl::logging::log_level::info, msg, fields... );
+        out.resize( len );
+        return out;
+    }
+
+    /**
+     * Drops the (time dependent) "ts" member: {"ts":N,"level"... -> {"level"...
+     */
+    std::string without_ts( const std::string& line )
+    {
+        auto at = line.find( ",\"level\"" );
+        return "{" + line.substr( at + 1 );
+    }
+
+}   // namespace
+
+TEST_CASE( "JSON line encoding", "[logging][structured]" )
+{
+    using sl::logging::kv;
+
+    std::string peer = "10.0.0.1:443";
+    auto line        = encode( 512,
+                        "request done",
+                        kv( "lat_us", 12.5 ),
+                        kv( "peer", peer ),
+                        kv( "status", 200 ),
+                        kv( "ok", true ),
+                        kv( "color", color::green ) );
+
+    REQUIRE( line.starts_with( "{\"ts\":" ) );
+    REQUIRE( line.back() == '\n' );
+    REQUIRE( without_ts( line )
+             == "{\"level\":\"info\",\"msg\":\"request done\",\"lat_us\":12.5,"
+                "\"peer\":\"10.0.0.1:443\",\"status\":200,\"ok\":true,\"color\":2}\n" );
+
+    auto parsed = nlohmann::json::parse( line );
+    REQUIRE( parsed["status"] == 200 );
+    REQUIRE( parsed["ts"].get< int64_t >() > 1600000000000000 );
+}
+
+TEST_CASE( "JSON line values and escaping", "[logging][structured]" )
+{
+    using sl::logging::kv;
+
+    const char* none = nullptr;
+    auto line        = encode( 512,
+                        "quote \" slash \\ newline \n tab \t ctl \x01 utf8 \xC3\xA9",
+                        kv( "min", std::numeric_limits< int64_t >::min() ),
+                        kv( "max", std::numeric_limits< uint64_t >::max() ),
+                        kv( "nan", std::nan( "" ) ),
+                        kv( "inf", std::numeric_limits< double >::infinity() ),
+                        kv( "third", 1.0 / 3.0 ),
+                        kv( "null", nullptr ),
+                        kv( "none", none ),
+                        kv( "k\"ey", "v" ) );
+
+    REQUIRE( without_ts( line )
+             == "{\"level\":\"info\",\"msg\":\"quote \\\" slash \\\\ newline \\n tab \\t ctl "
+                "\\u0001 utf8 \xC3\xA9\",\"min\":-9223372036854775808,"
+                "\"max\":18446744073709551615,\"nan\":null,\"inf\":null,"
+                "\"third\":0.3333333333333333,\"null\":null,\"none\":null,\"k\\\"ey\":\"v\"}\n" );
+
+    auto parsed = nlohmann::json::parse( line );
+    REQUIRE( parsed["msg"] == "quote \" slash \\ newline \n tab \t ctl \x01 utf8 \xC3\xA9" );
+    REQUIRE( parsed["third"].get< double >() == 1.0 / 3.0 );
+}
+
+TEST_CASE( "JSON line truncation stays valid", "[logging][structured]" )
+{
+    using sl::logging::kv;
+
+    std::string big( 200, 'x' );
+    auto line = encode( 128, "short", kv( "a", 1 ), kv( "big", big ), kv( "b", 2 ) );
+
+    REQUIRE( line.size() <= 128 );
+    auto parsed = nlohmann::json::parse( line );
+    REQUIRE( parsed["a"] == 1 );
+    REQUIRE( parsed["b"] == 2 );
+    REQUIRE_FALSE( parsed.contains( "big" ) );
+    REQUIRE( parsed["truncated"] == true );
+}
+
+TEST_CASE( "Logger writes structured records as JSON lines", "[logging][structured]" )
+{
+    using sl::logging::kv;
+
+    counting_sink sink;
+    sl::logging::logger logger( sink );
+
+    logger.info( "plain %d", 1 );
+    REQUIRE( sink.last == "[INFO] plain 1\n" );
+
+    logger.warn( "slow request", kv( "lat_us", 1500 ), kv( "path", "/index" ) );
+    auto parsed = nlohmann::json::parse( sink.last );
+    REQUIRE( parsed["level"] == "warning" );
+    REQUIRE( parsed["msg"] == "slow request" );
+    REQUIRE( parsed["path"] == "/index" );
+
+    logger.set_level( sl::logging::log_level::error );
+    logger.info( "filtered", kv( "x", 1 ) );
+    REQUIRE( sink.count == 2 );
+}
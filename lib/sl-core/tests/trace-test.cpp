@@ -0,0 +1,230 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023-present Robert Anderson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+
+#include <catch2/catch.hpp>
+
+#include <chrono>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include <trace/trace.h>
+
+namespace
+{
+
+    using namespace std::chrono_literals;
+
+    std::vector< sl::trace::record > recorded( const char* category )
+    {
+        std::vector< sl::trace::record > out;
+        sl::trace::for_each_record( [&]( const sl::trace::record& r ) {
+            if ( std::strcmp( r.category, category ) == 0 )
+                out.push_back( r );
+        } );
+        return out;
+    }
+
+    struct tracing_scope
+    {
+        tracing_scope()
+        {
+            sl::trace::clear();
+            sl::trace::start();
+        }
+
+        ~tracing_scope()
+        {
+            sl::trace::stop();
+            sl::trace::clear();
+        }
+    };
+
+}   // namespace
+
+TEST_CASE( "Trace points record nothing while stopped", "[trace]" )
+{
+    sl::trace::stop();
+    {
+        SL_TRACE_SPAN( "t-off", "span" );
+        SL_TRACE_INSTANT( "t-off", "instant" );
+        SL_TRACE_COUNTER( "t-off", "counter", 1 );
+    }
+
+    REQUIRE( recorded( "t-off" ).empty() );
+}
+
+TEST_CASE( "Spans, instants and counters are recorded", "[trace]" )
+{
+    tracing_scope scope;
+    {
+        SL_TRACE_SPAN( "t-basic", "outer" );
+        SL_TRACE_INSTANT( "t-basic", "mark" );
+        {
+            SL_TRACE_SPAN( "t-basic", "inner" );
+            std::this_thread::sleep_for( 2ms );
+        }
+        SL_TRACE_COUNTER( "t-basic", "queue", 42 );
+    }
+
+    const auto events = recorded( "t-basic" );
+    REQUIRE( events.size() == 4 );
+
+    // Spans are written when they close, so the inner one lands before the outer one.
+    REQUIRE( std::string( events[0].name ) == "mark" );
+    REQUIRE( events[0].type == sl::trace::event_type::instant );
+    REQUIRE( std::string( events[1].name ) == "inner" );
+    REQUIRE( events[1].type == sl::trace::event_type::complete );
+    REQUIRE( events[1].dur_us >= 1500.0 );
+    REQUIRE( std::string( events[2].name ) == "queue" );
+    REQUIRE( events[2].value == 42.0 );
+    REQUIRE( std::string( events[3].name ) == "outer" );
+    REQUIRE( events[3].ts_us <= events[1].ts_us );
+    REQUIRE( events[3].dur_us >= events[1].dur_us );
+}
+
+TEST_CASE( "A span can step through phases", "[trace]" )
+{
+    tracing_scope scope;
+    {
+        sl::trace::span phase { "t-phase", "one" };
+        phase.next( "two" );
+        phase.next( "three" );
+        phase.end();
+        phase.end();   // Already closed; records nothing
+    }
+
+    const auto events = recorded( "t-phase" );
+    REQUIRE( events.size() == 3 );
+    REQUIRE( std::string( events[0].name ) == "one" );
+    REQUIRE( std::string( events[1].name ) == "two" );
+    REQUIRE( std::string( events[2].name ) == "three" );
+    REQUIRE( events[1].ts_us >= events[0].ts_us + events[0].dur_us - 0.01 );
+}
+
+TEST_CASE( "Each thread records into its own buffer", "[trace]" )
+{
+    tracing_scope scope;
+
+    std::vector< std::jthread > threads;
+    for ( int t = 0; t < 4; ++t )
+    {
+        threads.emplace_back( [] {
+            for ( int i = 0; i < 100; ++i )
+                SL_TRACE_SPAN( "t-threads", "work" );
+        } );
+    }
+    threads.clear();
+
+    const auto events = recorded( "t-threads" );
+    REQUIRE( events.size() == 400 );
+
+    std::vector< uint32_t > tids;
+    for ( const auto& e : events )
+    {
+        if ( std::find( tids.begin(), tids.end(), e.tid ) == tids.end() )
+            tids.push_back( e.tid );
+    }
+    REQUIRE( tids.size() == 4 );
+}
+
+TEST_CASE( "A full buffer keeps the most recent events", "[trace]" )
+{
+    tracing_scope scope;
+    sl::trace::set_buffer_capacity( 64 );
+
+    static constexpr const char* k_names[] = { "a", "b", "c", "d" };
+    std::jthread { [] {
+        for ( int i = 0; i < 1000; ++i )
+            sl::trace::instant( "t-wrap", k_names[i % 4] );
+        sl::trace::counter( "t-wrap", "last", 1000 );
+    } }.join();
+    sl::trace::set_buffer_capacity( SL_TRACE_BUFFER_EVENTS );
+
+    const auto events = recorded( "t-wrap" );
+    REQUIRE( events.size() == 64 );
+    REQUIRE( std::string( events.back().name ) == "last" );
+    REQUIRE( std::string( events.front().name ) == "b" );   // Instant 937 of 1000
+    for ( size_t i = 1; i < events.size(); ++i )
+        REQUIRE( events[i].ts_us >= events[i - 1].ts_us );
+}
+
+TEST_CASE( "Chrome trace export is valid JSON", "[trace]" )
+{
+    tracing_scope scope;
+
+    std::jthread { [] {
+        sl::trace::set_thread_name( "worker \"1\"" );
+        SL_TRACE_SPAN( "t-json", "task" );
+        SL_TRACE_COUNTER( "t-json", "depth", 2.5 );
+    } }.join();
+    SL_TRACE_INSTANT( "t-json", "done" );
+
+    std::ostringstream out;
+    sl::trace::write_chrome_json( out );
+
+    const auto doc = nlohmann::json::parse( out.str() );
+    REQUIRE( doc.contains( "traceEvents" ) );
+
+    size_t spans = 0, counters = 0, instants = 0;
+    bool named   = false;
+    for ( const auto& e : doc["traceEvents"] )
+    {
+        const auto ph = e["ph"].get< std::string >();
+        if ( ph == "M" )
+        {
+            named = named || e["args"]["name"] == "worker \"1\"";
+            continue;
+        }
+        if ( e["cat"] != "t-json" )
+            continue;
+
+        REQUIRE( e["ts"].is_number() );
+        if ( ph == "X" )
+        {
+            ++spans;
+            REQUIRE( e["dur"].get< double >() >= 0.0 );
+        }
+        else if ( ph == "C" )
+        {
+            ++counters;
+            REQUIRE( e["args"]["value"].get< double >() == 2.5 );
+        }
+        else if ( ph == "i" )
+        {
+            ++instants;
+        }
+    }
+
+    REQUIRE( named );
+    REQUIRE( spans == 1 );
+    REQUIRE( counters == 1 );
+    REQUIRE( instants == 1 );
+}
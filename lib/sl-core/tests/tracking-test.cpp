@@ -0,0 +1,196 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023-present Robert Anderson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <mem/allocator.h>
+#include <mem/slab.h>
+#include <mem/tracking.h>
+
+namespace
+{
+
+    struct capture_logger
+    {
+        void info( const char* format, ... )
+        {
+            char buf[512];
+            va_list args;
+            va_start( args, format );
+            std::vsnprintf( buf, sizeof( buf ), format, args );
+            va_end( args );
+            lines.emplace_back( buf );
+        }
+
+        std::vector< std::string > lines;
+    };
+
+}   // namespace
+
+TEST_CASE( "Tracking counts live and peak bytes", "[memory][tracking]" )
+{
+    sl::mem::allocation_stats stats;
+    sl::mem::basic_allocator alloc { sl::mem::tracking_policy< sl::mem::malloc_policy > { stats } };
+
+    auto a = alloc.alloc( 100 );
+    auto b = alloc.alloc( 1000 );
+    REQUIRE( stats.live_bytes() == 1100 );
+    REQUIRE( stats.peak_bytes() == 1100 );
+    REQUIRE( stats.allocations() == 2 );
+
+    alloc.free( a );
+    REQUIRE( stats.live_bytes() == 1000 );
+    REQUIRE( stats.peak_bytes() == 1100 );
+
+    b = alloc.realloc( b, 4000 );
+    REQUIRE( stats.live_bytes() == 4000 );
+    REQUIRE( stats.peak_bytes() == 4000 );
+
+    alloc.free( b );
+    REQUIRE( stats.live_bytes() == 0 );
+    REQUIRE( stats.frees() == 3 );
+
+    auto h = stats.histogram();
+    REQUIRE( h[sl::mem::allocation_stats::bucket( 100 )] == 1 );
+    REQUIRE( h[sl::mem::allocation_stats::bucket( 1000 )] == 1 );
+    REQUIRE( h[sl::mem::allocation_stats::bucket( 4000 )] == 1 );
+}
+
+TEST_CASE( "Tracking attributes call sites", "[memory][tracking]" )
+{
+    sl::mem::allocation_stats stats;
+    sl::mem::basic_allocator alloc { sl::mem::tracking_policy< sl::mem::slab::policy > { stats } };
+
+    std::vector< int* > leaked;
+    for ( int i = 0; i < 3; ++i )
+        leaked.push_back( alloc.at().alloc_t< int >( i ) );   // site A
+
+    {
+        auto sp = alloc.at().alloc_sp< double >( 1.0 );   // site B
+    }
+
+    auto sites = stats.sites();
+    REQUIRE( sites.size() == 2 );
+
+    REQUIRE( sites[0].file.ends_with( "tracking-test.cpp" ) );
+    REQUIRE( sites[0].allocations == 3 );
+    REQUIRE( sites[0].live_blocks == 3 );
+    REQUIRE( sites[0].live_bytes == 3 * sizeof( int ) );
+
+    REQUIRE( sites[1].allocations == 1 );
+    REQUIRE( sites[1].live_blocks == 0 );
+    REQUIRE( sites[1].line != sites[0].line );
+
+    capture_logger logger;
+    stats.log( logger, "test" );
+    REQUIRE( logger.lines.size() >= 3 );
+    REQUIRE( logger.lines[0].find( "live: 12 bytes" ) != std::string::npos );
+
+    for ( auto p : leaked )
+        alloc.free_t( p );
+    REQUIRE( stats.live_bytes() == 0 );
+}
+
+TEST_CASE( "Tracking records the caller's location", "[memory][tracking]" )
+{
+    sl::mem::allocation_stats stats;
+    sl::mem::basic_allocator alloc { sl::mem::tracking_policy< sl::mem::malloc_policy > { stats } };
+
+    auto raw_line = __LINE__ + 1;
+    auto raw      = alloc.alloc( 16 );
+    auto t_line   = __LINE__ + 1;
+    auto t        = alloc.at().alloc_t< int >( 7 );
+    auto sp_line  = __LINE__ + 1;
+    auto sp       = alloc.at().alloc_sp< double >( 2.0 );
+
+    auto sites = stats.sites();
+    REQUIRE( sites.size() == 3 );
+
+    std::vector< uint32_t > lines;
+    for ( const auto& s : sites )
+    {
+        REQUIRE( s.file.ends_with( "tracking-test.cpp" ) );
+        lines.push_back( s.line );
+    }
+
+    std::sort( std::begin( lines ), std::end( lines ) );
+    REQUIRE( lines == std::vector< uint32_t > { static_cast< uint32_t >( raw_line ),
+                                                static_cast< uint32_t >( t_line ),
+                                                static_cast< uint32_t >( sp_line ) } );
+
+    alloc.free( raw );
+    alloc.free_t( t );
+}
+
+TEST_CASE( "Tracking from many threads", "[memory][tracking]" )
+{
+    constexpr int k_threads = 4;
+    constexpr int k_rounds  = 5000;
+
+    sl::mem::allocation_stats stats;
+    sl::mem::basic_allocator alloc { sl::mem::tracking_policy< sl::mem::malloc_policy > { stats } };
+
+    std::vector< std::thread > threads;
+    for ( int t = 0; t < k_threads; ++t )
+    {
+        threads.emplace_back( [&alloc]() {
+            for ( int i = 0; i < k_rounds; ++i )
+                alloc.free( alloc.alloc( 32 ) );
+        } );
+    }
+
+    for ( auto& t : threads )
+        t.join();
+
+    auto sites = stats.sites();
+    REQUIRE( sites.size() == 1 );
+    REQUIRE( sites[0].allocations == k_threads * k_rounds );
+    REQUIRE( sites[0].live_blocks == 0 );
+    REQUIRE( stats.live_bytes() == 0 );
+    REQUIRE( stats.untracked() == 0 );
+}
+
+TEST_CASE( "Tracking compiles out", "[memory][tracking]" )
+{
+    sl::mem::allocation_stats stats;
+    auto policy = sl::mem::track( stats, sl::mem::malloc_policy {} );
+
+#if defined( SL_MEM_TRACKING )
+    STATIC_REQUIRE( std::is_same_v< decltype( policy ),
+                                    sl::mem::tracking_policy< sl::mem::malloc_policy > > );
+#else
+    STATIC_REQUIRE( std::is_same_v< decltype( policy ), sl::mem::malloc_policy > );
+
+    sl::mem::basic_allocator alloc { policy };
+    alloc.free( alloc.alloc( 10 ) );
+    REQUIRE( stats.allocations() == 0 );
+#endif
+}
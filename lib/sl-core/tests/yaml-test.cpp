@@ -0,0 +1,278 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023-present Robert Anderson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+
+
+#include <catch2/catch.hpp>
+#include <test/temp.h>
+
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include <config/json.h>
+#include <config/yaml.h>
+
+namespace
+{
+
+    constexpr auto k_image_yaml = R"(
+# Same document as the JSON image sample
+%YAML 1.2
+---
+Image:
+  Width:  800
+  Height: 600
+  Title:  View from 15th Floor
+  Thumbnail:
+    Url:    "http://www.example.com/image/481989943"
+    Height: 125
+    Width:  100   # pixels
+  Animated : false
+  IDs: [116, 943, 234, -38793]
+  DeletionDate: ~
+  Distance: 12.723374634
+  Servers:
+  - name: alpha
+    ports:
+      - 80
+      - 443
+  - name: 'beta ''two'''
+    ports: []
+  - - nested
+    - { a: 1, b: two, "c/d": null }
+  Empty:
+  Escaped: "tab\there \u00e9 \x41"
+...
+)";
+
+    constexpr auto k_image_json = R"(
+    {
+        "Image": {
+            "Width":  800,
+            "Height": 600,
+            "Title":  "View from 15th Floor",
+            "Thumbnail": {
+                "Url":    "http://www.example.com/image/481989943",
+                "Height": 125,
+                "Width":  100
+            },
+            "Animated" : false,
+            "IDs": [116, 943, 234, -38793],
+            "DeletionDate": null,
+            "Distance": 12.723374634,
+            "Servers": [
+                { "name": "alpha", "ports": [80, 443] },
+                { "name": "beta 'two'", "ports": [] },
+                [ "nested", { "a": 1, "b": "two", "c/d": null } ]
+            ],
+            "Empty": null,
+            "Escaped": "tab\there \u00e9 A"
+        }
+    }
+    )";
+
+    void require_same( const sl::config::snapshot& expected, const sl::config::snapshot& actual )
+    {
+        using sl::config::value_type;
+
+        REQUIRE( expected.size() == actual.size() );
+        expected.for_each( [&]( std::string_view key, value_type type ) {
+            INFO( "key: " << key );
+            REQUIRE( actual.contains( key ) );
+            REQUIRE( actual.type( key ) == type );
+
+            switch ( type )
+            {
+            case value_type::null: break;
+            case value_type::boolean:
+                REQUIRE( actual.get< bool >( key ) == expected.get< bool >( key ) );
+                break;
+            case value_type::integer:
+                REQUIRE( actual.get< int64_t >( key ) == expected.get< int64_t >( key ) );
+                break;
+            case value_type::unsigned_integer:
+                REQUIRE( actual.get< uint64_t >( key ) == expected.get< uint64_t >( key ) );
+                break;
+            case value_type::floating:
+                REQUIRE( actual.get< double >( key ) == expected.get< double >( key ) );
+                break;
+            case value_type::string:
+                REQUIRE( actual.get< std::string_view >( key )
+                         == expected.get< std::string_view >( key ) );
+                break;
+            }
+        } );
+    }
+
+    void require_parse_error( std::string_view yaml, std::string_view what )
+    {
+        INFO( "yaml: " << yaml );
+        try
+        {
+            sl::config::compile_yaml( yaml );
+            FAIL( "expected a parse error" );
+        }
+        catch ( const std::runtime_error& e )
+        {
+            REQUIRE( std::string_view { e.what() }.find( what ) != std::string_view::npos );
+        }
+    }
+
+}   // namespace
+
+TEST_CASE( "YAML config flattens like the JSON config", "[config][yaml]" )
+{
+    const auto yaml = sl::config::compile_yaml( k_image_yaml );
+    require_same( sl::config::compile_json( k_image_json ), yaml );
+
+    REQUIRE( yaml.type( "/Image/Servers/2/1/c~1d" ) == sl::config::value_type::null );
+
+    auto cfg = sl::config::yaml_from_string( k_image_yaml );
+    REQUIRE( cfg.get< int >( "/Image/Thumbnail/Width" ) == 100 );
+    REQUIRE( cfg.get< std::string >( "/Image/Servers/1/name" ) == "beta 'two'" );
+}
+
+TEST_CASE( "YAML scalars follow the core schema", "[config][yaml]" )
+{
+    using sl::config::value_type;
+
+    const auto cfg = sl::config::compile_yaml( R"(
+nulls: [~, null, Null, NULL, ]
+bools: [true, True, TRUE, false, False, FALSE]
+ints: [0, +12, -7, 0x1F, 0o17, 18446744073709551615]
+floats: [1.5, -.5, 1e3, 2.5E-1, .inf, -.Inf, .nan]
+strings: [yes, 0x, 1.2.3, "42", '~', 12 monkeys, -, http://x:80]
+)" );
+
+    for ( const auto key : { "/nulls/0", "/nulls/1", "/nulls/2", "/nulls/3" } )
+        REQUIRE( cfg.type( key ) == value_type::null );
+    REQUIRE_FALSE( cfg.contains( "/nulls/4" ) );   // A trailing comma is not an entry
+
+    REQUIRE( cfg.get< bool >( "/bools/0" ) );
+    REQUIRE( cfg.get< bool >( "/bools/2" ) );
+    REQUIRE_FALSE( cfg.get< bool >( "/bools/4" ) );
+
+    REQUIRE( cfg.type( "/ints/0" ) == value_type::unsigned_integer );
+    REQUIRE( cfg.get< int >( "/ints/1" ) == 12 );
+    REQUIRE( cfg.type( "/ints/2" ) == value_type::integer );
+    REQUIRE( cfg.get< int >( "/ints/2" ) == -7 );
+    REQUIRE( cfg.get< int >( "/ints/3" ) == 31 );
+    REQUIRE( cfg.get< int >( "/ints/4" ) == 15 );
+    REQUIRE( cfg.get< uint64_t >( "/ints/5" ) == UINT64_MAX );
+
+    REQUIRE( cfg.get< double >( "/floats/0" ) == 1.5 );
+    REQUIRE( cfg.get< double >( "/floats/1" ) == -0.5 );
+    REQUIRE( cfg.get< double >( "/floats/2" ) == 1000.0 );
+    REQUIRE( cfg.get< double >( "/floats/3" ) == 0.25 );
+    REQUIRE( std::isinf( cfg.get< double >( "/floats/4" ) ) );
+    REQUIRE( cfg.get< double >( "/floats/5" ) < 0 );
+    REQUIRE( std::isnan( cfg.get< double >( "/floats/6" ) ) );
+
+    for ( int i = 0; i < 8; ++i )
+        REQUIRE( cfg.type( "/strings/" + std::to_string( i ) ) == value_type::string );
+    REQUIRE( cfg.get< std::string_view >( "/strings/5" ) == "12 monkeys" );
+    REQUIRE( cfg.get< std::string_view >( "/strings/7" ) == "http://x:80" );
+}
+
+TEST_CASE( "YAML multi-line scalars", "[config][yaml]" )
+{
+    const auto cfg = sl::config::compile_yaml( R"(
+plain: first
+  second
+
+  third
+literal: |
+  line one
+    indented
+  line three
+
+folded: >-
+  folded
+  text
+
+  paragraph
+keep: |+
+  kept
+
+quoted: "a
+  b\
+  c"
+next: done
+)" );
+
+    REQUIRE( cfg.get< std::string_view >( "/plain" ) == "first second\nthird" );
+    REQUIRE( cfg.get< std::string_view >( "/literal" ) == "line one\n  indented\nline three\n" );
+    REQUIRE( cfg.get< std::string_view >( "/folded" ) == "folded text\nparagraph" );
+    REQUIRE( cfg.get< std::string_view >( "/keep" ) == "kept\n\n" );
+    REQUIRE( cfg.get< std::string_view >( "/quoted" ) == "a bc" );
+    REQUIRE( cfg.get< std::string_view >( "/next" ) == "done" );
+}
+
+TEST_CASE( "YAML empty documents", "[config][yaml]" )
+{
+    REQUIRE( sl::config::compile_yaml( "" ).type( "" ) == sl::config::value_type::null );
+    REQUIRE( sl::config::compile_yaml( "# nothing\n---\n" ).size() == 1 );
+    REQUIRE( sl::config::compile_yaml( "{}" ).type( "" ) == sl::config::value_type::null );
+    REQUIRE( sl::config::compile_yaml( "just text" ).get< std::string_view >( "" )
+             == "just text" );
+}
+
+TEST_CASE( "YAML parse errors", "[config][yaml]" )
+{
+    require_parse_error( "a: 1\n\tb: 2\n", "tabs" );
+    require_parse_error( "a:\n  b: 1\n c: 2\n", "indentation" );
+    require_parse_error( "a: 1\n   b: 2\n", "mapping key" );
+    require_parse_error( "a: &x 1\nb: *x\n", "anchors" );
+    require_parse_error( "a: !!str 1\n", "tags" );
+    require_parse_error( "? a\n: 1\n", "complex keys" );
+    require_parse_error( "a: 1\n---\nb: 2\n", "multiple documents" );
+    require_parse_error( "a: \"open\n", "unterminated" );
+    require_parse_error( "a: [1, 2\n", "unterminated" );
+    require_parse_error( "a: \"\\q\"\n", "escape" );
+    require_parse_error( "a:\n  - 1\n  b: 2\n", "indentation" );
+    require_parse_error( "a: [1] x\n", "after value" );
+    require_parse_error( "a: 1\nb: 2\nc\n", "line 3, column 1" );
+}
+
+TEST_CASE( "YAML config file", "[config][yaml]" )
+{
+    sl::test::temp_file tmp( "sl-yaml-config", ".yaml" );
+    const auto& path = tmp.path;
+    {
+        std::ofstream out( path, std::ios::binary | std::ios::trunc );
+        out << k_image_yaml;
+    }
+
+    const auto cfg = sl::config::load_yaml( path.c_str() );
+    REQUIRE( cfg.get< std::string >( "/Image/Title" ) == "View from 15th Floor" );
+    REQUIRE( cfg.get< int >( "/Image/IDs/3" ) == -38793 );
+    require_same( sl::config::compile_json( k_image_json ),
+                  sl::config::compile_yaml_file( path.c_str() ) );
+}
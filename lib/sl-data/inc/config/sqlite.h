@@ -0,0 +1,429 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023-present Robert Anderson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+
+#ifndef __SQLITE_H_F87A1E9029724EC49938430BA802AD7E__
+#define __SQLITE_H_F87A1E9029724EC49938430BA802AD7E__
+
+#include <time.h>
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+
+#include <sqlite3.h>
+
+#include <config/snapshot.h>
+#include <utils/deferred.h>
+#include <utils/noncopyable.h>
+
+#include <sqlite/command.h>
+#include <sqlite/database.h>
+#include <sqlite/transaction.h>
+
+namespace sl::config
+{
+
+    struct sqlite_options
+    {
+        std::string table                 = "config";
+        std::chrono::milliseconds recheck = std::chrono::milliseconds { 100 };
+        size_t max_cached                 = 64 * 1024;
+    };
+
+
+    /**
+     * Config store over a SQLite table of ( key, value ) rows, usable wherever config::values
+     * is ( e.g. config::values { config::sqlite { db } } ). Values keep SQLite's dynamic
+     * types: integers, reals, text and null, with bools stored as integers.
+     *
+     * Reads go through an in-process cache (misses included) filled by one cached prepared
+     * statement. It is invalidated by:
+     *  - PRAGMA data_version, polled at most once per 'recheck' interval, for commits made
+     *    by other connections (so those show up within that interval);
+     *  - an update hook on the connection, for writes to the table that bypass the store.
+     *    This takes the connection's only update hook slot.
+     * Writes through the store evict just their key. Like the database it wraps, a store
+     * is meant for a single thread.
+     */
+    class sqlite
+    {
+    public:
+        class batch;
+
+        explicit sqlite( data::sqlite::database& db, sqlite_options options = {} )
+            : _state { std::make_unique< state >( db, std::move( options ) ) }
+        {
+            ::sqlite3_update_hook( db, &sqlite::on_update, _state.get() );
+        }
+
+        sqlite( sqlite&& ) noexcept = default;
+        sqlite& operator=( sqlite&& ) = delete;
+
+        ~sqlite() noexcept
+        {
+            if ( _state )
+                ::sqlite3_update_hook( _state->db, nullptr, nullptr );
+        }
+
+        /**
+         * Throws if the key does not exist or its value cannot be read as a T.
+         */
+        template< config_value T >
+        T get( std::string_view key ) const
+        {
+            static_assert( !std::same_as< T, std::string_view >,
+                           "cached values may be evicted at any time, read text as std::string" );
+
+            const auto& v = fetch( key );
+            if ( std::holds_alternative< missing >( v ) )
+                throw std::runtime_error( "config key not found" );
+
+            if constexpr ( std::same_as< T, bool > )
+            {
+                if ( auto i = std::get_if< int64_t >( &v ) )
+                    return *i != 0;
+            }
+            else if constexpr ( std::integral< T > )
+            {
+                if ( auto i = std::get_if< int64_t >( &v ) )
+                {
+                    if ( !std::in_range< T >( *i ) )
+                        throw std::runtime_error( "config value out of range" );
+                    return static_cast< T >( *i );
+                }
+            }
+            else if constexpr ( std::floating_point< T > )
+            {
+                if ( auto i = std::get_if< int64_t >( &v ) )
+                    return static_cast< T >( *i );
+                if ( auto d = std::get_if< double >( &v ) )
+                    return static_cast< T >( *d );
+            }
+            else
+            {
+                if ( auto s = std::get_if< std::string >( &v ) )
+                    return *s;
+            }
+
+            throw std::runtime_error( "config value has the wrong type" );
+        }
+
+        bool contains( std::string_view key ) const
+        {
+            return !std::holds_alternative< missing >( fetch( key ) );
+        }
+
+        template< config_value T >
+        void set( std::string_view key, const T& value )
+        {
+            auto& cmd = _state->upsert;
+            cmd.bind( 1, key );
+
+            if constexpr ( std::same_as< T, bool > )
+            {
+                cmd.bind( 2, int64_t { value ? 1 : 0 } );
+            }
+            else if constexpr ( std::integral< T > )
+            {
+                if ( !std::in_range< int64_t >( value ) )
+                    throw std::runtime_error( "config value out of range" );
+                cmd.bind( 2, static_cast< int64_t >( value ) );
+            }
+            else if constexpr ( std::floating_point< T > )
+            {
+                cmd.bind( 2, static_cast< double >( value ) );
+            }
+            else
+            {
+                cmd.bind( 2, std::string_view { value } );
+            }
+
+            write( cmd, key );
+        }
+
+        void set( std::string_view key, const char* value )
+        {
+            set( key, std::string_view { value } );
+        }
+
+        void set_null( std::string_view key )
+        {
+            _state->upsert.bind( 1, key );
+            _state->upsert.bind( 2, nullptr );
+            write( _state->upsert, key );
+        }
+
+        void erase( std::string_view key )
+        {
+            _state->remove.bind( 1, key );
+            write( _state->remove, key );
+        }
+
+        /**
+         * Groups writes into one IMMEDIATE transaction; see config::sqlite::batch.
+         */
+        batch write_batch();
+
+        void clear_cache() noexcept { _state->cache.clear(); }
+        size_t cached() const noexcept { return _state->cache.size(); }
+
+    private:
+        struct missing
+        {};
+
+        using entry = std::variant< missing, std::nullptr_t, int64_t, double, std::string >;
+
+        struct string_hash
+        {
+            using is_transparent = void;
+            size_t operator()( std::string_view s ) const noexcept
+            {
+                return std::hash< std::string_view > {}( s );
+            }
+        };
+
+        static std::string quoted( std::string_view table )
+        {
+            if ( table.empty() || table.find( '"' ) != std::string_view::npos )
+                throw std::invalid_argument( "invalid config table name" );
+            return "\"" + std::string { table } + "\"";
+        }
+
+        struct state
+        {
+            state( data::sqlite::database& database, sqlite_options opts )
+                : db { database }
+                , options { std::move( opts ) }
+                , table { create_table( db, options.table ) }
+                , select { db.prepare_command( "SELECT value FROM " + table + " WHERE key = ?1" ) }
+                , upsert { db.prepare_command( "INSERT INTO " + table
+                                               + " ( key, value ) VALUES ( ?1, ?2 ) ON CONFLICT ( "
+                                                 "key ) DO UPDATE SET value = excluded.value" ) }
+                , remove { db.prepare_command( "DELETE FROM " + table + " WHERE key = ?1" ) }
+                , version { db.prepare_command( "PRAGMA data_version" ) }
+            {}
+
+            static std::string create_table( data::sqlite::database& db, std::string_view name )
+            {
+                // A rowid table: update hooks are not invoked for WITHOUT ROWID tables
+                auto table = quoted( name );
+                db.execute( "CREATE TABLE IF NOT EXISTS " + table
+                            + " ( key TEXT PRIMARY KEY NOT NULL, value )" );
+                return table;
+            }
+
+            data::sqlite::database& db;
+            sqlite_options options;
+            std::string table;
+
+            data::sqlite::command select;
+            data::sqlite::command upsert;
+            data::sqlite::command remove;
+            data::sqlite::command version;
+
+            std::unordered_map< std::string, entry, string_hash, std::equal_to<> > cache;
+            int64_t data_version = -1;
+            uint64_t next_check  = 0;
+            bool writing         = false;
+        };
+
+        static uint64_t now_ms()
+        {
+#if defined( CLOCK_MONOTONIC_COARSE )
+            timespec ts;
+            ::clock_gettime( CLOCK_MONOTONIC_COARSE, &ts );
+            return static_cast< uint64_t >( ts.tv_sec ) * 1000
+                   + static_cast< uint64_t >( ts.tv_nsec ) / 1'000'000;
+#else
+            using namespace std::chrono;
+            return static_cast< uint64_t >(
+                duration_cast< milliseconds >( steady_clock::now().time_since_epoch() ).count() );
+#endif
+        }
+
+        /**
+         * Runs a statement, leaving it reset (and reusable) even when it fails.
+         */
+        template< typename Fn >
+        static auto run( data::sqlite::command& cmd, Fn&& fn )
+        {
+            try
+            {
+                auto result = fn();
+                cmd.reset();
+                return result;
+            }
+            catch ( ... )
+            {
+                try
+                {
+                    cmd.reset();
+                }
+                catch ( const data::sqlite::error& )
+                {
+                    // Reset repeats the failed step's error; the statement is usable again
+                }
+                throw;
+            }
+        }
+
+        void revalidate() const
+        {
+            auto& s   = *_state;
+            auto when = now_ms();
+            if ( when < s.next_check )
+                return;
+            s.next_check = when + static_cast< uint64_t >( s.options.recheck.count() );
+
+            auto v = run( s.version, [&]() -> int64_t {
+                return s.version.step() ? s.version.column_int64( 0 ) : 0;
+            } );
+            if ( v != s.data_version )
+            {
+                s.data_version = v;
+                s.cache.clear();
+            }
+        }
+
+        const entry& fetch( std::string_view key ) const
+        {
+            auto& s = *_state;
+            revalidate();
+
+            auto it = s.cache.find( key );
+            if ( it != s.cache.end() )
+                return it->second;
+
+            if ( s.cache.size() >= s.options.max_cached )
+                s.cache.clear();
+
+            s.select.bind( 1, key );
+            auto value = run( s.select, [&]() -> entry {
+                if ( !s.select.step() )
+                    return missing {};
+
+                switch ( s.select.column_type( 0 ) )
+                {
+                case SQLITE_INTEGER:
+                    return s.select.column_int64( 0 );
+                case SQLITE_FLOAT:
+                    return s.select.column_double( 0 );
+                case SQLITE_NULL:
+                    return nullptr;
+                default:
+                    return std::string { s.select.column_text( 0 ) };
+                }
+            } );
+
+            return s.cache.emplace( std::string { key }, std::move( value ) ).first->second;
+        }
+
+        void write( data::sqlite::command& cmd, std::string_view key )
+        {
+            auto& s   = *_state;
+            s.writing = true;
+            auto _    = sl::utils::deferred( [&s]() { s.writing = false; } );
+
+            run( cmd, [&] {
+                cmd.execute( false );
+                return 0;
+            } );
+
+            if ( auto it = s.cache.find( key ); it != s.cache.end() )
+                s.cache.erase( it );
+        }
+
+        static void on_update( void* p, int, const char*, const char* table, sqlite3_int64 )
+        {
+            auto& s = *static_cast< state* >( p );
+            if ( !s.writing && s.options.table == table )
+                s.cache.clear();
+        }
+
+    private:
+        std::unique_ptr< state > _state;
+    };
+
+
+    /**
+     * A set of writes applied in one IMMEDIATE transaction, and so one fsync. Destroying an
+     * uncommitted batch rolls it back; the cache is dropped since reads made during the
+     * batch may have cached uncommitted values.
+     */
+    class sqlite::batch : sl::utils::noncopyable
+    {
+    public:
+        ~batch() noexcept
+        {
+            if ( !_committed )
+            {
+                _transaction.rollback();
+                _store.clear_cache();
+            }
+        }
+
+        template< config_value T >
+        void set( std::string_view key, const T& value )
+        {
+            _store.set( key, value );
+        }
+
+        void set( std::string_view key, const char* value ) { _store.set( key, value ); }
+        void set_null( std::string_view key ) { _store.set_null( key ); }
+        void erase( std::string_view key ) { _store.erase( key ); }
+
+        void commit()
+        {
+            _transaction.commit();
+            _committed = true;
+        }
+
+    private:
+        friend class sqlite;
+
+        explicit batch( sqlite& store )
+            : _store { store }
+            , _transaction { store._state->db, data::sqlite::transaction::mode::immediate }
+        {}
+
+        sqlite& _store;
+        data::sqlite::transaction _transaction;
+        bool _committed = false;
+    };
+
+    inline sqlite::batch sqlite::write_batch() { return batch { *this }; }
+
+}   // namespace sl::config
+
+
+#endif /* __SQLITE_H_F87A1E9029724EC49938430BA802AD7E__ */
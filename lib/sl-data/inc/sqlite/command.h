@@ -25,10 +25,13 @@
 #ifndef __COMMAND_H_B1FB2EA91B604B64A083743B46F3EB24__
 #define __COMMAND_H_B1FB2EA91B604B64A083743B46F3EB24__
 
+#include <cstddef>
+#include <cstdint>
 #include <string_view>
 #include <type_traits>
 
 #include <sqlite3.h>
+#include <trace/trace.h>
 #include <utils/noncopyable.h>
 
 #include "./error.h"
@@ -50,10 +53,6 @@ namespace sl::data::sqlite
          * A collection of methods for binding parameters / values.
          **/
 
-        template< typename T >
-        void bind( int, T );
-
-        template<>
         inline void bind( int index, std::string_view value )
         {
             sqlite::error::throw_if(
@@ -63,13 +62,11 @@ namespace sl::data::sqlite
                 _db );
         }
 
-        template<>
         inline void bind( int index, const char* value )
         {
             bind( index, std::string_view { value } );
         }
 
-        template<>
         inline void bind( int index, int value )
         {
             sqlite::error::throw_if( ::sqlite3_bind_int( _stmt, index, value ),
@@ -78,7 +75,14 @@ namespace sl::data::sqlite
                                      _db );
         }
 
-        template<>
+        inline void bind( int index, int64_t value )
+        {
+            sqlite::error::throw_if( ::sqlite3_bind_int64( _stmt, index, value ),
+                                     "sqlite3_bind_int64",
+                                     "failed to bind integer value to prepared statement",
+                                     _db );
+        }
+
         inline void bind( int index, double value )
         {
             sqlite::error::throw_if( ::sqlite3_bind_double( _stmt, index, value ),
@@ -87,6 +91,14 @@ namespace sl::data::sqlite
                                      _db );
         }
 
+        inline void bind( int index, std::nullptr_t )
+        {
+            sqlite::error::throw_if( ::sqlite3_bind_null( _stmt, index ),
+                                     "sqlite3_bind_null",
+                                     "failed to bind null value to prepared statement",
+                                     _db );
+        }
+
         template< typename T >
         inline void bind( const char* name, T value )
         {
@@ -105,8 +117,26 @@ namespace sl::data::sqlite
          * Command execution (and reset) methods
          **/
 
+        /**
+         * Steps a query; true while it yields a row to read with the column methods. Call
+         * reset() once done with the rows.
+         */
+        inline bool step()
+        {
+            SL_TRACE_SPAN( "sqlite", "step" );
+
+            auto code = ::sqlite3_step( _stmt );
+            if ( code == SQLITE_ROW )
+                return true;
+            if ( code != SQLITE_DONE )
+                sqlite::error::throw_if( code, "sqlite3_step", "failed to run SQL statement", _db );
+            return false;
+        }
+
         inline void execute( bool auto_reset = true )
         {
+            SL_TRACE_SPAN( "sqlite", "execute" );
+
             auto code = ::sqlite3_step( _stmt );
             if ( code != SQLITE_DONE )
                 sqlite::error::throw_if( code, "sqlite3_step", "failed to run SQL statement", _db );
@@ -127,6 +157,32 @@ namespace sl::data::sqlite
                                      _db );
         }
 
+
+        /**
+         * Column accessors for the current row (see step()). Text views stay valid until the
+         * next step / reset.
+         **/
+
+        inline int column_type( int index ) const { return ::sqlite3_column_type( _stmt, index ); }
+
+        inline int64_t column_int64( int index ) const
+        {
+            return ::sqlite3_column_int64( _stmt, index );
+        }
+
+        inline double column_double( int index ) const
+        {
+            return ::sqlite3_column_double( _stmt, index );
+        }
+
+        inline std::string_view column_text( int index ) const
+        {
+            // Text first: sqlite3_column_bytes reports the size of that conversion
+            auto text = reinterpret_cast< const char* >( ::sqlite3_column_text( _stmt, index ) );
+            auto size = static_cast< size_t >( ::sqlite3_column_bytes( _stmt, index ) );
+            return { text ? text : "", size };
+        }
+
     private:
         sqlite3* _db;
         sqlite3_stmt* _stmt;
@@ -29,6 +29,7 @@
 
 #include <sqlite3.h>
 #include <utils/deferred.h>
+#include <utils/noncopyable.h>
 
 #include "./command.h"
 #include "./error.h"
@@ -36,7 +37,7 @@
 namespace sl::data::sqlite
 {
 
-    struct database
+    struct database : sl::utils::noncopyable
     {
         explicit database( const char* uri )
             : _db { nullptr }
@@ -70,13 +71,14 @@ namespace sl::data::sqlite
 
         void execute( std::string_view sql )
         {
-            char* err;
+            char* err { nullptr };
             auto code = ::sqlite3_exec( _db, sql.data(), nullptr, nullptr, &err );
             if ( code == SQLITE_OK )
                 return;
 
+            // Free the message once the exception has copied it
+            auto _ = sl::utils::deferred( [=]() { ::sqlite3_free( err ); } );
             sqlite::error::throw_if( code, "sqlite3_exec", "failed to execute SQL statement", err );
-            sqlite3_free( err );
         }
 
         sqlite::command prepare_command( std::string_view sql )
@@ -90,6 +92,8 @@ namespace sl::data::sqlite
             return sqlite::command { _db, stmt };
         }
 
+        operator sqlite3*() const noexcept { return _db; }
+
     private:
         sqlite3* _db;
     };
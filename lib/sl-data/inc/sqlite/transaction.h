@@ -69,7 +69,11 @@ namespace sl::data::sqlite
                 rollback();
         }
 
-        inline void commit() noexcept
+        /**
+         * Throws if the commit fails (e.g. SQLITE_BUSY); the transaction is then rolled back
+         * when it goes out of scope.
+         */
+        inline void commit()
         {
             if ( _active )
                 _db.execute( "COMMIT" );
@@ -78,13 +82,22 @@ namespace sl::data::sqlite
 
         inline void rollback() noexcept
         {
-            if ( _active )
-                _db.execute( "ROLLBACK" );
+            if ( !_active )
+                return;
+
             _active = false;
+            try
+            {
+                _db.execute( "ROLLBACK" );
+            }
+            catch ( const sqlite::error& )
+            {
+                // SQLite may already have rolled back on its own (e.g. after SQLITE_FULL)
+            }
         }
 
     private:
-        sqlite::db& _db;
+        sqlite::database& _db;
         bool _active;
     };
 
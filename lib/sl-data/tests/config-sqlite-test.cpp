@@ -0,0 +1,154 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023-present Robert Anderson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+
+#include <catch2/catch.hpp>
+#include <test/temp.h>
+
+#include <chrono>
+#include <stdexcept>
+#include <string>
+
+#include <config/sqlite.h>
+#include <config/values.h>
+#include <sqlite/database.h>
+#include <sqlite/init.h>
+
+namespace
+{
+
+    // The bundled SQLite is built with SQLITE_OMIT_AUTOINIT
+    const sl::data::sqlite::lib_init k_sqlite_init;
+
+    struct temp_db : sl::test::temp_file
+    {
+        temp_db()
+            : temp_file { "sl-data-config-test", ".db" }
+        {}
+
+        std::string uri() const { return "file:" + path.string(); }
+    };
+
+}   // namespace
+
+TEST_CASE( "SQLite config stores typed values", "[data][config]" )
+{
+    sl::data::sqlite::database db { "file::memory:" };
+    sl::config::sqlite store { db };
+
+    store.set( "/net/port", 8080 );
+    store.set( "/net/host", "example.com" );
+    store.set( "/net/secure", true );
+    store.set( "/net/timeout", 2.5 );
+    store.set( "/net/retries", uint64_t { 3 } );
+    store.set_null( "/net/proxy" );
+
+    REQUIRE( store.get< int >( "/net/port" ) == 8080 );
+    REQUIRE( store.get< std::string >( "/net/host" ) == "example.com" );
+    REQUIRE( store.get< bool >( "/net/secure" ) );
+    REQUIRE( store.get< double >( "/net/timeout" ) == 2.5 );
+    REQUIRE( store.get< double >( "/net/port" ) == 8080.0 );
+    REQUIRE( store.get< uint8_t >( "/net/retries" ) == 3 );
+    REQUIRE( store.contains( "/net/proxy" ) );
+    REQUIRE_FALSE( store.contains( "/net/missing" ) );
+
+    REQUIRE_THROWS_AS( store.get< int >( "/net/missing" ), std::runtime_error );
+    REQUIRE_THROWS_AS( store.get< int >( "/net/host" ), std::runtime_error );
+    REQUIRE_THROWS_AS( store.get< int >( "/net/proxy" ), std::runtime_error );
+    REQUIRE_THROWS_AS( store.get< int8_t >( "/net/port" ), std::runtime_error );
+    REQUIRE_THROWS_AS( store.set( "/big", UINT64_MAX ), std::runtime_error );
+
+    // Overwrites and erases evict the cached value
+    store.set( "/net/port", 9090 );
+    REQUIRE( store.get< int >( "/net/port" ) == 9090 );
+    store.erase( "/net/port" );
+    REQUIRE_FALSE( store.contains( "/net/port" ) );
+}
+
+TEST_CASE( "SQLite config works through config::values", "[data][config]" )
+{
+    sl::data::sqlite::database db { "file::memory:" };
+    {
+        sl::config::sqlite store { db, { .table = "settings" } };
+        store.set( "/a", 1 );
+    }
+
+    auto cfg = sl::config::values { sl::config::sqlite { db, { .table = "settings" } } };
+    REQUIRE( cfg.get< int >( "/a" ) == 1 );
+}
+
+TEST_CASE( "SQLite config batches writes in one transaction", "[data][config]" )
+{
+    sl::data::sqlite::database db { "file::memory:" };
+    sl::config::sqlite store { db };
+    store.set( "/keep", 1 );
+
+    {
+        auto batch = store.write_batch();
+        for ( int i = 0; i < 1000; ++i )
+            batch.set( "/tenant/" + std::to_string( i ) + "/quota", i );
+        batch.erase( "/keep" );
+        REQUIRE_FALSE( store.contains( "/keep" ) );   // Reads see the batch's own writes
+        batch.commit();
+    }
+    REQUIRE( store.get< int >( "/tenant/999/quota" ) == 999 );
+    REQUIRE_FALSE( store.contains( "/keep" ) );
+
+    {
+        auto batch = store.write_batch();
+        batch.set( "/tenant/1/quota", -1 );
+        batch.set( "/uncommitted", 1 );
+        REQUIRE( store.get< int >( "/tenant/1/quota" ) == -1 );
+    }
+    REQUIRE( store.get< int >( "/tenant/1/quota" ) == 1 );
+    REQUIRE_FALSE( store.contains( "/uncommitted" ) );
+}
+
+TEST_CASE( "SQLite config cache follows writes made elsewhere", "[data][config]" )
+{
+    temp_db file;
+    sl::data::sqlite::database db { file.uri().c_str() };
+    sl::config::sqlite store { db, { .recheck = std::chrono::milliseconds { 0 } } };
+
+    store.set( "/n", 1 );
+    REQUIRE( store.get< int >( "/n" ) == 1 );
+    REQUIRE( store.cached() == 1 );
+
+    SECTION( "another connection (data_version)" )
+    {
+        sl::data::sqlite::database other { file.uri().c_str() };
+        sl::config::sqlite writer { other };
+        writer.set( "/n", 2 );
+
+        REQUIRE( store.get< int >( "/n" ) == 2 );
+    }
+
+    SECTION( "the same connection, bypassing the store (update hook)" )
+    {
+        db.execute( "UPDATE config SET value = 3 WHERE key = '/n'" );
+        REQUIRE( store.cached() == 0 );
+        REQUIRE( store.get< int >( "/n" ) == 3 );
+    }
+}
@@ -0,0 +1,157 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023-present Robert Anderson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+
+#ifndef __CONFIG_WATCHER_H_CDF40006FC4146D39E441424AD056315__
+#define __CONFIG_WATCHER_H_CDF40006FC4146D39E441424AD056315__
+
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <utility>
+
+#include <uv.h>
+
+#include <config/live.h>
+#include <utils/noncopyable.h>
+
+#include "./fs-event.h"
+#include "./loop.h"
+#include "./timer.h"
+
+namespace sl::uv
+{
+
+    /**
+     * Reloads a config file when it changes and publishes the result to a config::live.
+     *
+     * The parent directory is watched rather than the file, so editors that save by
+     * writing a temporary file and renaming it over the original keep triggering reloads.
+     * Bursts of events are coalesced by a short debounce timer. Each reload runs the
+     * loader (e.g. sl::config::load_json or sl::config::compile_json_file) and then the
+     * validator; a load that throws or fails validation is logged and the current snapshot
+     * stays in place.
+     */
+    template< typename Logger, typename Snapshot >
+    class config_watcher : sl::utils::noncopyable
+    {
+    public:
+        using loader_fn    = std::function< Snapshot( const char* ) >;
+        using validator_fn = std::function< bool( const Snapshot& ) >;
+
+        explicit config_watcher( uv::loop< Logger >& loop,
+                                 Logger& logger,
+                                 const std::filesystem::path& path,
+                                 config::live< Snapshot >& target,
+                                 loader_fn load,
+                                 validator_fn validate = {},
+                                 uint64_t debounce_ms  = 50 )
+            : _logger { logger }
+            , _path { path.string() }
+            , _file { path.filename().string() }
+            , _target { target }
+            , _load { std::move( load ) }
+            , _validate { std::move( validate ) }
+            , _debounce_ms { debounce_ms }
+            , _debounce { loop, [this]() { reload(); } }
+            , _watch { loop,
+                       directory_of( path ).c_str(),
+                       [this]( const char* name, int status ) { on_change( name, status ); } }
+        {}
+
+        uint64_t reloads() const noexcept { return _reloads; }
+        uint64_t rejected() const noexcept { return _rejected; }
+
+        /**
+         * Loads, validates and publishes the file now.
+         */
+        bool reload()
+        {
+            try
+            {
+                auto next = _load( _path.c_str() );
+                if ( _validate && !_validate( next ) )
+                {
+                    ++_rejected;
+                    _logger.warn( "Config '%s' changed but failed validation; keeping the "
+                                  "current snapshot",
+                                  _path.c_str() );
+                    return false;
+                }
+
+                _target.publish( std::move( next ) );
+                ++_reloads;
+                _logger.info( "Config '%s' reloaded (generation %llu)",
+                              _path.c_str(),
+                              static_cast< unsigned long long >( _target.generation() ) );
+                return true;
+            }
+            catch ( const std::exception& ex )
+            {
+                ++_rejected;
+                _logger.error( "Config '%s' changed but failed to load: %s; keeping the "
+                               "current snapshot",
+                               _path.c_str(),
+                               ex.what() );
+                return false;
+            }
+        }
+
+    private:
+        static std::string directory_of( const std::filesystem::path& path )
+        {
+            auto dir = path.parent_path();
+            return dir.empty() ? std::string { "." } : dir.string();
+        }
+
+        void on_change( const char* name, int status )
+        {
+            SL_UV_LOG_IF( _logger, status, "uv_fs_event", "config watch failed" );
+            if ( status != 0 || ( name && _file != name ) )
+                return;
+
+            _debounce.start( _debounce_ms );
+        }
+
+    private:
+        Logger& _logger;
+        std::string _path;
+        std::string _file;
+        config::live< Snapshot >& _target;
+        loader_fn _load;
+        validator_fn _validate;
+        uint64_t _debounce_ms;
+        uint64_t _reloads  = 0;
+        uint64_t _rejected = 0;
+
+        uv::timer< Logger, std::function< void() > > _debounce;
+        uv::fs_event< Logger, std::function< void( const char*, int ) > > _watch;
+    };
+
+}   // namespace sl::uv
+
+#endif /* __CONFIG_WATCHER_H_CDF40006FC4146D39E441424AD056315__ */
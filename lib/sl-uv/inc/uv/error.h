@@ -28,6 +28,8 @@
 #include <stdexcept>
 #include <uv.h>
 
+#include <logging/limit.h>
+
 namespace sl::uv
 {
 
@@ -75,4 +77,27 @@ namespace sl::uv
 
 }   // namespace sl::uv
 
+/**
+ * Rate limited uv::error::log_if, for calls that can fail in a hot loop (watcher callbacks,
+ * loop teardown) where a storm must not saturate the logger and stall the loop thread. Each
+ * expansion owns its limiter (see SL_LOG_LIMITED_TO), so one failing source cannot hide
+ * errors reported from anywhere else.
+ */
+#define SL_UV_LOG_IF( logger, code, api, message )                                                 \
+    do                                                                                             \
+    {                                                                                              \
+        const int sl_uv_code_ = ( code );                                                          \
+        if ( sl_uv_code_ != 0 )                                                                    \
+            SL_LOG_LIMITED_TO( logger,                                                             \
+                               sl::logging::log_level::error,                                      \
+                               20,                                                                 \
+                               50,                                                                 \
+                               "*** UV ERROR *** '%s' failed: %s (Error: %d / %s) - %s",           \
+                               api,                                                                \
+                               message,                                                            \
+                               sl_uv_code_,                                                        \
+                               ::uv_err_name( sl_uv_code_ ),                                       \
+                               ::uv_strerror( sl_uv_code_ ) );                                     \
+    } while ( 0 )
+
 #endif /* __ERROR_H_7B71C74D57224A61B242BD41E35C53FE__ */
@@ -0,0 +1,71 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023-present Robert Anderson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+
+#ifndef __FS_EVENT_H_B76A321572BD41CE80B6EAF3E4D7CAB5__
+#define __FS_EVENT_H_B76A321572BD41CE80B6EAF3E4D7CAB5__
+
+#include <uv.h>
+
+#include "./error.h"
+#include "./handle.h"
+#include "./loop.h"
+
+namespace sl::uv
+{
+
+    /**
+     * Watches a file or directory for changes. The callable receives the name of the
+     * entry that changed (relative to a watched directory; may be null) and the uv status.
+     */
+    template< typename Logger, typename Callable >
+    class fs_event : handle< uv_fs_event_t >
+    {
+    public:
+        explicit fs_event( uv::loop< Logger >& loop, const char* path, Callable fn )
+            : _fn( fn )
+        {
+            uv::error::throw_if( ::uv_fs_event_init( loop, *this ),
+                                 "uv_fs_event_init",
+                                 "error initializing fs event handle" );
+
+            uv::error::throw_if( ::uv_fs_event_start( *this, &fs_event::on_event, path, 0 ),
+                                 "uv_fs_event_start",
+                                 "failed to start watching path" );
+        }
+
+    private:
+        static void on_event( uv_fs_event_t* h, const char* filename, int, int status )
+        {
+            handle::self< fs_event >( h )->_fn( filename, status );
+        }
+
+    private:
+        Callable _fn;
+    };
+
+}   // namespace sl::uv
+
+#endif /* __FS_EVENT_H_B76A321572BD41CE80B6EAF3E4D7CAB5__ */
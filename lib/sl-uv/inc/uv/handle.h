@@ -27,6 +27,7 @@
 
 #include <uv.h>
 
+#include <mem/slab.h>
 #include <utils/pointers.h>
 
 namespace sl::uv
@@ -37,7 +38,7 @@ namespace sl::uv
     {
     public:
         explicit handle()
-            : _handle { new HandleType }
+            : _handle { mem::object_pool< HandleType >::make() }
         {
             _handle->data = this;
         }
@@ -61,9 +62,9 @@ namespace sl::uv
 
         static void on_closed( uv_handle_t* h )
         {
-            // Handle closing is asynchronous. When it is complete, then we can delete
-            // the underlying type
-            delete reinterpret_cast< HandleType* >( h );
+            // Handle closing is asynchronous. When it is complete, then we can return
+            // the underlying type to the pool
+            mem::object_pool< HandleType >::destroy( reinterpret_cast< HandleType* >( h ) );
         }
 
     protected:
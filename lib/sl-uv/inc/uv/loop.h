@@ -27,6 +27,7 @@
 
 #include <uv.h>
 
+#include <trace/trace.h>
 #include <utils/noncopyable.h>
 
 #include "./error.h"
@@ -60,26 +61,47 @@ namespace sl::uv
             ::uv_walk( &_loop, &loop::on_walk, nullptr );
 
             // We need to purge the UV loop to catch any handle closes
-            uv::error::log_if( _logger,
-                               ::uv_run( &_loop, UV_RUN_DEFAULT ),
-                               "uv_run",
-                               "failed drain loop on teardown" );
+            SL_UV_LOG_IF( _logger,
+                          ::uv_run( &_loop, UV_RUN_DEFAULT ),
+                          "uv_run",
+                          "failed drain loop on teardown" );
 
             // Now shutdown the loop
-            uv::error::log_if( _logger,
-                               ::uv_loop_close( &_loop ),
-                               "uv_loop_close",
-                               "failed tearing down the uv loop" );
+            SL_UV_LOG_IF( _logger,
+                          ::uv_loop_close( &_loop ),
+                          "uv_loop_close",
+                          "failed tearing down the uv loop" );
         }
 
         operator uv_loop_t*() noexcept { return &_loop; }
 
         void run( run_mode mode = run_mode::normal )
         {
-            ::uv_run( &_loop, static_cast< uv_run_mode >( mode ) );
+            if ( mode == run_mode::normal && sl::trace::active() )
+            {
+                // Drive the loop one iteration at a time so each shows up as its own span.
+                // uv_stop only ends the current iteration here, hence our own stop flag.
+                while ( !_stopping )
+                {
+                    SL_TRACE_SPAN( "uv", "loop iteration" );
+                    if ( ::uv_run( &_loop, UV_RUN_ONCE ) == 0 )
+                        break;
+                }
+            }
+            else
+            {
+                SL_TRACE_SPAN( "uv", "loop run" );
+                ::uv_run( &_loop, static_cast< uv_run_mode >( mode ) );
+            }
+
+            _stopping = false;
         }
 
-        void stop() { ::uv_stop( &_loop ); }
+        void stop()
+        {
+            _stopping = true;
+            ::uv_stop( &_loop );
+        }
 
     private:
         static void on_walk( uv_handle_t* h, void* )
@@ -110,6 +132,7 @@ case UV_##uc:
     private:
         Logger& _logger;
         uv_loop_t _loop;
+        bool _stopping = false;
     };
 
 }   // namespace sl::uv
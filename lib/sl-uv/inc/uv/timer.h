@@ -43,17 +43,34 @@ namespace sl::uv
         {}
 
         explicit timer( uv::loop< Logger >& loop, uint64_t timeout, uint64_t repeat, Callable fn )
+            : timer( loop, fn )
+        {
+            start( timeout, repeat );
+        }
+
+        /**
+         * Creates the timer without starting it.
+         */
+        explicit timer( uv::loop< Logger >& loop, Callable fn )
             : _fn( fn )
         {
             uv::error::throw_if( ::uv_timer_init( loop, *this ),
                                  "uv_timer_init",
                                  "error initializing timer handle" );
+        }
 
+        /**
+         * (Re)starts the timer; a pending timeout is replaced.
+         */
+        void start( uint64_t timeout, uint64_t repeat = 0 )
+        {
             uv::error::throw_if( ::uv_timer_start( *this, &timer::on_timer, timeout, repeat ),
                                  "uv_timer_start",
                                  "failed to start timer" );
         }
 
+        void stop() { ::uv_timer_stop( *this ); }
+
     private:
         static void on_timer( uv_timer_t* h ) { handle::self< timer >( h )->_fn(); }
 
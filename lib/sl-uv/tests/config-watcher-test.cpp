@@ -0,0 +1,142 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023-present Robert Anderson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+
+#include <catch2/catch.hpp>
+#include <test/async.h>
+#include <test/temp.h>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include <config/json.h>
+#include <config/live.h>
+#include <logging/logger.h>
+#include <uv/config-watcher.h>
+#include <uv/timer.h>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+
+    void write_file( const std::filesystem::path& path, const std::string& text )
+    {
+        std::ofstream out { path, std::ios::trunc };
+        out << text;
+    }
+
+    void replace_file( const std::filesystem::path& path, const std::string& text )
+    {
+        // The usual editor save: write elsewhere, then rename over the original
+        auto tmp = path;
+        tmp += ".tmp";
+        write_file( tmp, text );
+        std::filesystem::rename( tmp, path );
+    }
+
+}   // namespace
+
+TEST_CASE( "Config watcher reloads, validates and publishes", "[uv][config]" )
+{
+    sl::test::temp_dir dir( "sl-uv-config-watcher-test" );
+    const auto path = dir.path / "app.json";
+
+    write_file( path, R"({"net":{"port":8080}})" );
+
+    using snapshot = sl::config::snapshot;
+    sl::config::live< snapshot > live { sl::config::compile_json_file( path.c_str() ) };
+    auto original = live.current();
+
+    auto [completed, steps] = sl::test::run_async< int >( 5000ms, [&]() -> int {
+        sl::logging::logger logger;
+        sl::uv::loop loop( logger );
+
+        sl::uv::config_watcher< sl::logging::logger, snapshot > watcher {
+            loop,
+            logger,
+            path,
+            live,
+            []( const char* p ) { return sl::config::compile_json_file( p ); },
+            []( const snapshot& s ) { return s.get< int >( "/net/port" ) > 0; },
+            10,
+        };
+
+        // Drive the file through a sequence of edits, one step per settled reload
+        int step          = 0;
+        uint64_t rejected = 0;
+        auto wait_ms      = 0;
+        sl::uv::timer driver( loop, 10, 10, [&]() {
+            wait_ms += 10;
+            switch ( step )
+            {
+            case 0:
+                write_file( path, R"({"net":{"port":9090}})" );
+                step = 1;
+                break;
+            case 1:
+                if ( live.generation() != 2 )
+                    break;
+                write_file( path, R"({"net":{"port":)" );   // Broken JSON
+                rejected = watcher.rejected();
+                step     = 2;
+                break;
+            case 2:
+                if ( watcher.rejected() == rejected )
+                    break;
+                replace_file( path, R"({"net":{"port":0}})" );   // Fails validation
+                rejected = watcher.rejected();
+                step     = 3;
+                break;
+            case 3:
+                if ( watcher.rejected() == rejected )
+                    break;
+                replace_file( path, R"({"net":{"port":7070}})" );
+                step = 4;
+                break;
+            case 4:
+                if ( live.current()->get< int >( "/net/port" ) == 7070 )
+                {
+                    step = 5;
+                    loop.stop();
+                }
+                break;
+            }
+
+            if ( wait_ms > 4000 )
+                loop.stop();
+        } );
+
+        loop.run();
+        return step;
+    } );
+
+    REQUIRE( completed );
+    REQUIRE( steps == 5 );
+    REQUIRE( live.current()->get< int >( "/net/port" ) == 7070 );
+    REQUIRE( original->get< int >( "/net/port" ) == 8080 );
+}
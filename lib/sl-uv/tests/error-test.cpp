@@ -0,0 +1,72 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023-present Robert Anderson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <catch2/catch.hpp>
+
+#include <string>
+#include <vector>
+
+#include <logging/logger.h>
+#include <uv/error.h>
+
+namespace
+{
+
+    struct capture_sink : sl::logging::sink
+    {
+        void write( std::span< const std::string_view > batch ) override
+        {
+            for ( auto line : batch )
+                lines.emplace_back( line );
+        }
+
+        std::vector< std::string > lines;
+    };
+
+}   // namespace
+
+TEST_CASE( "UV errors are rate limited per call site", "[uv][error]" )
+{
+    capture_sink sink;
+    sl::logging::logger logger( sink );
+
+    auto storm = [&] { SL_UV_LOG_IF( logger, UV_ENOENT, "uv_fs_event", "watch failed" ); };
+    auto other = [&] { SL_UV_LOG_IF( logger, UV_EBUSY, "uv_loop_close", "teardown failed" ); };
+
+    for ( int i = 0; i < 1000; ++i )
+        storm();
+
+    const auto logged = sink.lines.size();
+    REQUIRE( logged >= 50 );
+    REQUIRE( logged < 1000 );
+
+    // The storm above does not use up the other call site's budget.
+    other();
+    REQUIRE( sink.lines.size() == logged + 1 );
+    REQUIRE( sink.lines.back().find( "'uv_loop_close' failed: teardown failed" )
+             != std::string::npos );
+
+    SL_UV_LOG_IF( logger, 0, "uv_run", "never logged" );
+    REQUIRE( sink.lines.size() == logged + 1 );
+}
@@ -27,7 +27,10 @@
 
 #include <uv.h>
 
+#include <cstring>
+
 #include <logging/logger.h>
+#include <trace/trace.h>
 #include <uv/idler.h>
 
 using namespace std::chrono_literals;
@@ -61,6 +64,38 @@ TEST_CASE( "UV idler executes each loop iteration", "[uv]" )
     REQUIRE( count == 10 );
 }
 
+TEST_CASE( "UV loop traces each iteration and honors stop", "[uv][trace]" )
+{
+    sl::trace::clear();
+    sl::trace::start();
+
+    auto [completed, count] = sl::test::run_async< int >( 2000ms, []() -> int {
+        int count = 0;
+        sl::logging::logger logger;
+        sl::uv::loop loop( logger );
+        sl::uv::idler idler( loop, [&]() {
+            if ( ++count == 5 )
+                loop.stop();
+        } );
+
+        loop.run();
+        return count;
+    } );
+
+    sl::trace::stop();
+
+    size_t iterations = 0;
+    sl::trace::for_each_record( [&]( const sl::trace::record& r ) {
+        if ( std::strcmp( r.name, "loop iteration" ) == 0 )
+            ++iterations;
+    } );
+    sl::trace::clear();
+
+    REQUIRE( completed );
+    REQUIRE( count == 5 );
+    REQUIRE( iterations == 5 );
+}
+
 TEST_CASE( "UV loop outlives idler", "[uv]" )
 {
     std::atomic< int > count { 0 };
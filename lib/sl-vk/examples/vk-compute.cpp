@@ -24,13 +24,15 @@
 
 #include <algorithm>
 #include <array>
-#include <chrono>
+#include <cstring>
 #include <random>
 #include <span>
 #include <vector>
 
 #include <io/load.h>
+#include <logging/limit.h>
 #include <logging/logger.h>
+#include <trace/trace.h>
 #include <utils/fs.h>
 #include <utils/version.h>
 
@@ -45,6 +47,11 @@
 #include <vk/compute/context.h>
 #include <vk/compute/program.h>
 
+// Validation layers can flood the debug callback, so each report in it is rate limited on its
+// own (see SL_LOG_LIMITED_TO), with the number dropped logged when it gets through again.
+#define SL_VK_DEBUG_LOG( level, ... )                                                              \
+    SL_LOG_LIMITED_TO( debug_logger, sl::logging::log_level::level, 50, 200, __VA_ARGS__ )
+
 namespace
 {
 
@@ -68,30 +75,30 @@ namespace
     {
         if ( type == VK_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT )
         {
-            debug_logger.warn( "*** Performance *** ==> %s", pCallbackData->pMessage );
+            SL_VK_DEBUG_LOG( warning, "*** Performance *** ==> %s", pCallbackData->pMessage );
             return VK_FALSE;
         }
 
         switch ( severity )
         {
         case VK_DEBUG_UTILS_MESSAGE_SEVERITY_VERBOSE_BIT_EXT:
-            debug_logger.trace( pCallbackData->pMessage );
+            SL_VK_DEBUG_LOG( trace, pCallbackData->pMessage );
             break;
 
         case VK_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT:
-            debug_logger.info( pCallbackData->pMessage );
+            SL_VK_DEBUG_LOG( info, pCallbackData->pMessage );
             break;
 
         case VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT:
-            debug_logger.warn( pCallbackData->pMessage );
+            SL_VK_DEBUG_LOG( warning, pCallbackData->pMessage );
             break;
 
         case VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT:
-            debug_logger.error( pCallbackData->pMessage );
+            SL_VK_DEBUG_LOG( error, pCallbackData->pMessage );
             break;
 
         default:
-            debug_logger.info( "Unknown severity - %s", pCallbackData->pMessage );
+            SL_VK_DEBUG_LOG( info, "Unknown severity - %s", pCallbackData->pMessage );
         }
 
         return VK_FALSE;
@@ -192,11 +199,15 @@ namespace
 
 int main()
 {
-    auto logger    = sl::logging::logger {};
-    auto app_start = std::chrono::high_resolution_clock::now();
+    auto logger = sl::logging::logger {};
+
+    sl::trace::start();
+    sl::trace::set_thread_name( "main" );
 
     try
     {
+        auto phase = sl::trace::span { "vk-compute", "app context" };
+
         logger.info( "Initializing loader..." );
 
         auto loader     = sl::vk::core::loader {};
@@ -208,7 +219,7 @@ int main()
         logger.info( "Creating an application context..." );
         auto app_context
             = sl::vk::core::make_app_context( loader, app_config, handle_vulkan_debug );
-        auto time_to_app_context = std::chrono::high_resolution_clock::now();
+        phase.next( "compute context" );
 
         logger.info( "Enumerating GPU devices..." );
         auto gpus = app_context.gpus();
@@ -227,12 +238,12 @@ int main()
         auto mem     = sl::vk::mem::make_allocator( loader, device, app_config.api_version() );
         auto dcache  = sl::vk::core::make_fixed_descriptor_cache( device, dcache_config );
         auto compute = sl::vk::compute::context { device, mem };
-        auto time_to_compute_context = std::chrono::high_resolution_clock::now();
+        phase.next( "load program" );
 
         logger.info( "Loading compute program..." );
         auto program = sl::vk::compute::make_program(
-            device, sl::io::load_file< uint32_t >( k_square_spv_file ) );
-        auto time_to_load_program = std::chrono::high_resolution_clock::now();
+            device, sl::io::load_buffer< uint32_t >( k_square_spv_file ) );
+        phase.next( "create buffers" );
 
         logger.info( "Allocating GPU memory..." );
         auto staging_buf
@@ -241,11 +252,11 @@ int main()
         auto out_buf = sl::vk::mem::make_storage_buffer( mem, k_number_count * sizeof( uint32_t ) );
         auto result_buf
             = sl::vk::mem::make_readback_buffer( mem, k_number_count * sizeof( uint32_t ) );
-        auto time_to_create_buffers = std::chrono::high_resolution_clock::now();
+        phase.next( "initialize test data" );
 
         logger.info( "Preparing random data..." );
-        auto in_data                      = make_input_data( k_number_count );
-        auto time_to_initialize_test_data = std::chrono::high_resolution_clock::now();
+        auto in_data = make_input_data( k_number_count );
+        phase.next( "submit" );
 
         logger.info( "Copying data into GPU buffers..." );
         compute.copy( std::span { in_data }, staging_buf );
@@ -267,57 +278,25 @@ int main()
         compute.copy( out_buf, result_buf );
 
         // Flush commands to GPU and wait for completion
-        auto time_to_submit = std::chrono::high_resolution_clock::now();
+        phase.next( "gpu complete" );
         compute.flush_and_wait();
-        auto time_to_gpu_complete = std::chrono::high_resolution_clock::now();
 
         // Validate results
+        phase.next( "validate" );
         {
             auto view = result_buf.map_view< uint32_t >();
             validate_squares( in_data, view.data() );
         }
-        auto time_to_validate = std::chrono::high_resolution_clock::now();
-
-        std::cout << "*** *** App context: "
-                  << std::chrono::duration_cast< std::chrono::milliseconds >( time_to_app_context
-                                                                              - app_start )
-                         .count()
-                  << "\n";
-        std::cout << "*** *** Compute context: "
-                  << std::chrono::duration_cast< std::chrono::milliseconds >(
-                         time_to_compute_context - time_to_app_context )
-                         .count()
-                  << "\n";
-        std::cout << "*** *** Load program: "
-                  << std::chrono::duration_cast< std::chrono::milliseconds >(
-                         time_to_load_program - time_to_compute_context )
-                         .count()
-                  << "\n";
-        std::cout << "*** *** Create buffers: "
-                  << std::chrono::duration_cast< std::chrono::milliseconds >(
-                         time_to_create_buffers - time_to_load_program )
-                         .count()
-                  << "\n";
-        std::cout << "*** *** Initialize test data: "
-                  << std::chrono::duration_cast< std::chrono::milliseconds >(
-                         time_to_initialize_test_data - time_to_create_buffers )
-                         .count()
-                  << "\n";
-        std::cout << "*** *** Submit: "
-                  << std::chrono::duration_cast< std::chrono::milliseconds >(
-                         time_to_submit - time_to_initialize_test_data )
-                         .count()
-                  << "\n";
-        std::cout << "*** *** GPU complete: "
-                  << std::chrono::duration_cast< std::chrono::milliseconds >( time_to_gpu_complete
-                                                                              - time_to_submit )
-                         .count()
-                  << "\n";
-        std::cout << "*** *** Validated: "
-                  << std::chrono::duration_cast< std::chrono::milliseconds >(
-                         time_to_validate - time_to_gpu_complete )
-                         .count()
-                  << "\n";
+        phase.end();
+
+        sl::trace::for_each_record( [&]( const sl::trace::record& r ) {
+            if ( std::strcmp( r.category, "vk-compute" ) == 0 )
+                logger.info( "*** *** %s: %.1f ms", r.name, r.dur_us / 1000.0 );
+        } );
+
+        const auto trace_file = std::filesystem::temp_directory_path() / "vk-compute.trace.json";
+        if ( sl::trace::write_chrome_json( trace_file ) )
+            logger.info( "Trace written to %s", trace_file.c_str() );
 
         logger.info( "Shutting down..." );
     }
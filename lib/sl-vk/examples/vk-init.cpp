@@ -25,6 +25,7 @@
 #include <array>
 #include <span>
 
+#include <logging/limit.h>
 #include <logging/logger.h>
 #include <utils/version.h>
 
@@ -36,6 +37,11 @@
 #include <vk/mem/buffers.h>
 #include <vk/mem/images.h>
 
+// Validation layers can flood the debug callback, so each report in it is rate limited on its
+// own (see SL_LOG_LIMITED_TO), with the number dropped logged when it gets through again.
+#define SL_VK_DEBUG_LOG( level, ... )                                                              \
+    SL_LOG_LIMITED_TO( debug_logger, sl::logging::log_level::level, 50, 200, __VA_ARGS__ )
+
 namespace
 {
 
@@ -49,30 +55,30 @@ namespace
     {
         if ( type == VK_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT )
         {
-            debug_logger.warn( "*** Performance *** ==> %s", pCallbackData->pMessage );
+            SL_VK_DEBUG_LOG( warning, "*** Performance *** ==> %s", pCallbackData->pMessage );
             return VK_FALSE;
         }
 
         switch ( severity )
         {
         case VK_DEBUG_UTILS_MESSAGE_SEVERITY_VERBOSE_BIT_EXT:
-            // debug_logger.trace( pCallbackData->pMessage );
+            // SL_VK_DEBUG_LOG( trace, pCallbackData->pMessage );
             break;
 
         case VK_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT:
-            debug_logger.info( pCallbackData->pMessage );
+            SL_VK_DEBUG_LOG( info, pCallbackData->pMessage );
             break;
 
         case VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT:
-            debug_logger.warn( pCallbackData->pMessage );
+            SL_VK_DEBUG_LOG( warning, pCallbackData->pMessage );
             break;
 
         case VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT:
-            debug_logger.error( pCallbackData->pMessage );
+            SL_VK_DEBUG_LOG( error, pCallbackData->pMessage );
             break;
 
         default:
-            debug_logger.info( "Unknown severity - %s", pCallbackData->pMessage );
+            SL_VK_DEBUG_LOG( info, "Unknown severity - %s", pCallbackData->pMessage );
         }
 
         return VK_FALSE;
@@ -25,6 +25,7 @@
 #ifndef __CONTEXT_H_EC2721296A87430CAAE6401FAB73FAC3__
 #define __CONTEXT_H_EC2721296A87430CAAE6401FAB73FAC3__
 
+#include <trace/trace.h>
 #include <vk/core/logical-device.h>
 #include <vk/mem/allocator.h>
 
@@ -151,6 +152,8 @@ namespace sl::vk::compute
 
         void flush_and_wait()
         {
+            SL_TRACE_SPAN( "vk", "flush_and_wait" );
+
             _device.end_command_buffer( _buffer );
 
             // Submit all the work and wait for it to complete
@@ -25,6 +25,7 @@
 #ifndef __PROGRAM_H_C74161AFB993442ABDA3F4025844D8CD__
 #define __PROGRAM_H_C74161AFB993442ABDA3F4025844D8CD__
 
+#include <span>
 #include <tuple>
 
 #include <vk/compute/context.h>
@@ -124,7 +125,7 @@ namespace sl::vk::compute
               size_t k_max_descriptor_sets = 4,
               size_t k_max_push_blocks     = 4 >
     auto make_program( const core::logical_device< device_functions_t >& device,
-                       const std::vector< uint32_t >& code )
+                       std::span< const uint32_t > code )
     {
         auto spv_module = sl::vk::spv::make_shader( code );
         vk::error::throw_if( spv_module.stage() != spv::shader_stage::compute,
@@ -169,7 +170,7 @@ namespace sl::vk::compute
         } );
 
         // Attempt to create a VK shader module
-        auto shader = device.create_shader( std::span( code ) );
+        auto shader = device.create_shader( code );
 
         // Build the compute pipeline
         auto layout
@@ -29,6 +29,7 @@
 #include <functional>
 #include <span>
 
+#include <logging/logger.h>
 #include <utils/strings.h>
 
 #include <vk/core/loader.h>
@@ -233,6 +234,19 @@ case core::device_feature::e:
                 } );
         }
 
+        /**
+         * Diagnostics are all trace output; skip gathering them when trace is compiled out
+         * or disabled at runtime (loggers without a level always trace).
+         */
+        template< typename logger_t >
+        bool tracing( const logger_t& logger )
+        {
+            if constexpr ( requires { logger.enabled( sl::logging::log_level::trace ); } )
+                return logger.enabled( sl::logging::log_level::trace );
+            else
+                return true;
+        }
+
     }   // namespace priv
 
 
@@ -244,6 +258,9 @@ case core::device_feature::e:
     template< typename logger_t, typename loader_t >
     void log_diagnostics( logger_t& logger, const core::loader_base< loader_t >& loader )
     {
+        if ( !priv::tracing( logger ) )
+            return;
+
         char scratch[20];
         auto buf = std::span( scratch );
 
@@ -264,6 +281,9 @@ case core::device_feature::e:
     template< typename logger_t, typename configurator_t >
     void log_diagnostics( logger_t& logger, const app_configurator< configurator_t >& cfg )
     {
+        if ( !priv::tracing( logger ) )
+            return;
+
         char scratch[16];
         auto buf = std::span( scratch );
 
@@ -288,6 +308,9 @@ case core::device_feature::e:
     template< typename logger_t, typename configurator_t >
     void log_diagnostics( logger_t& logger, const device_configurator< configurator_t >& cfg )
     {
+        if ( !priv::tracing( logger ) )
+            return;
+
         logger.trace( "Vulkan device configuration:" );
 
         auto exts = cfg.enabled_extensions();
@@ -312,6 +335,9 @@ case core::device_feature::e:
     template< typename logger_t >
     void log_diagnostics( logger_t& logger, const sl::vk::core::physical_device& device )
     {
+        if ( !priv::tracing( logger ) )
+            return;
+
         char scratch[20];
         auto buf = std::span( scratch );
 
@@ -25,6 +25,7 @@
 #ifndef __FIXED_DESCRIPTOR_CACHE_H_D373172D500A49BC9F400CFC4776C671__
 #define __FIXED_DESCRIPTOR_CACHE_H_D373172D500A49BC9F400CFC4776C671__
 
+#include <memory_resource>
 #include <span>
 #include <unordered_map>
 #include <vector>
@@ -46,7 +47,7 @@ namespace sl::vk::core
         };
 
 
-        fixed_descriptor_cache( std::vector< core::descriptor_pool >&& pools )
+        fixed_descriptor_cache( std::pmr::vector< core::descriptor_pool >&& pools )
             : _pools { std::move( pools ) }
             , _index { 0 }
         {}
@@ -81,14 +82,16 @@ namespace sl::vk::core
         }
 
     private:
-        std::vector< core::descriptor_pool > _pools;
+        std::pmr::vector< core::descriptor_pool > _pools;
         size_t _index;
     };
 
 
     template< typename device_functions_t >
     auto make_fixed_descriptor_cache( const core::logical_device< device_functions_t >& device,
-                                      const fixed_descriptor_cache::config& config )
+                                      const fixed_descriptor_cache::config& config,
+                                      std::pmr::memory_resource* resource
+                                      = std::pmr::get_default_resource() )
     {
         // Prep the pool size structures
         auto count      = uint32_t { 0 };
@@ -106,7 +109,7 @@ namespace sl::vk::core
         auto max_sets = config.max_sets > 0 ? config.max_sets : count;
 
         // Create the fixed set of descriptor pools
-        auto pools = std::vector< core::descriptor_pool >( config.pool_count );
+        auto pools = std::pmr::vector< core::descriptor_pool >( config.pool_count, resource );
         for ( uint32_t i = 0; i < config.pool_count; ++i )
             pools[i] = device.create_descriptor_pool( pool_sizes, max_sets );
 
@@ -0,0 +1,101 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023-present Robert Anderson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef __TEMP_H_6B0E3F5C2A9D4E1B8C7A4F2D19E05B37__
+#define __TEMP_H_6B0E3F5C2A9D4E1B8C7A4F2D19E05B37__
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+namespace sl::test
+{
+
+    /**
+     * Returns a path under the system temp directory that no other test (or concurrent run
+     * of the same test binary) will pick: '<prefix>-<random>-<sequence><suffix>'. Nothing
+     * is created on disk.
+     **/
+    static std::filesystem::path unique_temp_path( std::string_view prefix,
+                                                   std::string_view suffix = {} )
+    {
+        static const uint64_t s_run = std::random_device {}() * 0x100000001ull
+                                      ^ std::random_device {}();
+        static std::atomic< uint32_t > s_sequence { 0 };
+
+        char tag[40];
+        std::snprintf( tag,
+                       sizeof( tag ),
+                       "-%016llx-%u",
+                       static_cast< unsigned long long >( s_run ),
+                       s_sequence.fetch_add( 1, std::memory_order_relaxed ) );
+
+        auto name = std::string { prefix };
+        name += tag;
+        name += suffix;
+        return std::filesystem::temp_directory_path() / name;
+    }
+
+    /**
+     * Owns a unique temp file path (see unique_temp_path). The file itself is left to the
+     * test to create; whatever exists at 'path' is removed on destruction.
+     **/
+    struct temp_file
+    {
+        explicit temp_file( std::string_view prefix, std::string_view suffix = {} )
+            : path { unique_temp_path( prefix, suffix ) }
+        {}
+
+        temp_file( const temp_file& )            = delete;
+        temp_file& operator=( const temp_file& ) = delete;
+
+        ~temp_file()
+        {
+            std::error_code ec;
+            std::filesystem::remove_all( path, ec );
+        }
+
+        std::filesystem::path path;
+    };
+
+    /**
+     * Creates a unique, empty temp directory and removes it (recursively) on destruction.
+     **/
+    struct temp_dir : temp_file
+    {
+        explicit temp_dir( std::string_view prefix )
+            : temp_file { prefix }
+        {
+            std::filesystem::create_directories( path );
+        }
+    };
+
+}   // namespace sl::test
+
+#endif /* __TEMP_H_6B0E3F5C2A9D4E1B8C7A4F2D19E05B37__ */